@@ -195,7 +195,7 @@ public final class BufferUtils {
 	 * @return the cache-line-aligned ByteBuffer
 	 */
 	public static ByteBuffer createAlignedByteBufferCacheLine(int capacity) {
-		return createAlignedByteBuffer(capacity, 64); // TODO: Discover cache line size at runtime
+		return createAlignedByteBuffer(capacity, CACHE_LINE_SIZE);
 	}
 
 	// memsets
@@ -374,7 +374,8 @@ public final class LWJGLUtil {
 		}
 	}
 
-	private static String getPrivilegedProperty(final String property_name) {
+	/** Gets a system property as a privileged action. */
+	public static String getPrivilegedProperty(final String property_name) {
 		return AccessController.doPrivileged(new PrivilegedAction<String>() {
 			@Override
 			public String run() {
@@ -4,10 +4,10 @@
  */
 package org.lwjgl.openal;
 
-import org.lwjgl.BufferUtils;
 import org.lwjgl.LWJGLUtil;
 import org.lwjgl.system.FunctionMap;
 import org.lwjgl.system.FunctionProvider;
+import org.lwjgl.system.MemoryStack;
 
 import java.nio.ByteBuffer;
 import java.nio.IntBuffer;
@@ -18,6 +18,7 @@ import java.util.StringTokenizer;
 import static org.lwjgl.openal.AL10.*;
 import static org.lwjgl.openal.ALC10.*;
 import static org.lwjgl.system.Checks.*;
+import static org.lwjgl.system.MemoryStack.*;
 import static org.lwjgl.system.MemoryUtil.*;
 
 public final class AL {
@@ -31,12 +32,17 @@ public final class AL {
 
 		@Override
 		public long getFunctionAddress(String functionName) {
-			ByteBuffer nameBuffer = memEncodeASCII(functionName);
-			long address = nalGetProcAddress(memAddress(nameBuffer), alGetProcAddress);
-			if ( address == NULL )
-				LWJGLUtil.log("Failed to locate address for AL function " + functionName);
-
-			return address;
+			MemoryStack stack = stackPush();
+			try {
+				ByteBuffer nameBuffer = stack.ASCII(functionName);
+				long address = nalGetProcAddress(memAddress(nameBuffer), alGetProcAddress);
+				if ( address == NULL )
+					LWJGLUtil.log("Failed to locate address for AL function " + functionName);
+
+				return address;
+			} finally {
+				stack.pop();
+			}
 		}
 
 		@Override
@@ -95,7 +101,7 @@ public final class AL {
 			throw new IllegalStateException("Core OpenAL functions could not be found. Make sure that OpenAL has been loaded.");
 
 		// Parse EXTENSIONS string
-		String extensionsString = memDecodeUTF8(memByteBufferNT1(checkPointer(nalGetString(AL_EXTENSIONS, GetString))));
+		String extensionsString = memDecodeUTF8(checkPointer(nalGetString(AL_EXTENSIONS, GetString)));
 
 		/*
 		OpenALSoft: AL_EXT_ALAW AL_EXT_DOUBLE AL_EXT_EXPONENT_DISTANCE AL_EXT_FLOAT32 AL_EXT_IMA4 AL_EXT_LINEAR_DISTANCE AL_EXT_MCFORMATS AL_EXT_MULAW AL_EXT_MULAW_MCFORMATS AL_EXT_OFFSET AL_EXT_source_distance_model AL_LOKI_quadriphonic AL_SOFT_buffer_samples AL_SOFT_buffer_sub_data AL_SOFTX_deferred_updates AL_SOFT_direct_channels AL_SOFT_loop_points
@@ -105,9 +111,14 @@ public final class AL {
 		StringTokenizer tokenizer = new StringTokenizer(extensionsString);
 		while ( tokenizer.hasMoreTokens() ) {
 			String extName = tokenizer.nextToken();
-			ByteBuffer nameBuffer = memEncodeASCII(extName);
-			if ( nalIsExtensionPresent(memAddress(nameBuffer), IsExtensionPresent) )
-				supportedExtensions.add(extName);
+			MemoryStack stack = stackPush();
+			try {
+				ByteBuffer nameBuffer = stack.ASCII(extName);
+				if ( nalIsExtensionPresent(memAddress(nameBuffer), IsExtensionPresent) )
+					supportedExtensions.add(extName);
+			} finally {
+				stack.pop();
+			}
 		}
 
 		return new ALCapabilities(supportedExtensions);
@@ -134,22 +145,28 @@ public final class AL {
 
 	public static ALContext create(String deviceArguments, int contextFrequency, int contextRefresh, boolean contextSynchronized) {
 		ALCContext deviceContext = ALC.createALCContextFromDevice(deviceArguments);
-		IntBuffer attribs = BufferUtils.createIntBuffer(16);
 
-		attribs.put(ALC_FREQUENCY);
-		attribs.put(contextFrequency);
+		MemoryStack stack = stackPush();
+		try {
+			IntBuffer attribs = stack.mallocInt(16);
 
-		attribs.put(ALC_REFRESH);
-		attribs.put(contextRefresh);
+			attribs.put(ALC_FREQUENCY);
+			attribs.put(contextFrequency);
 
-		attribs.put(ALC_SYNC);
-		attribs.put(contextSynchronized ? ALC10.ALC_TRUE : ALC10.ALC_FALSE);
+			attribs.put(ALC_REFRESH);
+			attribs.put(contextRefresh);
 
-		attribs.put(0);
-		attribs.flip();
+			attribs.put(ALC_SYNC);
+			attribs.put(contextSynchronized ? ALC10.ALC_TRUE : ALC10.ALC_FALSE);
 
-		long contextHandle = alcCreateContext(deviceContext.getDevice(), attribs);
-		return new ALContext(deviceContext, contextHandle);
+			attribs.put(0);
+			attribs.flip();
+
+			long contextHandle = alcCreateContext(deviceContext.getDevice(), attribs);
+			return new ALContext(deviceContext, contextHandle);
+		} finally {
+			stack.pop();
+		}
 	}
 
 }
\ No newline at end of file
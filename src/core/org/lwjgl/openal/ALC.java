@@ -6,9 +6,12 @@ package org.lwjgl.openal;
 
 import org.lwjgl.LWJGLUtil;
 import org.lwjgl.system.APIBuffer;
+import org.lwjgl.system.AbstractFunctionProviderLocal;
 import org.lwjgl.system.DynamicLinkLibrary;
 import org.lwjgl.system.FunctionMap;
 import org.lwjgl.system.FunctionProviderLocal;
+import org.lwjgl.system.MemoryStack;
+import org.lwjgl.system.PersistentCache;
 
 import java.nio.ByteBuffer;
 import java.util.*;
@@ -17,6 +20,7 @@ import static org.lwjgl.Pointer.*;
 import static org.lwjgl.openal.ALC10.*;
 import static org.lwjgl.system.APIUtil.*;
 import static org.lwjgl.system.Checks.*;
+import static org.lwjgl.system.MemoryStack.*;
 import static org.lwjgl.system.MemoryUtil.*;
 
 public final class ALC {
@@ -43,7 +47,7 @@ public final class ALC {
 				throw new IllegalStateException();
 		}
 
-		functionProvider = new FunctionProviderLocal() {
+		functionProvider = new AbstractFunctionProviderLocal() {
 
 			private final DynamicLinkLibrary OPENAL;
 			private final long alcGetProcAddress;
@@ -82,13 +86,24 @@ public final class ALC {
 			}
 
 			@Override
-			public long getFunctionAddress(long handle, String functionName) {
-				ByteBuffer nameBuffer = memEncodeASCII(functionName);
-				long address = nalcGetProcAddress(handle, memAddress(nameBuffer), alcGetProcAddress);
-				if ( address == NULL )
-					LWJGLUtil.log("Failed to locate address for ALC extension function " + functionName);
+			public void getFunctionAddresses(ByteBuffer names, long[] addresses) {
+				apiGetFunctionAddresses(OPENAL, names, addresses);
+				apiLogMissingFunctions("ALC", names, addresses);
+			}
 
-				return address;
+			@Override
+			public long getFunctionAddress(long handle, String functionName) {
+				MemoryStack stack = stackPush();
+				try {
+					ByteBuffer nameBuffer = stack.ASCII(functionName);
+					long address = nalcGetProcAddress(handle, memAddress(nameBuffer), alcGetProcAddress);
+					if ( address == NULL )
+						LWJGLUtil.log("Failed to locate address for ALC extension function " + functionName);
+
+					return address;
+				} finally {
+					stack.pop();
+				}
 			}
 
 			@Override
@@ -119,8 +134,15 @@ public final class ALC {
 		if ( LWJGLUtil.CHECKS )
 			checkFunctionAddress(alcOpenDevice);
 
-		ByteBuffer nameBuffer = deviceName == null ? null : memEncodeUTF8(deviceName);
-		long device = nalcOpenDevice(memAddressSafe(nameBuffer), alcOpenDevice);
+		long device;
+
+		MemoryStack stack = stackPush();
+		try {
+			ByteBuffer nameBuffer = deviceName == null ? null : stack.UTF8(deviceName);
+			device = nalcOpenDevice(memAddressSafe(nameBuffer), alcOpenDevice);
+		} finally {
+			stack.pop();
+		}
 		if ( device == NULL )
 			throw new RuntimeException("Failed to open the device.");
 
@@ -153,28 +175,16 @@ public final class ALC {
 		if ( __result == NULL )
 			return null;
 
-		ByteBuffer buffer = memByteBuffer(__result, Integer.MAX_VALUE);
-
 		List<String> strings = new ArrayList<String>();
 
-		int offset = 0;
+		long address = __result;
 		while ( true ) {
-			if ( buffer.get() == 0 ) {
-				int limit = buffer.position() - 1;
-				if ( limit == offset ) // Previous char was also a \0 == end of list.
-					break;
-
-				// Prepare for decoding
-				buffer.position(offset); // Start index
-				buffer.limit(limit); // \0 index
-
-				// Decode
-				strings.add(memDecodeUTF8(buffer));
+			int length = memStrLen1(address);
+			if ( length == 0 ) // An empty string terminates the list
+				break;
 
-				// Reset
-				buffer.limit(Integer.MAX_VALUE);
-				buffer.position(offset = limit + 1); // index after \0
-			}
+			strings.add(memDecodeUTF8(address, length));
+			address += length + 1; // skip the \0
 		}
 
 		return strings;
@@ -203,6 +213,29 @@ public final class ALC {
 		int majorVersion = __buffer.intValue(0);
 		int minorVersion = __buffer.intValue(4);
 
+		PersistentCache persistentCache = PersistentCache.ENABLED
+			? PersistentCache.open("alc", memDecodeUTF8(nalcGetString(device, ALC_DEVICE_SPECIFIER, GetString)) + '\n' + majorVersion + '.' + minorVersion)
+			: null;
+
+		Set<String> supportedExtensions = persistentCache == null ? null : persistentCache.getExtensions();
+		if ( supportedExtensions == null ) {
+			supportedExtensions = getSupportedExtensions(device, majorVersion, minorVersion, GetString, IsExtensionPresent);
+			if ( persistentCache != null )
+				persistentCache.setExtensions(supportedExtensions);
+		}
+
+		ALCCapabilities caps = new ALCCapabilities(
+			persistentCache == null ? functionProvider : persistentCache.wrap(functionProvider),
+			device, supportedExtensions
+		);
+
+		if ( persistentCache != null )
+			persistentCache.store();
+
+		return caps;
+	}
+
+	private static Set<String> getSupportedExtensions(long device, int majorVersion, int minorVersion, long GetString, long IsExtensionPresent) {
 		int[][] ALC_VERSIONS = {
 			{ 0, 1 },  // ALC 1
 		};
@@ -218,7 +251,7 @@ public final class ALC {
 		}
 
 		// Parse EXTENSIONS string
-		String extensionsString = memDecodeUTF8(memByteBufferNT1(checkPointer(nalcGetString(device, ALC_EXTENSIONS, GetString))));
+		String extensionsString = memDecodeUTF8(checkPointer(nalcGetString(device, ALC_EXTENSIONS, GetString)));
 
 		/*
 		OpenALSoft: ALC_ENUMERATE_ALL_EXT ALC_ENUMERATION_EXT ALC_EXT_CAPTURE ALC_EXT_DEDICATED ALC_EXT_disconnect ALC_EXT_EFX ALC_EXT_thread_local_context ALC_SOFT_loopback
@@ -228,12 +261,17 @@ public final class ALC {
 		StringTokenizer tokenizer = new StringTokenizer(extensionsString);
 		while ( tokenizer.hasMoreTokens() ) {
 			String extName = tokenizer.nextToken();
-			ByteBuffer nameBuffer = memEncodeASCII(extName);
-			if ( nalcIsExtensionPresent(device, memAddress(nameBuffer), IsExtensionPresent) )
-				supportedExtensions.add(extName);
+			MemoryStack stack = stackPush();
+			try {
+				ByteBuffer nameBuffer = stack.ASCII(extName);
+				if ( nalcIsExtensionPresent(device, memAddress(nameBuffer), IsExtensionPresent) )
+					supportedExtensions.add(extName);
+			} finally {
+				stack.pop();
+			}
 		}
 
-		return new ALCCapabilities(device, supportedExtensions);
+		return supportedExtensions;
 	}
 
 	static <T extends FunctionMap> T checkExtension(String extension, T functions, boolean supported) {
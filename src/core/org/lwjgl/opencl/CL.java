@@ -6,9 +6,12 @@ package org.lwjgl.opencl;
 
 import org.lwjgl.LWJGLUtil;
 import org.lwjgl.system.APIBuffer;
+import org.lwjgl.system.AbstractFunctionProviderLocal;
 import org.lwjgl.system.DynamicLinkLibrary;
 import org.lwjgl.system.FunctionMap;
 import org.lwjgl.system.FunctionProviderLocal;
+import org.lwjgl.system.MemoryStack;
+import org.lwjgl.system.PersistentCache;
 
 import java.nio.ByteBuffer;
 import java.util.HashSet;
@@ -20,6 +23,7 @@ import static org.lwjgl.Pointer.*;
 import static org.lwjgl.opencl.CL10.*;
 import static org.lwjgl.opencl.CL12.*;
 import static org.lwjgl.system.APIUtil.*;
+import static org.lwjgl.system.MemoryStack.*;
 import static org.lwjgl.system.MemoryUtil.*;
 
 /*
@@ -70,7 +74,7 @@ public final class CL {
 		} else
 			libName = libNameOverride;
 
-		functionProvider = new FunctionProviderLocal() {
+		functionProvider = new AbstractFunctionProviderLocal() {
 
 			private final DynamicLinkLibrary OPENCL = apiCreateLibrary(libName);
 
@@ -99,17 +103,28 @@ public final class CL {
 			}
 
 			@Override
-			public long getFunctionAddress(long handle, String functionName) {
-				ByteBuffer nameBuffer = memEncodeASCII(functionName);
-				long address =
-					clGetExtensionFunctionAddressForPlatform != NULL ?
-					nclGetExtensionFunctionAddressForPlatform(handle, memAddress(nameBuffer), clGetExtensionFunctionAddressForPlatform) :
-					nclGetExtensionFunctionAddress(memAddress(nameBuffer), clGetExtensionFunctionAddress);
-
-				if ( address == NULL )
-					LWJGLUtil.log("Failed to locate address for CL extension function " + functionName);
+			public void getFunctionAddresses(ByteBuffer names, long[] addresses) {
+				apiGetFunctionAddresses(OPENCL, names, addresses);
+				apiLogMissingFunctions("CL platform", names, addresses);
+			}
 
-				return address;
+			@Override
+			public long getFunctionAddress(long handle, String functionName) {
+				MemoryStack stack = stackPush();
+				try {
+					ByteBuffer nameBuffer = stack.ASCII(functionName);
+					long address =
+						clGetExtensionFunctionAddressForPlatform != NULL ?
+						nclGetExtensionFunctionAddressForPlatform(handle, memAddress(nameBuffer), clGetExtensionFunctionAddressForPlatform) :
+						nclGetExtensionFunctionAddress(memAddress(nameBuffer), clGetExtensionFunctionAddress);
+
+					if ( address == NULL )
+						LWJGLUtil.log("Failed to locate address for CL extension function " + functionName);
+
+					return address;
+				} finally {
+					stack.pop();
+				}
 			}
 
 			@Override
@@ -146,11 +161,7 @@ public final class CL {
 		if ( LWJGLUtil.DEBUG && (clGetPlatformInfo == NULL || clGetDeviceIDs == NULL || clGetDeviceInfo == NULL) )
 			throw new OpenCLException("A core OpenCL function is missing. Make sure that OpenCL is available.");
 
-		Set<String> supportedExtensions = new HashSet<String>(32);
-
-		// Parse PLATFORM_EXTENSIONS string
-		String extensionsString = getPlatformInfo(platform, CL_PLATFORM_EXTENSIONS, clGetPlatformInfo);
-		addExtensions(extensionsString, supportedExtensions);
+		long[] devices;
 
 		// Enumerate devices
 		{
@@ -169,15 +180,9 @@ public final class CL {
 			if ( LWJGLUtil.DEBUG && errcode != CL_SUCCESS )
 				throw new OpenCLException("Failed to query OpenCL platform devices.");
 
-			long[] devices = new long[num_devices];
+			devices = new long[num_devices];
 			for ( int i = 0; i < num_devices; i++ )
 				devices[i] = __buffer.pointerValue(i << POINTER_SHIFT);
-
-			// Add device extensions to the set
-			for ( int i = 0; i < num_devices; i++ ) {
-				extensionsString = getDeviceInfo(devices[i], CL_DEVICE_EXTENSIONS, clGetDeviceInfo);
-				addExtensions(extensionsString, supportedExtensions);
-			}
 		}
 
 		// Parse PLATFORM_VERSION string
@@ -192,9 +197,55 @@ public final class CL {
 		} catch (Exception e) {
 			throw new OpenCLException("The platform major and/or minor OpenCL version \"" + version + "\" is malformed: " + e.getMessage());
 		}
-		addCLVersions(majorVersion, minorVersion, supportedExtensions);
 
-		return new CLCapabilities(platform, majorVersion, minorVersion, supportedExtensions);
+		PersistentCache persistentCache = PersistentCache.ENABLED
+			? PersistentCache.open("cl", getDriverSignature(platform, version, devices, clGetPlatformInfo, clGetDeviceInfo))
+			: null;
+
+		Set<String> supportedExtensions = persistentCache == null ? null : persistentCache.getExtensions();
+		if ( supportedExtensions == null ) {
+			supportedExtensions = new HashSet<String>(32);
+
+			// Parse PLATFORM_EXTENSIONS string
+			String extensionsString = getPlatformInfo(platform, CL_PLATFORM_EXTENSIONS, clGetPlatformInfo);
+			addExtensions(extensionsString, supportedExtensions);
+
+			// Add device extensions to the set
+			for ( long device : devices ) {
+				extensionsString = getDeviceInfo(device, CL_DEVICE_EXTENSIONS, clGetDeviceInfo);
+				addExtensions(extensionsString, supportedExtensions);
+			}
+
+			addCLVersions(majorVersion, minorVersion, supportedExtensions);
+
+			if ( persistentCache != null )
+				persistentCache.setExtensions(supportedExtensions);
+		}
+
+		CLCapabilities caps = new CLCapabilities(
+			persistentCache == null ? functionProvider : persistentCache.wrap(functionProvider),
+			platform, majorVersion, minorVersion, supportedExtensions
+		);
+
+		if ( persistentCache != null )
+			persistentCache.store();
+
+		return caps;
+	}
+
+	private static String getDriverSignature(long platform, String version, long[] devices, long clGetPlatformInfo, long clGetDeviceInfo) {
+		StringBuilder signature = new StringBuilder(256);
+
+		signature.append(getPlatformInfo(platform, CL_PLATFORM_VENDOR, clGetPlatformInfo)).append('\n');
+		signature.append(getPlatformInfo(platform, CL_PLATFORM_NAME, clGetPlatformInfo)).append('\n');
+		signature.append(version);
+
+		for ( long device : devices ) {
+			signature.append('\n').append(getDeviceInfo(device, CL_DEVICE_NAME, clGetDeviceInfo));
+			signature.append(' ').append(getDeviceInfo(device, CL_DRIVER_VERSION, clGetDeviceInfo));
+		}
+
+		return signature.toString();
 	}
 
 	static void addExtensions(String extensionsString, Set<String> supportedExtensions) {
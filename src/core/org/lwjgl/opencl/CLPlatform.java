@@ -6,7 +6,7 @@ package org.lwjgl.opencl;
 
 import org.lwjgl.system.APIBuffer;
 import org.lwjgl.system.APIUtil;
-import org.lwjgl.system.FastLongMap;
+import org.lwjgl.system.ConcurrentLongMap;
 import org.lwjgl.system.FunctionProvider;
 
 import java.util.ArrayList;
@@ -20,7 +20,7 @@ import static org.lwjgl.system.MemoryUtil.*;
 /** This class is a wrapper around a cl_platform_id pointer. */
 public class CLPlatform extends CLObject {
 
-	private static final FastLongMap<CLPlatform> platforms = new FastLongMap<CLPlatform>();
+	private static final ConcurrentLongMap<CLPlatform> platforms = new ConcurrentLongMap<CLPlatform>();
 
 	private CLCapabilities capabilities;
 
@@ -6,12 +6,18 @@ package org.lwjgl.opengl;
 
 import org.lwjgl.LWJGLUtil;
 import org.lwjgl.system.APIBuffer;
+import org.lwjgl.system.AbstractFunctionProvider;
 import org.lwjgl.system.DynamicLinkLibrary;
 import org.lwjgl.system.FunctionMap;
 import org.lwjgl.system.FunctionProvider;
+import org.lwjgl.system.MemoryStack;
+import org.lwjgl.system.PersistentCache;
+import org.lwjgl.system.linux.LinuxLibrary;
 
 import java.nio.ByteBuffer;
+import java.util.HashMap;
 import java.util.HashSet;
+import java.util.Map;
 import java.util.Set;
 import java.util.StringTokenizer;
 
@@ -26,6 +32,7 @@ import static org.lwjgl.opengl.WGLARBExtensionsString.*;
 import static org.lwjgl.opengl.WGLEXTExtensionsString.*;
 import static org.lwjgl.system.APIUtil.*;
 import static org.lwjgl.system.Checks.*;
+import static org.lwjgl.system.MemoryStack.*;
 import static org.lwjgl.system.MemoryUtil.*;
 import static org.lwjgl.system.linux.GLX.*;
 import static org.lwjgl.system.windows.WGL.*;
@@ -57,15 +64,20 @@ public final class GL {
 				functionProvider = new FunctionProvider() {
 					@Override
 					public long getFunctionAddress(String functionName) {
-						ByteBuffer nameBuffer = memEncodeASCII(functionName);
-						long address = wglGetProcAddress(nameBuffer);
-						if ( address == NULL ) {
-							address = OPENGL.getFunctionAddress(nameBuffer);
-							if ( address == NULL )
-								LWJGLUtil.log("Failed to locate address for GL function " + functionName);
+						MemoryStack stack = stackPush();
+						try {
+							ByteBuffer nameBuffer = stack.ASCII(functionName);
+							long address = wglGetProcAddress(nameBuffer);
+							if ( address == NULL ) {
+								address = OPENGL.getFunctionAddress(nameBuffer);
+								if ( address == NULL )
+									LWJGLUtil.log("Failed to locate address for GL function " + functionName);
+							}
+
+							return address;
+						} finally {
+							stack.pop();
 						}
-
-						return address;
 					}
 
 					@Override
@@ -75,7 +87,7 @@ public final class GL {
 				};
 				break;
 			case LINUX:
-				functionProvider = new FunctionProvider() {
+				functionProvider = new AbstractFunctionProvider() {
 
 					final long glXGetProcAddress = OPENGL.getFunctionAddress("glXGetProcAddress");
 					final long glXGetProcAddressARB = OPENGL.getFunctionAddress("glXGetProcAddressARB");
@@ -92,15 +104,30 @@ public final class GL {
 
 					@Override
 					public long getFunctionAddress(String functionName) {
-						ByteBuffer nameBuffer = memEncodeASCII(functionName);
-						long address = getGLXFunctionAddress(nameBuffer);
-						if ( address == NULL ) {
-							address = OPENGL.getFunctionAddress(nameBuffer);
-							if ( address == NULL )
-								LWJGLUtil.log("Failed to locate address for GL function " + functionName);
+						MemoryStack stack = stackPush();
+						try {
+							ByteBuffer nameBuffer = stack.ASCII(functionName);
+							long address = getGLXFunctionAddress(nameBuffer);
+							if ( address == NULL ) {
+								address = OPENGL.getFunctionAddress(nameBuffer);
+								if ( address == NULL )
+									LWJGLUtil.log("Failed to locate address for GL function " + functionName);
+							}
+
+							return address;
+						} finally {
+							stack.pop();
 						}
+					}
 
-						return address;
+					@Override
+					public void getFunctionAddresses(ByteBuffer names, long[] addresses) {
+						// glXGetProcAddress and dlsym, in a single native call
+						apiGetFunctionAddresses(
+							(LinuxLibrary)OPENGL, names, addresses,
+							glXGetProcAddress != NULL ? glXGetProcAddress : glXGetProcAddressARB
+						);
+						apiLogMissingFunctions("GL", names, addresses);
 					}
 
 					@Override
@@ -113,12 +140,17 @@ public final class GL {
 				functionProvider = new FunctionProvider() {
 					@Override
 					public long getFunctionAddress(String functionName) {
-						ByteBuffer nameBuffer = memEncodeASCII(functionName);
-						long address = OPENGL.getFunctionAddress(nameBuffer);
-						if ( address == NULL )
-							LWJGLUtil.log("Failed to locate address for GL function " + functionName);
+						MemoryStack stack = stackPush();
+						try {
+							ByteBuffer nameBuffer = stack.ASCII(functionName);
+							long address = OPENGL.getFunctionAddress(nameBuffer);
+							if ( address == NULL )
+								LWJGLUtil.log("Failed to locate address for GL function " + functionName);
 
-						return address;
+							return address;
+						} finally {
+							stack.pop();
+						}
 					}
 
 					@Override
@@ -133,8 +165,33 @@ public final class GL {
 
 	}
 
+	/**
+	 * When enabled, {@link #createCapabilities(boolean)} only parses the extension strings and the function addresses of each OpenGL version or
+	 * extension are resolved the first time one of its functions is called. The capability flags are then set from the extension strings alone, without
+	 * verifying that the entry points are actually exported.
+	 */
+	private static final boolean LAZY_FUNCTIONS = LWJGLUtil.getPrivilegedBoolean("org.lwjgl.opengl.LazyFunctions");
+
+	/**
+	 * When enabled, {@link #createCapabilities} reuses the capabilities of a previous context with the same driver signature (vendor, renderer, version,
+	 * context flags, profile and the requested options), instead of parsing the extension strings and resolving the function addresses again. It is
+	 * disabled on Windows, where the addresses returned by {@code wglGetProcAddress} may differ between contexts, and can be disabled on other platforms
+	 * with the {@code org.lwjgl.opengl.NoCapabilitiesCache} property.
+	 */
+	private static final boolean CAPABILITIES_CACHE =
+		LWJGLUtil.getPlatform() != LWJGLUtil.Platform.WINDOWS && !LWJGLUtil.getPrivilegedBoolean("org.lwjgl.opengl.NoCapabilitiesCache");
+
+	// Maps driver signatures to capabilities instances that are never made current, only copied.
+	private static final Map<String, ContextCapabilities> capabilitiesCache = new HashMap<String, ContextCapabilities>();
+
 	private static final ThreadLocal<GLContext> contextTL = new ThreadLocal<GLContext>();
 
+	/*
+	 * The context that was last made current and the thread it was made current in. Lets the common case of a single rendering thread skip the ThreadLocal
+	 * lookup on every GL call, at the cost of a volatile read and a Thread.currentThread() check.
+	 */
+	private static volatile CurrentContext currentContext = new CurrentContext(null, null);
+
 	private GL() {}
 
 	public static FunctionProvider getFunctionProvider() {
@@ -144,16 +201,21 @@ public final class GL {
 	/** Sets the current {@link GLContext} in the current thread. */
 	public static void setCurrent(GLContext context) {
 		contextTL.set(context);
+		currentContext = new CurrentContext(Thread.currentThread(), context);
 	}
 
 	/** Returns the current {@link GLContext} in the current thread. */
 	public static GLContext getCurrent() {
+		CurrentContext current = currentContext;
+		if ( current.thread == Thread.currentThread() )
+			return current.context;
+
 		return contextTL.get();
 	}
 
 	/** Returns the {@link ContextCapabilities} of the {@link GLContext} that is current in the current thread. */
 	public static ContextCapabilities getCapabilities() {
-		GLContext currentContext = contextTL.get();
+		GLContext currentContext = getCurrent();
 		if ( currentContext == null )
 			throw new IllegalStateException("There is no OpenGL context current in the current thread.");
 
@@ -173,6 +235,22 @@ public final class GL {
 	 * @return the ContextCapabilities instance
 	 */
 	public static ContextCapabilities createCapabilities(boolean forwardCompatible) {
+		return createCapabilities(forwardCompatible, LAZY_FUNCTIONS);
+	}
+
+	/**
+	 * Creates a new ContextCapabilities instance for the current OpenGL context.
+	 * <p/>
+	 * If {@code lazyFunctions} is true, only the extension strings are parsed. The function addresses of each OpenGL version or extension are resolved the
+	 * first time one of its functions is called, which must happen while the same context is current. Missing entry points are then reported by the
+	 * function address checks, instead of clearing the corresponding capability flag.
+	 *
+	 * @param forwardCompatible if true, LWJGL will create forward compatible capabilities
+	 * @param lazyFunctions     if true, function addresses will be resolved on first use
+	 *
+	 * @return the ContextCapabilities instance
+	 */
+	public static ContextCapabilities createCapabilities(boolean forwardCompatible, boolean lazyFunctions) {
 		// We don't have a current ContextCapabilities when this method is called
 		// so we have to use the native bindings directly.
 		long GetError = functionProvider.getFunctionAddress("glGetError");
@@ -205,7 +283,7 @@ public final class GL {
 			minorVersion = __buffer.intValue(0);
 		} else {
 			// Fallback to the string query.
-			String version = memDecodeUTF8(memByteBufferNT1(checkPointer(nglGetString(GL_VERSION, GetString))));
+			String version = memDecodeUTF8(checkPointer(nglGetString(GL_VERSION, GetString)));
 
 			try {
 				StringTokenizer versionTokenizer = new StringTokenizer(version, ". ");
@@ -217,6 +295,69 @@ public final class GL {
 			}
 		}
 
+		String signature = null;
+		if ( CAPABILITIES_CACHE || PersistentCache.ENABLED )
+			signature = getDriverSignature(GetString, GetIntegerv, majorVersion, minorVersion, forwardCompatible, lazyFunctions);
+
+		if ( CAPABILITIES_CACHE ) {
+			ContextCapabilities caps;
+			synchronized ( capabilitiesCache ) {
+				caps = capabilitiesCache.get(signature);
+			}
+			if ( caps != null )
+				return new ContextCapabilities(caps);
+		}
+
+		PersistentCache persistentCache = signature == null ? null : PersistentCache.open("gl", signature);
+
+		Set<String> supportedExtensions = persistentCache == null ? null : persistentCache.getExtensions();
+		if ( supportedExtensions == null ) {
+			supportedExtensions = getSupportedExtensions(GetString, GetIntegerv, majorVersion, minorVersion);
+			if ( persistentCache != null )
+				persistentCache.setExtensions(supportedExtensions);
+		}
+
+		if ( 3 <= majorVersion ) {
+			// In real drivers, we may encounter the following weird scenarios:
+			// - 3.1 context without GL_ARB_compatibility but with deprecated functionality exposed and working.
+			// - Core or forward-compatible context with GL_ARB_compatibility exposed, but not working when used.
+			// We ignore these and go by the spec.
+
+			// Force forwardCompatible to true if the context is a forward-compatible context.
+			nglGetIntegerv(GL_CONTEXT_FLAGS, __buffer.address(), GetIntegerv);
+			if ( (__buffer.intValue(0) & GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT) != 0 )
+				forwardCompatible = true;
+			else {
+				// Force forwardCompatible to true if the context is a core profile context.
+				if ( (3 < majorVersion || 1 <= minorVersion) ) { // OpenGL 3.1+
+					if ( 3 < majorVersion || 2 <= minorVersion ) { // OpenGL 3.2+
+						nglGetIntegerv(GL_CONTEXT_PROFILE_MASK, __buffer.address(), GetIntegerv);
+						if ( (__buffer.intValue(0) & GL_CONTEXT_CORE_PROFILE_BIT) != 0 )
+							forwardCompatible = true;
+					} else
+						forwardCompatible = !supportedExtensions.contains("GL_ARB_compatibility");
+				}
+			}
+		}
+
+		ContextCapabilities caps = new ContextCapabilities(
+			persistentCache == null ? functionProvider : persistentCache.wrap(functionProvider),
+			supportedExtensions, forwardCompatible, lazyFunctions
+		);
+
+		if ( persistentCache != null )
+			persistentCache.store();
+
+		if ( !CAPABILITIES_CACHE )
+			return caps;
+
+		synchronized ( capabilitiesCache ) {
+			capabilitiesCache.put(signature, caps);
+		}
+		return new ContextCapabilities(caps);
+	}
+
+	private static Set<String> getSupportedExtensions(long GetString, long GetIntegerv, int majorVersion, int minorVersion) {
 		int[][] GL_VERSIONS = {
 			{ 1, 2, 3, 4, 5 },  // OpenGL 1
 			{ 0, 1 },           // OpenGL 2
@@ -236,41 +377,21 @@ public final class GL {
 
 		if ( majorVersion < 3 ) {
 			// Parse EXTENSIONS string
-			String extensionsString = memDecodeASCII(memByteBufferNT1(checkPointer(nglGetString(GL_EXTENSIONS, GetString))));
+			String extensionsString = memDecodeASCII(checkPointer(nglGetString(GL_EXTENSIONS, GetString)));
 
 			StringTokenizer tokenizer = new StringTokenizer(extensionsString);
 			while ( tokenizer.hasMoreTokens() )
 				supportedExtensions.add(tokenizer.nextToken());
 		} else {
 			// Use forward compatible indexed EXTENSIONS
+			APIBuffer __buffer = apiBuffer();
 
 			nglGetIntegerv(GL_NUM_EXTENSIONS, __buffer.address(), GetIntegerv);
 			int extensionCount = __buffer.intValue(0);
 
 			long GetStringi = checkPointer(checkFunctionAddress(functionProvider.getFunctionAddress("glGetStringi")));
 			for ( int i = 0; i < extensionCount; i++ )
-				supportedExtensions.add(memDecodeASCII(memByteBufferNT1(nglGetStringi(GL_EXTENSIONS, i, GetStringi))));
-
-			// In real drivers, we may encounter the following weird scenarios:
-			// - 3.1 context without GL_ARB_compatibility but with deprecated functionality exposed and working.
-			// - Core or forward-compatible context with GL_ARB_compatibility exposed, but not working when used.
-			// We ignore these and go by the spec.
-
-			// Force forwardCompatible to true if the context is a forward-compatible context.
-			nglGetIntegerv(GL_CONTEXT_FLAGS, __buffer.address(), GetIntegerv);
-			if ( (__buffer.intValue(0) & GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT) != 0 )
-				forwardCompatible = true;
-			else {
-				// Force forwardCompatible to true if the context is a core profile context.
-				if ( (3 < majorVersion || 1 <= minorVersion) ) { // OpenGL 3.1+
-					if ( 3 < majorVersion || 2 <= minorVersion ) { // OpenGL 3.2+
-						nglGetIntegerv(GL_CONTEXT_PROFILE_MASK, __buffer.address(), GetIntegerv);
-						if ( (__buffer.intValue(0) & GL_CONTEXT_CORE_PROFILE_BIT) != 0 )
-							forwardCompatible = true;
-					} else
-						forwardCompatible = !supportedExtensions.contains("GL_ARB_compatibility");
-				}
-			}
+				supportedExtensions.add(memDecodeASCII(nglGetStringi(GL_EXTENSIONS, i, GetStringi)));
 		}
 
 		switch ( LWJGLUtil.getPlatform() ) {
@@ -286,7 +407,33 @@ public final class GL {
 				throw new UnsupportedOperationException();
 		}
 
-		return new ContextCapabilities(supportedExtensions, forwardCompatible);
+		return supportedExtensions;
+	}
+
+	private static String getDriverSignature(
+		long GetString, long GetIntegerv, int majorVersion, int minorVersion, boolean forwardCompatible, boolean lazyFunctions
+	) {
+		APIBuffer __buffer = apiBuffer();
+
+		int contextFlags = 0;
+		int profileMask = 0;
+		if ( 3 <= majorVersion ) {
+			nglGetIntegerv(GL_CONTEXT_FLAGS, __buffer.address(), GetIntegerv);
+			contextFlags = __buffer.intValue(0);
+
+			if ( 3 < majorVersion || 2 <= minorVersion ) {
+				nglGetIntegerv(GL_CONTEXT_PROFILE_MASK, __buffer.address(), GetIntegerv);
+				profileMask = __buffer.intValue(0);
+			}
+		}
+
+		return memDecodeUTF8(nglGetString(GL_VENDOR, GetString)) + '\n' +
+		       memDecodeUTF8(nglGetString(GL_RENDERER, GetString)) + '\n' +
+		       memDecodeUTF8(nglGetString(GL_VERSION, GetString)) + '\n' +
+		       contextFlags + '\n' +
+		       profileMask + '\n' +
+		       forwardCompatible + '\n' +
+		       lazyFunctions;
 	}
 
 	private static void addWGLExtensions(Set<String> supportedExtensions) {
@@ -294,13 +441,13 @@ public final class GL {
 
 		long wglGetExtensionsString = functionProvider.getFunctionAddress("wglGetExtensionsStringARB");
 		if ( wglGetExtensionsString != NULL ) {
-			wglExtensions = memDecodeASCII(memByteBufferNT1(nwglGetExtensionsStringARB(wglGetCurrentDC(), wglGetExtensionsString)));
+			wglExtensions = memDecodeASCII(nwglGetExtensionsStringARB(wglGetCurrentDC(), wglGetExtensionsString));
 		} else {
 			wglGetExtensionsString = functionProvider.getFunctionAddress("wglGetExtensionsStringEXT");
 			if ( wglGetExtensionsString == NULL )
 				return;
 
-			wglExtensions = memDecodeASCII(memByteBufferNT1(nwglGetExtensionsStringEXT(wglGetExtensionsString)));
+			wglExtensions = memDecodeASCII(nwglGetExtensionsStringEXT(wglGetExtensionsString));
 		}
 
 		StringTokenizer tokenizer = new StringTokenizer(wglExtensions);
@@ -341,16 +488,12 @@ public final class GL {
 		if ( glXQueryExtensionsString == NULL )
 			return;
 
-		String glxExtensions = memDecodeASCII(memByteBufferNT1(nglXQueryExtensionsString(display, 0, glXQueryExtensionsString)));
+		String glxExtensions = memDecodeASCII(nglXQueryExtensionsString(display, 0, glXQueryExtensionsString));
 		StringTokenizer tokenizer = new StringTokenizer(glxExtensions);
 		while ( tokenizer.hasMoreTokens() )
 			supportedExtensions.add(tokenizer.nextToken());
 	}
 
-	static long getFunctionAddress(FunctionProvider provider, String functionName, boolean fc) {
-		return fc ? NULL : provider.getFunctionAddress(functionName);
-	}
-
 	static boolean isFunctionSupported(long address) {
 		return address != NULL;
 	}
@@ -368,4 +511,16 @@ public final class GL {
 		}
 	}
 
-}
\ No newline at end of file
+	private static final class CurrentContext {
+
+		final Thread    thread;
+		final GLContext context;
+
+		CurrentContext(Thread thread, GLContext context) {
+			this.thread = thread;
+			this.context = context;
+		}
+
+	}
+
+}
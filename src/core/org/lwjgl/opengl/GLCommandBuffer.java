@@ -0,0 +1,125 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.opengl;
+
+import org.lwjgl.Sys;
+
+import java.nio.ByteBuffer;
+
+import static org.lwjgl.Pointer.*;
+import static org.lwjgl.system.MathUtil.*;
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * An off-heap buffer of recorded OpenGL commands, that are executed with a single native call. Commands are recorded with the {@code Recorder} class
+ * of each OpenGL class, for example {@link GL11.Recorder#glClear GL11.Recorder.glClear}.
+ * <p/>
+ * Executing a buffer does not clear it, so a buffer may be recorded once and replayed every frame. It must be executed in a thread where a context
+ * is current, that is compatible with the context used when recording (the function addresses are resolved when recording). Pointer arguments are
+ * recorded as raw addresses, the memory they point to must remain valid until the last execution of the buffer.
+ * <p/>
+ * Each command is stored as a sequence of 8-byte slots: the address of the native function that decodes the command, the address of the OpenGL
+ * function and one slot per argument.
+ * <p/>
+ * Instances of this class are not thread-safe and must be destroyed explicitly.
+ */
+public final class GLCommandBuffer {
+
+	private static final int SLOT_SIZE = 8;
+
+	private static final int DEFAULT_CAPACITY = 4096;
+
+	static {
+		Sys.touch();
+	}
+
+	private ByteBuffer buffer;
+	private long       address;
+
+	private int position;
+	private int commandCount;
+
+	/** Creates a new {@code GLCommandBuffer} with the default initial capacity. */
+	public GLCommandBuffer() {
+		this(DEFAULT_CAPACITY);
+	}
+
+	/**
+	 * Creates a new {@code GLCommandBuffer}. The buffer grows as needed.
+	 *
+	 * @param capacity the initial capacity, in bytes
+	 */
+	public GLCommandBuffer(int capacity) {
+		buffer = memAlloc(Math.max(capacity, 4 * SLOT_SIZE));
+		address = memAddress(buffer);
+	}
+
+	/** Returns the number of commands recorded in this buffer. */
+	public int getCommandCount() {
+		return commandCount;
+	}
+
+	/** Returns the number of bytes used by the recorded commands. */
+	public int getSize() {
+		return position;
+	}
+
+	/** Removes all recorded commands. */
+	public void clear() {
+		position = 0;
+		commandCount = 0;
+	}
+
+	/** Executes the recorded commands, in the order they were recorded, in the current context. */
+	public void execute() {
+		if ( position != 0 )
+			nExecute(address, address + position);
+	}
+
+	/** Frees the memory used by this buffer. The buffer must not be used after this call. */
+	public void destroy() {
+		memFree(buffer);
+		buffer = null;
+		address = NULL;
+		position = 0;
+		commandCount = 0;
+	}
+
+	/**
+	 * Appends a command and returns the address of its first argument slot. Used by the generated {@code Recorder} classes.
+	 *
+	 * @param command  the address of the native command function
+	 * @param function the OpenGL function address
+	 * @param args     the number of argument slots
+	 */
+	long record(long command, long function, int args) {
+		int offset = position;
+		int end = offset + (2 + args) * SLOT_SIZE;
+		if ( buffer.capacity() < end ) {
+			buffer = memRealloc(buffer, mathNextPoT(end));
+			address = memAddress(buffer);
+		}
+
+		long cmd = address + offset;
+		memPutLong(cmd, command);
+		memPutLong(cmd + SLOT_SIZE, function);
+
+		position = end;
+		commandCount++;
+
+		return cmd + 2 * SLOT_SIZE;
+	}
+
+	/** Reads the native command function table of an OpenGL class. Used by the generated {@code Recorder} classes. */
+	static long[] getCommands(long table, int count) {
+		long[] commands = new long[count];
+		for ( int i = 0; i < count; i++ )
+			commands[i] = memGetAddress(table + i * POINTER_SIZE);
+		return commands;
+	}
+
+	private static native void nExecute(long address, long end);
+
+}
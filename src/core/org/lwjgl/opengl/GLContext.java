@@ -94,8 +94,9 @@ public abstract class GLContext {
 	/** Destroys this {@code GLContext} and releases any resources associated with it. */
 	public void destroy() {
 		// Clean-up callbacks
-		if ( capabilities.GL_AMD_debug_output && capabilities.__AMDDebugOutput.DEBUGPROCAMD != NULL ) AMDDebugOutput.glDebugMessageCallbackAMD(null);
-		if ( capabilities.OpenGL43 && capabilities.__GL43.DEBUGPROC != NULL ) GL43.glDebugMessageCallback(null);
+		// The Functions instances are null if unsupported or, with lazy function resolution, if never used.
+		if ( capabilities.__AMDDebugOutput != null && capabilities.__AMDDebugOutput.DEBUGPROCAMD != NULL ) AMDDebugOutput.glDebugMessageCallbackAMD(null);
+		if ( capabilities.__GL43 != null && capabilities.__GL43.DEBUGPROC != NULL ) GL43.glDebugMessageCallback(null);
 
 		destroyImpl();
 	}
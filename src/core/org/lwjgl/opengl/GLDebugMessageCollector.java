@@ -0,0 +1,406 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.opengl;
+
+import org.lwjgl.Sys;
+import org.lwjgl.system.LongMap;
+
+import java.io.PrintStream;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.locks.LockSupport;
+
+import static org.lwjgl.system.MathUtil.*;
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * Collects KHR_debug or AMD_debug_output messages without calling into the JVM from the driver threads. It can be left enabled in production, with
+ * {@link GL43#GL_DEBUG_OUTPUT_SYNCHRONOUS} disabled.
+ * <p/>
+ * The native debug callback copies the raw message (source, type, id, severity and the message bytes) to a lock-free off-heap ring and returns. It
+ * never blocks or allocates; if the ring is full, the message is dropped and counted, see {@link #getDroppedCount}. A consumer thread drains the
+ * ring periodically and aggregates the messages by id: each distinct message is counted, and at most {@code limit} messages per id and period are
+ * passed to the {@link Handler}. The rest are suppressed and their number is passed with the next message of the same id that is not suppressed.
+ * <p/>
+ * The collector is attached to the current context with {@link #attach} and detached with {@link #detach}. It must be detached from all contexts
+ * before it is destroyed.
+ * <p/>
+ * For AMD_debug_output messages, the source is 0 and the type is the message category.
+ */
+public final class GLDebugMessageCollector {
+
+	/** Receives the messages that pass the rate limit, in the consumer thread. */
+	public interface Handler {
+
+		/**
+		 * Called for each message that is not suppressed.
+		 *
+		 * @param source     the message source, or 0 for AMD_debug_output messages
+		 * @param type       the message type, or the message category for AMD_debug_output messages
+		 * @param id         the message ID
+		 * @param severity   the message severity
+		 * @param message    the message, truncated to the maximum message size of the collector
+		 * @param suppressed the number of messages with the same source, type and ID that were suppressed since the previous call
+		 */
+		void invoke(int source, int type, int id, int severity, String message, int suppressed);
+
+	}
+
+	/** Prints the messages to the standard error stream, like the default {@link DEBUGPROC} and {@link DEBUGPROCAMD} implementations. */
+	public static final Handler DEFAULT_HANDLER = new Handler() {
+
+		private final DEBUGPROC    proc    = new DEBUGPROC();
+		private final DEBUGPROCAMD procAMD = new DEBUGPROCAMD();
+
+		@Override
+		public void invoke(int source, int type, int id, int severity, String message, int suppressed) {
+			synchronized ( this ) {
+				if ( source == 0 )
+					procAMD.invoke(id, type, severity, message);
+				else
+					proc.invoke(source, type, id, severity, message);
+
+				if ( suppressed != 0 )
+					System.err.println("\tSuppressed: " + suppressed + " identical messages");
+			}
+		}
+	};
+
+	// Ring layout, see org_lwjgl_opengl_GLDebugMessageCollector.c
+	static final int RING_HEAD         = 0;
+	static final int RING_DROPPED      = 4;
+	static final int RING_MASK         = 8;
+	static final int RING_MESSAGE_SIZE = 12;
+	static final int RING_TAIL         = 16;
+	static final int RING_HEADER_SIZE  = 32;
+
+	static final int SLOT_SEQUENCE    = 0;
+	static final int SLOT_SOURCE      = 4;
+	static final int SLOT_TYPE        = 8;
+	static final int SLOT_ID          = 12;
+	static final int SLOT_SEVERITY    = 16;
+	static final int SLOT_LENGTH      = 20;
+	static final int SLOT_HEADER_SIZE = 24;
+
+	/** The number of messages copied from the ring per native call. */
+	private static final int DRAIN_BATCH = 64;
+
+	private static final long CALLBACK;
+	private static final long CALLBACK_AMD;
+
+	static {
+		Sys.touch();
+
+		CALLBACK = getCallback();
+		CALLBACK_AMD = getCallbackAMD();
+	}
+
+	private final Handler handler;
+
+	private final int  limit;
+	private final long periodNanos;
+
+	private final int messageSize;
+	private final int slotSize;
+
+	private ByteBuffer ring;
+	private ByteBuffer output;
+
+	/** The aggregated messages, by source, type and id. Guarded by this. */
+	private final LongMap<Message> messages = new LongMap<Message>();
+
+	private Thread thread;
+	private volatile boolean running;
+
+	/**
+	 * Creates a new {@code GLDebugMessageCollector}. The consumer thread is not started until {@link #start} is called.
+	 *
+	 * @param handler     the message handler
+	 * @param capacity    the ring capacity, in messages. It is rounded up to the next power of two.
+	 * @param messageSize the maximum message size, in bytes. Longer messages are truncated.
+	 * @param limit       the maximum number of messages per id and period that are passed to the handler
+	 * @param period      the rate limiting period
+	 * @param unit        the period unit
+	 */
+	public GLDebugMessageCollector(Handler handler, int capacity, int messageSize, int limit, long period, TimeUnit unit) {
+		if ( handler == null )
+			throw new NullPointerException();
+		if ( capacity <= 0 || messageSize <= 0 || limit <= 0 )
+			throw new IllegalArgumentException();
+
+		this.handler = handler;
+		this.limit = limit;
+		this.periodNanos = unit.toNanos(period);
+
+		capacity = mathNextPoT(capacity);
+		this.messageSize = (messageSize + 7) & ~7;
+		this.slotSize = SLOT_HEADER_SIZE + this.messageSize;
+
+		ring = memAlloc(RING_HEADER_SIZE + capacity * slotSize);
+		output = memAlloc(DRAIN_BATCH * slotSize);
+
+		long address = memAddress(ring);
+		memSet(address, 0, RING_HEADER_SIZE);
+		memPutInt(address + RING_MASK, capacity - 1);
+		memPutInt(address + RING_MESSAGE_SIZE, this.messageSize);
+
+		// The slot at position p can be claimed when its sequence is p.
+		for ( int i = 0; i < capacity; i++ )
+			memPutInt(address + RING_HEADER_SIZE + i * slotSize + SLOT_SEQUENCE, i);
+	}
+
+	/**
+	 * Creates a new {@code GLDebugMessageCollector} with a capacity of 1024 messages of up to 512 bytes, that passes at most 10 messages per id and
+	 * second to the handler.
+	 *
+	 * @param handler the message handler
+	 */
+	public GLDebugMessageCollector(Handler handler) {
+		this(handler, 1024, 512, 10, 1L, TimeUnit.SECONDS);
+	}
+
+	private static native long getCallback();
+
+	private static native long getCallbackAMD();
+
+	private static native int nDrain(long ring, long output, int max);
+
+	/** Returns the address that is passed as the {@code userParam} to the native callback. */
+	long address() {
+		return memAddress(ring);
+	}
+
+	/**
+	 * Sets the collector as the debug message callback of the current context. KHR_debug is used if the context supports OpenGL 4.3, AMD_debug_output
+	 * otherwise. Any {@link DEBUGPROC} or {@link DEBUGPROCAMD} previously set is released.
+	 *
+	 * @throws IllegalStateException if neither OpenGL 4.3 nor AMD_debug_output is supported
+	 */
+	public void attach() {
+		GL43.Functions gl43 = GL43.getInstance();
+		if ( gl43 != null ) {
+			GL43.nglDebugMessageCallback(CALLBACK, address(), gl43.DebugMessageCallback);
+			DEBUGPROC.register(gl43, null);
+			return;
+		}
+
+		AMDDebugOutput.Functions amd = AMDDebugOutput.getInstance();
+		if ( amd != null ) {
+			AMDDebugOutput.nglDebugMessageCallbackAMD(CALLBACK_AMD, address(), amd.DebugMessageCallbackAMD);
+			DEBUGPROCAMD.register(amd, null);
+			return;
+		}
+
+		throw new IllegalStateException("Neither OpenGL 4.3 nor AMD_debug_output is supported by the current context.");
+	}
+
+	/** Clears the debug message callback of the current context. */
+	public void detach() {
+		GL43.Functions gl43 = GL43.getInstance();
+		if ( gl43 != null ) {
+			GL43.nglDebugMessageCallback(NULL, NULL, gl43.DebugMessageCallback);
+			return;
+		}
+
+		AMDDebugOutput.Functions amd = AMDDebugOutput.getInstance();
+		if ( amd != null )
+			AMDDebugOutput.nglDebugMessageCallbackAMD(NULL, NULL, amd.DebugMessageCallbackAMD);
+	}
+
+	/**
+	 * Starts a daemon thread that drains the ring every {@code interval}.
+	 *
+	 * @param interval the drain interval
+	 * @param unit     the interval unit
+	 *
+	 * @throws IllegalStateException if the thread has already been started
+	 */
+	public synchronized void start(long interval, TimeUnit unit) {
+		if ( thread != null )
+			throw new IllegalStateException("The consumer thread has already been started.");
+
+		final long intervalNanos = unit.toNanos(interval);
+
+		running = true;
+		thread = new Thread("LWJGL GL Debug Message Collector") {
+			@Override
+			public void run() {
+				while ( running ) {
+					flush();
+					LockSupport.parkNanos(intervalNanos);
+				}
+			}
+		};
+		thread.setDaemon(true);
+		thread.start();
+	}
+
+	/** Stops the consumer thread, if started, and drains the remaining messages in the current thread. */
+	public void stop() {
+		Thread thread;
+		synchronized ( this ) {
+			thread = this.thread;
+			this.thread = null;
+		}
+
+		if ( thread != null ) {
+			running = false;
+			LockSupport.unpark(thread);
+			try {
+				thread.join();
+			} catch (InterruptedException e) {
+				Thread.currentThread().interrupt();
+			}
+		}
+
+		flush();
+	}
+
+	/** Stops the consumer thread and frees the ring. The collector must have been detached from all contexts. */
+	public void destroy() {
+		stop();
+
+		synchronized ( this ) {
+			memFree(output);
+			memFree(ring);
+			output = null;
+			ring = null;
+		}
+	}
+
+	/**
+	 * Drains the ring in the current thread and passes the messages that are not suppressed to the handler.
+	 *
+	 * @return the number of messages drained
+	 */
+	public synchronized int flush() {
+		if ( ring == null )
+			return 0;
+
+		long ringAddress = memAddress(ring);
+		long outputAddress = memAddress(output);
+
+		int total = 0;
+		int count;
+		while ( 0 < (count = nDrain(ringAddress, outputAddress, DRAIN_BATCH)) ) {
+			long now = System.nanoTime();
+			for ( int i = 0; i < count; i++ )
+				process(outputAddress + i * slotSize, now);
+			total += count;
+		}
+		return total;
+	}
+
+	private void process(long slot, long now) {
+		int source = memGetInt(slot + SLOT_SOURCE);
+		int type = memGetInt(slot + SLOT_TYPE);
+		int id = memGetInt(slot + SLOT_ID);
+
+		long key = ((long)(source & 0xFFFF) << 48) | ((long)(type & 0xFFFF) << 32) | (id & 0xFFFFFFFFL);
+
+		Message message = messages.get(key);
+		if ( message == null ) {
+			message = new Message(source, type, id, now);
+			messages.put(key, message);
+		}
+
+		message.severity = memGetInt(slot + SLOT_SEVERITY);
+		message.count++;
+
+		if ( periodNanos <= now - message.periodStart ) {
+			message.periodStart = now;
+			message.periodCount = 0;
+		}
+
+		if ( limit <= message.periodCount ) {
+			message.suppressed++;
+			return;
+		}
+
+		message.periodCount++;
+
+		int length = Math.min(memGetInt(slot + SLOT_LENGTH), messageSize);
+		int suppressed = message.suppressed;
+		message.suppressed = 0;
+
+		handler.invoke(source, type, id, message.severity, memDecodeUTF8(memByteBuffer(slot + SLOT_HEADER_SIZE, length)), suppressed);
+	}
+
+	/** Returns the number of messages that were dropped because the ring was full. */
+	public int getDroppedCount() {
+		return ring == null ? 0 : memGetInt(memAddress(ring) + RING_DROPPED);
+	}
+
+	/**
+	 * Returns the total number of messages collected with the specified source, type and id.
+	 *
+	 * @param source the message source, or 0 for AMD_debug_output messages
+	 * @param type   the message type, or the message category for AMD_debug_output messages
+	 * @param id     the message ID
+	 */
+	public synchronized long getCount(int source, int type, int id) {
+		Message message = messages.get(((long)(source & 0xFFFF) << 48) | ((long)(type & 0xFFFF) << 32) | (id & 0xFFFFFFFFL));
+		return message == null ? 0L : message.count;
+	}
+
+	/** Returns the number of distinct messages collected. */
+	public synchronized int getMessageCount() {
+		return messages.size();
+	}
+
+	/**
+	 * Prints the number of messages collected per source, type and id, the most frequent first.
+	 *
+	 * @param out the output stream
+	 */
+	public synchronized void dump(PrintStream out) {
+		List<Message> list = new ArrayList<Message>(messages.size());
+		for ( LongMap.Cursor<Message> cursor = messages.cursor(); cursor.next(); )
+			list.add(cursor.value());
+
+		Collections.sort(list, new Comparator<Message>() {
+			@Override
+			public int compare(Message o1, Message o2) {
+				return o1.count < o2.count ? 1 : (o1.count == o2.count ? 0 : -1);
+			}
+		});
+
+		out.println("[LWJGL] GL debug messages: " + list.size() + " distinct, " + getDroppedCount() + " dropped");
+		for ( Message message : list ) {
+			out.format(
+				"\t%10d x ID: %d, source: 0x%X, type: 0x%X, severity: 0x%X%n",
+				message.count, message.id, message.source, message.type, message.severity
+			);
+		}
+	}
+
+	private static final class Message {
+
+		final int source;
+		final int type;
+		final int id;
+
+		int severity;
+
+		long count;
+
+		long periodStart;
+		int  periodCount;
+		int  suppressed;
+
+		Message(int source, int type, int id, long now) {
+			this.source = source;
+			this.type = type;
+			this.id = id;
+			this.periodStart = now;
+		}
+
+	}
+
+}
@@ -1,9 +1,9 @@
 package org.lwjgl.system;
 
 import org.lwjgl.BufferUtils;
-import org.lwjgl.PointerBuffer;
 
 import java.nio.ByteBuffer;
+import java.util.Arrays;
 
 import static org.lwjgl.Pointer.*;
 import static org.lwjgl.system.MathUtil.*;
@@ -13,6 +13,9 @@ import static org.lwjgl.system.MemoryUtil.*;
  * Helper class for alternative API functions. Instead of the user
  * passing their own buffer, thread-local instances of this class
  * are used internally instead.
+ * <p/>
+ * Values are read and written directly at the buffer address, without bounds checks. When the buffer grows, the previous memory block is kept alive
+ * until the next {@link #reset}, so addresses that have been handed out during the current call remain valid.
  */
 public class APIBuffer {
 
@@ -26,6 +29,10 @@ public class APIBuffer {
 	private int stackDepth;
 	private int[] stack = new int[4];
 
+	// Blocks replaced by ensureCapacity, kept reachable until the next reset.
+	private ByteBuffer[] retired = new ByteBuffer[4];
+	private int          retiredCount;
+
 	public APIBuffer() {
 		buffer = BufferUtils.createAlignedByteBufferPage(DEFAULT_CAPACITY);
 		address = memAddress(buffer);
@@ -34,13 +41,19 @@ public class APIBuffer {
 	/** Resets the parameter offset to 0. */
 	public APIBuffer reset() {
 		offset = 0;
+
+		if ( retiredCount != 0 ) {
+			Arrays.fill(retired, 0, retiredCount, null);
+			retiredCount = 0;
+		}
+
 		return this;
 	}
 
 	/** Pushes the current parameter offset to a stack. */
 	public APIBuffer push() {
 		if ( stackDepth == stack.length )
-			stack = new int[stack.length << 1];
+			stack = Arrays.copyOf(stack, stack.length << 1);
 
 		stack[stackDepth++] = offset;
 
@@ -66,7 +79,10 @@ public class APIBuffer {
 		this.offset = offset;
 	}
 
-	/** Returns the memory address of the internal {@link ByteBuffer}. This address may change after a call to one of the {@code <type>Param()} methods. */
+	/**
+	 * Returns the memory address of the internal {@link ByteBuffer}. This address may change after a call to one of the {@code <type>Param()} methods,
+	 * but a previously returned address remains valid until the next {@link #reset}.
+	 */
 	public long address() {
 		return address;
 	}
@@ -81,9 +97,11 @@ public class APIBuffer {
 			return;
 
 		ByteBuffer resized = BufferUtils.createAlignedByteBufferPage(mathNextPoT(capacity));
+		memCopy(address, memAddress(resized), buffer.capacity());
 
-		resized.put(buffer);
-		resized.clear();
+		if ( retiredCount == retired.length )
+			retired = Arrays.copyOf(retired, retiredCount << 1);
+		retired[retiredCount++] = buffer;
 
 		buffer = resized;
 		address = memAddress(resized);
@@ -127,108 +145,105 @@ public class APIBuffer {
 	/** Ensures space for an additional buffer with the given size (in bytes) and returns the address offset. */
 	public int bufferParam(int size) { return param(size, POINTER_SIZE); }
 
+	/** Encodes the specified text using ASCII encoding, stores it in this buffer and returns the address offset. */
+	public int stringParamASCII(CharSequence value, boolean nullTerminated) {
+		int offset = param(value.length() + (nullTerminated ? 1 : 0), 1);
+		memEncodeASCII(value, nullTerminated, address + offset);
+		return offset;
+	}
+
+	/** Encodes the specified text using UTF8 encoding, stores it in this buffer and returns the address offset. */
+	public int stringParamUTF8(CharSequence value, boolean nullTerminated) {
+		int offset = param(memLengthUTF8(value, nullTerminated), 1);
+		memEncodeUTF8(value, nullTerminated, address + offset);
+		return offset;
+	}
+
+	/** Encodes the specified text using UTF16 encoding, stores it in this buffer and returns the address offset. */
+	public int stringParamUTF16(CharSequence value, boolean nullTerminated) {
+		int offset = param((value.length() + (nullTerminated ? 1 : 0)) << 1, 2);
+		memEncodeUTF16(value, nullTerminated, address + offset);
+		return offset;
+	}
+
 	/** Returns the boolean value at the specified offset. */
-	public boolean booleanValue(int offset) { return buffer.get(offset) != 0; }
+	public boolean booleanValue(int offset) { return memGetByte(address + offset) != 0; }
 
 	/** Returns the boolean value at the specified offset. */
-	public byte byteValue(int offset) { return buffer.get(offset); }
+	public byte byteValue(int offset) { return memGetByte(address + offset); }
 
 	/** Returns the short value at the specified offset. */
-	public short shortValue(int offset) { return buffer.getShort(offset); }
+	public short shortValue(int offset) { return memGetShort(address + offset); }
 
 	/** Returns the int value at the specified offset. */
-	public int intValue(int offset) { return buffer.getInt(offset); }
+	public int intValue(int offset) { return memGetInt(address + offset); }
 
 	/** Returns the long value at the specified offset. */
-	public long longValue(int offset) { return buffer.getLong(offset); }
+	public long longValue(int offset) { return memGetLong(address + offset); }
 
 	/** Returns the float value at the specified offset. */
-	public float floatValue(int offset) { return buffer.getFloat(offset); }
+	public float floatValue(int offset) { return memGetFloat(address + offset); }
 
 	/** Returns the double value at the specified offset. */
-	public double doubleValue(int offset) { return buffer.getDouble(offset); }
+	public double doubleValue(int offset) { return memGetDouble(address + offset); }
 
 	/** Returns the pointer value at the specified offset. */
-	public long pointerValue(int offset) { return PointerBuffer.get(buffer, offset); }
+	public long pointerValue(int offset) { return memGetAddress(address + offset); }
 
 	/** Returns the ASCII string value at the specified byte range. */
-	public String stringValueASCII(int offset, int limit) {
-		buffer.position(offset);
-		buffer.limit(limit);
-		try {
-			return memDecodeASCII(buffer);
-		} finally {
-			buffer.clear();
-		}
-	}
+	public String stringValueASCII(int offset, int limit) { return memDecodeASCII(address + offset, limit - offset); }
 
 	/** Returns the UTF8 string value at the specified byte range. */
-	public String stringValueUTF8(int offset, int limit) {
-		buffer.position(offset);
-		buffer.limit(limit);
-		try {
-			return memDecodeUTF8(buffer);
-		} finally {
-			buffer.clear();
-		}
-	}
+	public String stringValueUTF8(int offset, int limit) { return memDecodeUTF8(address + offset, limit - offset); }
 
 	/** Returns the UTF16 string value at the specified byte range. */
-	public String stringValueUTF16(int offset, int limit) {
-		buffer.position(offset);
-		buffer.limit(limit);
-		try {
-			return memDecodeUTF16(buffer);
-		} finally {
-			buffer.clear();
-		}
-	}
+	public String stringValueUTF16(int offset, int limit) { return memDecodeUTF16(address + offset, limit - offset); }
 
 	/** Sets a boolean value at the specified offset. */
 	public APIBuffer booleanValue(int offset, boolean value) {
-		buffer.put(offset, value ? (byte)1 : (byte)0);
+		memPutByte(address + offset, value ? (byte)1 : (byte)0);
 		return this;
 	}
 
 	/** Sets a byte value at the specified offset. */
 	public APIBuffer byteValue(int offset, byte value) {
-		buffer.put(offset, value);
+		memPutByte(address + offset, value);
 		return this;
 	}
 
 	/** Sets a short value at the specified offset. */
 	public APIBuffer shortValue(int offset, short value) {
-		buffer.putShort(offset, value);
+		memPutShort(address + offset, value);
 		return this;
 	}
 
 	/** Sets an int value at the specified offset. */
 	public APIBuffer intValue(int offset, int value) {
-		buffer.putInt(offset, value);
+		memPutInt(address + offset, value);
 		return this;
 	}
 
 	/** Sets a long value at the specified offset. */
 	public APIBuffer longValue(int offset, long value) {
-		buffer.putLong(offset, value);
+		memPutLong(address + offset, value);
 		return this;
 	}
 
 	/** Sets a float value at the specified offset. */
 	public APIBuffer floatValue(int offset, float value) {
-		buffer.putFloat(offset, value);
+		memPutFloat(address + offset, value);
 		return this;
 	}
 
 	/** Sets a double value at the specified offset. */
 	public APIBuffer doubleValue(int offset, double value) {
-		buffer.putDouble(offset, value);
+		memPutDouble(address + offset, value);
 		return this;
 	}
 
 	/** Sets a pointer value at the specified offset. */
 	public APIBuffer pointerValue(int offset, long value) {
-		PointerBuffer.put(buffer, offset, value);
+		memPutAddress(address + offset, value);
 		return this;
 	}
 
@@ -240,8 +255,8 @@ public class APIBuffer {
 
 	/** Sets a pointer value at the given index of the pointer buffer that starts at the given offset. */
 	public APIBuffer pointerValue(int offset, int index, long value) {
-		PointerBuffer.put(buffer, offset + (index << POINTER_SHIFT), value);
+		memPutAddress(address + offset + (index << POINTER_SHIFT), value);
 		return this;
 	}
 
-}
\ No newline at end of file
+}
@@ -10,6 +10,9 @@ import org.lwjgl.system.macosx.MacOSXLibrary;
 import org.lwjgl.system.windows.WindowsLibrary;
 
 import java.lang.reflect.Method;
+import java.nio.ByteBuffer;
+
+import static org.lwjgl.system.MemoryUtil.*;
 
 public final class APIUtil {
 
@@ -70,4 +73,101 @@ public final class APIUtil {
 		}
 	}
 
+	/**
+	 * Returns the function addresses of multiple functions. An {@link AbstractFunctionProvider} resolves them with a single call, any other provider
+	 * with one {@link FunctionProvider#getFunctionAddress} call per function. Unsupported functions are set to 0L.
+	 *
+	 * @param provider  the function provider
+	 * @param names     the function names, as consecutive null-terminated ASCII strings, starting at the current buffer position
+	 * @param addresses the array that will receive the function addresses, one per function name
+	 */
+	public static void apiGetFunctionAddresses(FunctionProvider provider, ByteBuffer names, long[] addresses) {
+		if ( provider instanceof AbstractFunctionProvider ) {
+			((AbstractFunctionProvider)provider).getFunctionAddresses(names, addresses);
+			return;
+		}
+
+		long name = memAddress(names);
+		for ( int i = 0; i < addresses.length; i++ ) {
+			int length = memStrLen1(name);
+			addresses[i] = provider.getFunctionAddress(memDecodeASCII(name, length));
+			name += length + 1;
+		}
+	}
+
+	/** Local version of {@link #apiGetFunctionAddresses(FunctionProvider, ByteBuffer, long[])}. */
+	public static void apiGetFunctionAddresses(FunctionProviderLocal provider, long handle, ByteBuffer names, long[] addresses) {
+		if ( provider instanceof AbstractFunctionProviderLocal ) {
+			((AbstractFunctionProviderLocal)provider).getFunctionAddresses(handle, names, addresses);
+			return;
+		}
+
+		long name = memAddress(names);
+		for ( int i = 0; i < addresses.length; i++ ) {
+			int length = memStrLen1(name);
+			addresses[i] = provider.getFunctionAddress(handle, memDecodeASCII(name, length));
+			name += length + 1;
+		}
+	}
+
+	/**
+	 * Returns the addresses of multiple functions in a library. A {@link LinuxLibrary} resolves them with a single native call, other libraries with one
+	 * {@link DynamicLinkLibrary#getFunctionAddress(ByteBuffer)} call per function. Missing functions are set to 0L.
+	 *
+	 * @param library   the library
+	 * @param names     the function names, as consecutive null-terminated ASCII strings, starting at the current buffer position
+	 * @param addresses the array that will receive the function addresses, one per function name
+	 */
+	public static void apiGetFunctionAddresses(DynamicLinkLibrary library, ByteBuffer names, long[] addresses) {
+		if ( addresses.length == 0 )
+			return;
+
+		if ( library instanceof LinuxLibrary ) {
+			apiGetFunctionAddresses((LinuxLibrary)library, names, addresses, NULL);
+			return;
+		}
+
+		long name = memAddress(names);
+		for ( int i = 0; i < addresses.length; i++ ) {
+			int length = memStrLen1(name);
+			addresses[i] = library.getFunctionAddress(memByteBuffer(name, length + 1));
+			name += length + 1;
+		}
+	}
+
+	/**
+	 * Linux version of {@link #apiGetFunctionAddresses(DynamicLinkLibrary, ByteBuffer, long[])}, that optionally looks up each function with a
+	 * {@code glXGetProcAddress}-like function first.
+	 *
+	 * @see LinuxLibrary#getFunctionAddresses(ByteBuffer, int, long, long)
+	 */
+	public static void apiGetFunctionAddresses(LinuxLibrary library, ByteBuffer names, long[] addresses, long getProcAddress) {
+		if ( addresses.length == 0 )
+			return;
+
+		ByteBuffer table = memAlloc(addresses.length << 3);
+		try {
+			long address = memAddress(table);
+			library.getFunctionAddresses(names, addresses.length, address, getProcAddress);
+			for ( int i = 0; i < addresses.length; i++ )
+				addresses[i] = memGetLong(address + (i << 3));
+		} finally {
+			memFree(table);
+		}
+	}
+
+	/** Logs the functions in {@code names} that were not resolved, in the same way the single function lookups do. */
+	public static void apiLogMissingFunctions(String api, ByteBuffer names, long[] addresses) {
+		if ( !LWJGLUtil.DEBUG )
+			return;
+
+		long name = memAddress(names);
+		for ( int i = 0; i < addresses.length; i++ ) {
+			int length = memStrLen1(name);
+			if ( addresses[i] == NULL )
+				LWJGLUtil.log("Failed to locate address for " + api + " function " + memDecodeASCII(name, length));
+			name += length + 1;
+		}
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,25 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import java.nio.ByteBuffer;
+
+/**
+ * A {@link FunctionProvider} that can resolve multiple functions at once. Providers that can do this with a single native call should extend this
+ * class; {@link APIUtil#apiGetFunctionAddresses(FunctionProvider, ByteBuffer, long[])} uses one {@link #getFunctionAddress} call per function for
+ * any other provider.
+ */
+public abstract class AbstractFunctionProvider implements FunctionProvider {
+
+	/**
+	 * Returns the function addresses of multiple functions. This is used when creating {@link FunctionMap} instances. Unsupported functions are set to
+	 * 0L.
+	 *
+	 * @param names     the function names, as consecutive null-terminated ASCII strings, starting at the current buffer position
+	 * @param addresses the array that will receive the function addresses, one per function name
+	 */
+	public abstract void getFunctionAddresses(ByteBuffer names, long[] addresses);
+
+}
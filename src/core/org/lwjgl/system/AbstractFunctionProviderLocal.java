@@ -0,0 +1,31 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import java.nio.ByteBuffer;
+
+import static org.lwjgl.system.MemoryUtil.*;
+
+/** An {@link AbstractFunctionProvider} that is also a {@link FunctionProviderLocal}. */
+public abstract class AbstractFunctionProviderLocal extends AbstractFunctionProvider implements FunctionProviderLocal {
+
+	/**
+	 * Returns the function addresses of multiple functions for the platform, device or context specified by {@code handle}. Unsupported functions are
+	 * set to 0L. The default implementation calls {@link #getFunctionAddress(long, String)} for each function.
+	 *
+	 * @param handle    the handle to a platform/device/context
+	 * @param names     the function names, as consecutive null-terminated ASCII strings, starting at the current buffer position
+	 * @param addresses the array that will receive the function addresses, one per function name
+	 */
+	public void getFunctionAddresses(long handle, ByteBuffer names, long[] addresses) {
+		long name = memAddress(names);
+		for ( int i = 0; i < addresses.length; i++ ) {
+			int length = memStrLen1(name);
+			addresses[i] = getFunctionAddress(handle, memDecodeASCII(name, length));
+			name += length + 1;
+		}
+	}
+
+}
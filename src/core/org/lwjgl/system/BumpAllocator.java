@@ -0,0 +1,127 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * A {@link MemoryAllocator} that serves allocations from a single, contiguous block of memory by bumping a pointer. Allocation is extremely cheap and
+ * memory is released in bulk, with {@link #reset}. Individual calls to {@link #free} only reclaim memory if the freed block is the most recent
+ * allocation.
+ * <p/>
+ * This class is NOT thread-safe. It is meant to be used as a scratch arena, for example to hold all temporary allocations of a single frame.
+ */
+public class BumpAllocator implements MemoryAllocator {
+
+	// Matches the alignment guaranteed by malloc on all supported platforms.
+	private static final int DEFAULT_ALIGNMENT = 16;
+
+	private final long address;
+	private final long capacity;
+
+	private long offset;
+	private long last;
+
+	/**
+	 * Creates a new {@link BumpAllocator}. The backing memory is allocated using {@link MemoryUtil#memAllocator()}.
+	 *
+	 * @param capacity the capacity of the backing memory block, in bytes
+	 */
+	public BumpAllocator(long capacity) {
+		this.address = memAllocator().aligned_alloc(PAGE_SIZE, capacity);
+		if ( address == NULL )
+			throw new OutOfMemoryError("Failed to allocate native memory.");
+
+		this.capacity = capacity;
+		this.last = NULL;
+	}
+
+	/** Returns the capacity of this allocator, in bytes. */
+	public long getCapacity() {
+		return capacity;
+	}
+
+	/** Returns the number of bytes currently allocated, including any padding used for alignment. */
+	public long getOffset() {
+		return offset;
+	}
+
+	/** Releases all allocations made so far. */
+	public void reset() {
+		offset = 0;
+		last = NULL;
+	}
+
+	/** Frees the backing memory block. This allocator must not be used after this method has been called. */
+	public void destroy() {
+		memAllocator().aligned_free(address);
+	}
+
+	@Override
+	public long malloc(long size) {
+		return aligned_alloc(DEFAULT_ALIGNMENT, size);
+	}
+
+	@Override
+	public long calloc(long num, long size) {
+		long bytes = num * size;
+
+		long ptr = malloc(bytes);
+		if ( ptr != NULL )
+			memSet(ptr, 0, bytes);
+
+		return ptr;
+	}
+
+	@Override
+	public long realloc(long ptr, long size) {
+		if ( ptr == NULL )
+			return malloc(size);
+
+		// Grow or shrink the last allocation in-place
+		if ( ptr == last ) {
+			long end = ptr - address + size;
+			if ( capacity < end )
+				return NULL;
+
+			offset = end;
+			return ptr;
+		}
+
+		long newPtr = malloc(size);
+		if ( newPtr != NULL )
+			memCopy(ptr, newPtr, Math.min(size, newPtr - ptr));
+
+		return newPtr;
+	}
+
+	@Override
+	public void free(long ptr) {
+		if ( ptr != NULL && ptr == last ) {
+			offset = ptr - address;
+			last = NULL;
+		}
+	}
+
+	@Override
+	public long aligned_alloc(long alignment, long size) {
+		long ptr = (address + offset + (alignment - 1)) & -alignment;
+
+		long end = ptr - address + size;
+		if ( end < 0 || capacity < end )
+			return NULL;
+
+		offset = end;
+		last = ptr;
+
+		return ptr;
+	}
+
+	@Override
+	public void aligned_free(long ptr) {
+		free(ptr);
+	}
+
+}
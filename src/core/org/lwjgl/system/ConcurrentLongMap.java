@@ -0,0 +1,126 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+/**
+ * A thread-safe version of {@link LongMap}, for registries that are read from arbitrary threads, like native callback threads, and rarely modified.
+ * <p/>
+ * Reads are lock-free and wait-free: they read an immutable snapshot of the map. Writes are serialized and copy the map, so they are O(capacity).
+ * Values may not be null.
+ */
+public class ConcurrentLongMap<V> {
+
+	private final Object lock = new Object();
+
+	private volatile LongMap<V> map;
+
+	/** Creates a new {@code ConcurrentLongMap} with the default initial capacity. */
+	public ConcurrentLongMap() {
+		map = new LongMap<V>();
+	}
+
+	/**
+	 * Creates a new {@code ConcurrentLongMap}.
+	 *
+	 * @param initialCapacity the initial number of entries the map can hold without resizing
+	 */
+	public ConcurrentLongMap(int initialCapacity) {
+		map = new LongMap<V>(initialCapacity);
+	}
+
+	/**
+	 * Returns the value of the specified key. Never blocks.
+	 *
+	 * @param key the key
+	 *
+	 * @return the value, or null if the key is not in the map
+	 */
+	public V get(long key) {
+		return map.get(key);
+	}
+
+	/** Returns true if the map contains the specified key. Never blocks. */
+	public boolean containsKey(long key) {
+		return map.containsKey(key);
+	}
+
+	/**
+	 * Associates a value with the specified key.
+	 *
+	 * @param key   the key
+	 * @param value the value, must not be null
+	 *
+	 * @return the previous value of the key, or null if the key was not in the map
+	 */
+	public V put(long key, V value) {
+		synchronized ( lock ) {
+			LongMap<V> copy = new LongMap<V>(map);
+			V oldValue = copy.put(key, value);
+			map = copy;
+			return oldValue;
+		}
+	}
+
+	/**
+	 * Associates a value with the specified key, if the key is not already in the map.
+	 *
+	 * @param key   the key
+	 * @param value the value, must not be null
+	 *
+	 * @return the current value of the key, or null if the value was added
+	 */
+	public V putIfAbsent(long key, V value) {
+		synchronized ( lock ) {
+			V current = map.get(key);
+			if ( current != null )
+				return current;
+
+			put(key, value);
+			return null;
+		}
+	}
+
+	/**
+	 * Removes the specified key from the map.
+	 *
+	 * @param key the key
+	 *
+	 * @return the value of the key, or null if the key was not in the map
+	 */
+	public V remove(long key) {
+		synchronized ( lock ) {
+			if ( !map.containsKey(key) )
+				return null;
+
+			LongMap<V> copy = new LongMap<V>(map);
+			V oldValue = copy.remove(key);
+			map = copy;
+			return oldValue;
+		}
+	}
+
+	/** Returns the number of entries in the map. */
+	public int size() {
+		return map.size();
+	}
+
+	/** Returns true if the map has no entries. */
+	public boolean isEmpty() {
+		return map.isEmpty();
+	}
+
+	/** Removes all entries from the map. */
+	public void clear() {
+		synchronized ( lock ) {
+			map = new LongMap<V>();
+		}
+	}
+
+	/** Returns a cursor over a snapshot of the entries of the map. The map may be modified while the cursor is in use. */
+	public LongMap.Cursor<V> cursor() {
+		return map.cursor();
+	}
+
+}
@@ -19,11 +19,14 @@ import static org.lwjgl.system.MathUtil.*;
 /**
  * A hash map using primitive longs as keys rather than objects.
  *
+ * @deprecated Use {@link LongMap} or {@link ConcurrentLongMap}, which do not allocate per entry.
+ *
  * @author Justin Couch
  * @author Alex Chaffee (alex@apache.org)
  * @author Stephen Colebourne
  * @author Nathan Sweet
  */
+@Deprecated
 public class FastLongMap<V> implements Iterable<FastLongMap.Entry<V>> {
 
 	private Entry<V>[] table;
@@ -0,0 +1,271 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import static org.lwjgl.system.MathUtil.*;
+
+/**
+ * A hash map using primitive longs as keys rather than objects. Values may not be null.
+ * <p/>
+ * The map uses open addressing with linear probing, in parallel key and value arrays, so that it does not allocate per entry. Removals shift the
+ * following entries of the probe sequence back, instead of leaving tombstones, so lookups never slow down over time.
+ * <p/>
+ * Instances of this class are not thread-safe. See {@link ConcurrentLongMap} for a map that supports lock-free reads.
+ */
+public class LongMap<V> {
+
+	private static final int DEFAULT_CAPACITY = 16;
+
+	// A slot is empty if its value is null.
+	private long[]   keys;
+	private Object[] values;
+
+	private int size;
+	private int mask;
+	private int threshold;
+
+	/** Creates a new {@code LongMap} with the default initial capacity. */
+	public LongMap() {
+		this(DEFAULT_CAPACITY);
+	}
+
+	/**
+	 * Creates a new {@code LongMap}.
+	 *
+	 * @param initialCapacity the initial number of entries the map can hold without resizing
+	 */
+	public LongMap(int initialCapacity) {
+		if ( initialCapacity < 0 || 1 << 29 < initialCapacity )
+			throw new IllegalArgumentException("Invalid initial capacity: " + initialCapacity);
+
+		// Keep the load factor at or below 0.5, probe sequences stay short with linear probing.
+		allocate(mathNextPoT(Math.max(initialCapacity, 4) << 1));
+	}
+
+	/** Copy constructor. */
+	LongMap(LongMap<V> map) {
+		this.keys = map.keys.clone();
+		this.values = map.values.clone();
+		this.size = map.size;
+		this.mask = map.mask;
+		this.threshold = map.threshold;
+	}
+
+	private void allocate(int capacity) {
+		keys = new long[capacity];
+		values = new Object[capacity];
+		mask = capacity - 1;
+		threshold = capacity >> 1;
+	}
+
+	private static int hash(long key) {
+		// Handles and pointers are aligned, mix the high bits into the low bits.
+		long h = key * 0x9E3779B97F4A7C15L;
+		return (int)(h ^ (h >>> 32));
+	}
+
+	/** Returns the slot of the specified key, or -1 if the key is not in the map. */
+	private int find(long key) {
+		long[] keys = this.keys;
+		Object[] values = this.values;
+		int mask = this.mask;
+
+		for ( int i = hash(key) & mask; ; i = (i + 1) & mask ) {
+			if ( values[i] == null )
+				return -1;
+			if ( keys[i] == key )
+				return i;
+		}
+	}
+
+	/**
+	 * Returns the value of the specified key.
+	 *
+	 * @param key the key
+	 *
+	 * @return the value, or null if the key is not in the map
+	 */
+	@SuppressWarnings("unchecked")
+	public V get(long key) {
+		long[] keys = this.keys;
+		Object[] values = this.values;
+		int mask = this.mask;
+
+		for ( int i = hash(key) & mask; ; i = (i + 1) & mask ) {
+			Object value = values[i];
+			if ( value == null || keys[i] == key )
+				return (V)value;
+		}
+	}
+
+	/** Returns true if the map contains the specified key. */
+	public boolean containsKey(long key) {
+		return find(key) != -1;
+	}
+
+	/**
+	 * Associates a value with the specified key.
+	 *
+	 * @param key   the key
+	 * @param value the value, must not be null
+	 *
+	 * @return the previous value of the key, or null if the key was not in the map
+	 */
+	@SuppressWarnings("unchecked")
+	public V put(long key, V value) {
+		if ( value == null )
+			throw new NullPointerException();
+
+		long[] keys = this.keys;
+		Object[] values = this.values;
+		int mask = this.mask;
+
+		int i = hash(key) & mask;
+		for ( ; values[i] != null; i = (i + 1) & mask ) {
+			if ( keys[i] == key ) {
+				V oldValue = (V)values[i];
+				values[i] = value;
+				return oldValue;
+			}
+		}
+
+		keys[i] = key;
+		values[i] = value;
+
+		if ( threshold < ++size )
+			resize();
+
+		return null;
+	}
+
+	private void resize() {
+		long[] keys = this.keys;
+		Object[] values = this.values;
+
+		allocate(keys.length << 1);
+
+		long[] newKeys = this.keys;
+		Object[] newValues = this.values;
+		int newMask = this.mask;
+
+		for ( int j = 0; j < keys.length; j++ ) {
+			if ( values[j] == null )
+				continue;
+
+			int i = hash(keys[j]) & newMask;
+			while ( newValues[i] != null )
+				i = (i + 1) & newMask;
+
+			newKeys[i] = keys[j];
+			newValues[i] = values[j];
+		}
+	}
+
+	/**
+	 * Removes the specified key from the map.
+	 *
+	 * @param key the key
+	 *
+	 * @return the value of the key, or null if the key was not in the map
+	 */
+	@SuppressWarnings("unchecked")
+	public V remove(long key) {
+		int i = find(key);
+		if ( i == -1 )
+			return null;
+
+		V oldValue = (V)values[i];
+		removeSlot(i);
+		return oldValue;
+	}
+
+	private void removeSlot(int hole) {
+		long[] keys = this.keys;
+		Object[] values = this.values;
+		int mask = this.mask;
+
+		// Shift back the following entries of the probe sequence that would not be reachable from their home slot across the hole.
+		for ( int i = (hole + 1) & mask; values[i] != null; i = (i + 1) & mask ) {
+			int home = hash(keys[i]) & mask;
+			if ( ((i - home) & mask) < ((i - hole) & mask) )
+				continue;
+
+			keys[hole] = keys[i];
+			values[hole] = values[i];
+			hole = i;
+		}
+
+		keys[hole] = 0L;
+		values[hole] = null;
+		size--;
+	}
+
+	/** Returns the number of entries in the map. */
+	public int size() {
+		return size;
+	}
+
+	/** Returns true if the map has no entries. */
+	public boolean isEmpty() {
+		return size == 0;
+	}
+
+	/** Removes all entries from the map. */
+	public void clear() {
+		long[] keys = this.keys;
+		Object[] values = this.values;
+		for ( int i = 0; i < keys.length; i++ ) {
+			keys[i] = 0L;
+			values[i] = null;
+		}
+		size = 0;
+	}
+
+	/**
+	 * Returns a cursor over the entries of the map. The map must not be modified while the cursor is in use.
+	 * <pre>
+	 * for ( LongMap.Cursor&lt;V&gt; cursor = map.cursor(); cursor.next(); )
+	 *     process(cursor.key(), cursor.value());</pre>
+	 */
+	public Cursor<V> cursor() {
+		return new Cursor<V>(keys, values);
+	}
+
+	/** Iterates over the entries of a map, without allocating per entry. */
+	public static final class Cursor<V> {
+
+		private final long[]   keys;
+		private final Object[] values;
+
+		private int index = -1;
+
+		Cursor(long[] keys, Object[] values) {
+			this.keys = keys;
+			this.values = values;
+		}
+
+		/** Advances to the next entry. Returns false if there are no more entries. */
+		public boolean next() {
+			while ( ++index < values.length ) {
+				if ( values[index] != null )
+					return true;
+			}
+			return false;
+		}
+
+		/** Returns the key of the current entry. */
+		public long key() {
+			return keys[index];
+		}
+
+		/** Returns the value of the current entry. */
+		@SuppressWarnings("unchecked")
+		public V value() {
+			return (V)values[index];
+		}
+
+	}
+
+}
@@ -21,6 +21,10 @@ public final class MathUtil {
 		return v + 1;
 	}
 
+	public static boolean mathIsPoT(int value) {
+		return 0 < value && (value & (value - 1)) == 0;
+	}
+
 	public static long mathUIntToPtr(int value) {
 		return value & 0xFFFFFFFFL;
 	}
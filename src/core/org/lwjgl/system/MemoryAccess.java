@@ -68,13 +68,13 @@ final class MemoryAccess {
 	abstract static class MemoryAccessor {
 
 		int getPageSize() {
-			// TODO: Can we do better?
-			return 4096;
+			int pageSize = nMemPageSize();
+			return pageSize == 0 ? 4096 : pageSize;
 		}
 
 		int getCacheLineSize() {
-			// TODO: Can we do better?
-			return 64;
+			int cacheLineSize = nMemCacheLineSize();
+			return cacheLineSize == 0 ? 64 : cacheLineSize;
 		}
 
 		abstract long getAddress(Buffer buffer);
@@ -107,12 +107,18 @@ final class MemoryAccess {
 
 		abstract DoubleBuffer setupBuffer(DoubleBuffer buffer, long address, int capacity);
 
-		void memSet(long dst, int value, int bytes) { nMemSet(dst, value, bytes); }
+		void memSet(long dst, int value, long bytes) { nMemSet(dst, value, bytes); }
 
-		void memCopy(long src, long dst, int bytes) {
+		void memCopy(long src, long dst, long bytes) {
 			nMemCopy(dst, src, bytes); // Note the swapped src & dst
 		}
 
+		void memFill(long dst, long pattern, int patternSize, long count) { nMemFill(dst, pattern, patternSize, count); }
+
+		int memStrLen1(long address) { return (int)nMemStrLen1(address); }
+
+		int memStrLen2(long address) { return (int)nMemStrLen2(address) << 1; }
+
 		byte memGetByte(long ptr) { return nMemGetByte(ptr); }
 
 		short memGetShort(long ptr) { return nMemGetShort(ptr); }
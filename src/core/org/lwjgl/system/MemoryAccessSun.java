@@ -16,6 +16,7 @@ import sun.misc.Unsafe;
 import sun.reflect.FieldAccessor;
 
 import static org.lwjgl.system.MemoryAccess.*;
+import static org.lwjgl.system.MemoryUtil.*;
 
 /**
  * MemoryAccessor implementations that depend on sun.misc.
@@ -30,6 +31,15 @@ final class MemoryAccessSun {
 	/** Implementation using sun.misc.Unsafe. */
 	private static class MemoryAccessorUnsafe extends MemoryAccessorJava {
 
+		/**
+		 * Blocks up to this size are set/copied with a simple word loop. For such sizes, the overhead of the Unsafe.setMemory/copyMemory call
+		 * (or a JNI transition) dominates the actual work.
+		 */
+		private static final int SMALL_BLOCK_SIZE = 64;
+
+		/** Strings are scanned in Java up to this length. The rest of a longer string is scanned with the native (vectorized) strlen. */
+		private static final int STRLEN_JAVA_SCAN = 256;
+
 		private final Unsafe unsafe;
 
 		private final long address;
@@ -127,13 +137,104 @@ final class MemoryAccessSun {
 		}
 
 		@Override
-		void memSet(long dst, int value, int bytes) {
-			unsafe.setMemory(dst, bytes, (byte)(value & 0xFF));
+		void memSet(long dst, int value, long bytes) {
+			if ( SMALL_BLOCK_SIZE < bytes || (dst & 7) != 0 ) {
+				unsafe.setMemory(dst, bytes, (byte)(value & 0xFF));
+				return;
+			}
+
+			long fill = (value & 0xFFL) * 0x0101010101010101L;
+
+			long i = 0;
+			for ( ; i <= bytes - 8; i += 8 )
+				unsafe.putLong(dst + i, fill);
+			for ( ; i < bytes; i++ )
+				unsafe.putByte(dst + i, (byte)value);
+		}
+
+		@Override
+		void memCopy(long src, long dst, long bytes) {
+			if ( SMALL_BLOCK_SIZE < bytes || ((src | dst) & 7) != 0 ) {
+				unsafe.copyMemory(src, dst, bytes);
+				return;
+			}
+
+			long i = 0;
+			for ( ; i <= bytes - 8; i += 8 )
+				unsafe.putLong(dst + i, unsafe.getLong(src + i));
+			for ( ; i < bytes; i++ )
+				unsafe.putByte(dst + i, unsafe.getByte(src + i));
+		}
+
+		@Override
+		void memFill(long dst, long pattern, int patternSize, long count) {
+			if ( SMALL_BLOCK_SIZE < count * patternSize ) {
+				nMemFill(dst, pattern, patternSize, count);
+				return;
+			}
+
+			long end = dst + count * patternSize;
+			switch ( patternSize ) {
+				case 2:
+					for ( ; dst < end; dst += 2 )
+						unsafe.putShort(dst, (short)pattern);
+					break;
+				case 4:
+					for ( ; dst < end; dst += 4 )
+						unsafe.putInt(dst, (int)pattern);
+					break;
+				default:
+					for ( ; dst < end; dst += 8 )
+						unsafe.putLong(dst, pattern);
+			}
+		}
+
+		@Override
+		int memStrLen1(long address) {
+			long ptr = address;
+
+			// Scan bytes until the pointer is aligned, word reads must not cross a page boundary
+			for ( ; (ptr & 7) != 0; ptr++ ) {
+				if ( unsafe.getByte(ptr) == 0 )
+					return (int)(ptr - address);
+			}
+
+			long limit = address + STRLEN_JAVA_SCAN;
+			for ( ; ptr < limit; ptr += 8 ) {
+				long word = unsafe.getLong(ptr);
+				if ( ((word - 0x0101010101010101L) & ~word & 0x8080808080808080L) != 0 ) {
+					while ( unsafe.getByte(ptr) != 0 )
+						ptr++;
+					return (int)(ptr - address);
+				}
+			}
+
+			return (int)(ptr - address + nMemStrLen1(ptr));
 		}
 
 		@Override
-		void memCopy(long src, long dst, int bytes) {
-			unsafe.copyMemory(src, dst, bytes);
+		int memStrLen2(long address) {
+			if ( (address & 1) != 0 )
+				return super.memStrLen2(address);
+
+			long ptr = address;
+
+			for ( ; (ptr & 7) != 0; ptr += 2 ) {
+				if ( unsafe.getShort(ptr) == 0 )
+					return (int)(ptr - address);
+			}
+
+			long limit = address + STRLEN_JAVA_SCAN;
+			for ( ; ptr < limit; ptr += 8 ) {
+				long word = unsafe.getLong(ptr);
+				if ( ((word - 0x0001000100010001L) & ~word & 0x8000800080008000L) != 0 ) {
+					while ( unsafe.getShort(ptr) != 0 )
+						ptr += 2;
+					return (int)(ptr - address);
+				}
+			}
+
+			return (int)(ptr - address + (nMemStrLen2(ptr) << 1));
 		}
 
 		@Override
@@ -0,0 +1,37 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+/**
+ * A native memory allocator. The methods of this interface follow the semantics of the corresponding standard C functions. Implementations must be
+ * thread-safe, unless documented otherwise.
+ * <p/>
+ * The allocator used by {@link MemoryUtil#memAlloc} and friends can be selected with the {@code org.lwjgl.util.Allocator} system property. Supported
+ * values are {@code "system"} (the default), {@code "debug"} and the fully qualified name of a class that implements this interface and has a public
+ * no-argument constructor.
+ *
+ * @see MemoryUtil#memAllocator()
+ */
+public interface MemoryAllocator {
+
+	/** Called by {@link MemoryUtil#memAlloc}. */
+	long malloc(long size);
+
+	/** Called by {@link MemoryUtil#memCalloc}. */
+	long calloc(long num, long size);
+
+	/** Called by {@link MemoryUtil#memRealloc}. */
+	long realloc(long ptr, long size);
+
+	/** Called by {@link MemoryUtil#memFree}. */
+	void free(long ptr);
+
+	/** Called by {@link MemoryUtil#memAlignedAlloc}. */
+	long aligned_alloc(long alignment, long size);
+
+	/** Called by {@link MemoryUtil#memAlignedFree}. */
+	void aligned_free(long ptr);
+
+}
@@ -0,0 +1,375 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.LWJGLUtil;
+
+import java.io.PrintStream;
+import java.security.AccessController;
+import java.security.PrivilegedAction;
+import java.util.*;
+
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * Provides the {@link MemoryAllocator} implementations used by MemoryUtil. The system allocator is used by default; the debug allocator must be
+ * explicitly selected and has no effect on performance otherwise.
+ */
+public final class MemoryManage {
+
+	private MemoryManage() {
+	}
+
+	static MemoryAllocator getInstance() {
+		String allocator = AccessController.doPrivileged(new PrivilegedAction<String>() {
+			@Override
+			public String run() {
+				return System.getProperty("org.lwjgl.util.Allocator", "system");
+			}
+		});
+
+		if ( "system".equals(allocator) )
+			return new StdlibAllocator();
+
+		if ( "debug".equals(allocator) )
+			return new DebugAllocator(new StdlibAllocator()).reportAtExit();
+
+		try {
+			return (MemoryAllocator)Class.forName(allocator).newInstance();
+		} catch (Exception e) {
+			LWJGLUtil.log("Failed to instantiate memory allocator: " + allocator + ". The system allocator will be used instead.");
+			return new StdlibAllocator();
+		}
+	}
+
+	/** The standard C memory allocator. */
+	static final class StdlibAllocator implements MemoryAllocator {
+
+		@Override
+		public long malloc(long size) { return nMemAlloc(size); }
+
+		@Override
+		public long calloc(long num, long size) { return nMemCalloc(num, size); }
+
+		@Override
+		public long realloc(long ptr, long size) { return nMemRealloc(ptr, size); }
+
+		@Override
+		public void free(long ptr) { nMemFree(ptr); }
+
+		@Override
+		public long aligned_alloc(long alignment, long size) { return nMemAlignedAlloc(alignment, size); }
+
+		@Override
+		public void aligned_free(long ptr) { nMemAlignedFree(ptr); }
+
+	}
+
+	/**
+	 * A {@link MemoryAllocator} that wraps another allocator and tracks every live memory block. For each block, the size, the allocating thread and
+	 * the stack trace at the time of allocation are recorded. It detects double frees, frees of pointers it did not allocate and mismatched
+	 * aligned/unaligned frees. Such errors are reported to {@code System.err} and the offending call is not forwarded to the wrapped allocator.
+	 * <p/>
+	 * This allocator is expensive and should only be used during development. It can be enabled with {@code -Dorg.lwjgl.util.Allocator=debug}, in
+	 * which case any leaked memory blocks are reported at JVM shutdown.
+	 */
+	public static final class DebugAllocator implements MemoryAllocator {
+
+		private static final int FREED_HISTORY = 1024;
+
+		private final MemoryAllocator allocator;
+
+		private final Map<Long, Allocation>           allocations = new HashMap<Long, Allocation>();
+		private final Map<StackTraceElement, CallSite> callSites   = new HashMap<StackTraceElement, CallSite>();
+
+		// Recently freed addresses, used to distinguish double frees from frees of foreign pointers.
+		private final Set<Long>       freed      = new HashSet<Long>();
+		private final ArrayDeque<Long> freedOrder = new ArrayDeque<Long>(FREED_HISTORY);
+
+		private final long startTime = System.nanoTime();
+
+		private long liveBytes;
+
+		// The size of the last untracked allocation. Only valid while holding the lock.
+		private long previousSize;
+
+		/**
+		 * Creates a new {@link DebugAllocator}.
+		 *
+		 * @param allocator the allocator to which the actual allocations will be forwarded
+		 */
+		public DebugAllocator(MemoryAllocator allocator) {
+			this.allocator = allocator;
+		}
+
+		DebugAllocator reportAtExit() {
+			Runtime.getRuntime().addShutdownHook(new Thread("LWJGL DebugAllocator") {
+				@Override
+				public void run() {
+					reportLeaks(System.err);
+				}
+			});
+			return this;
+		}
+
+		@Override
+		public long malloc(long size) {
+			return track(allocator.malloc(size), size, false);
+		}
+
+		@Override
+		public long calloc(long num, long size) {
+			return track(allocator.calloc(num, size), num * size, false);
+		}
+
+		@Override
+		public long realloc(long ptr, long size) {
+			if ( ptr == NULL )
+				return malloc(size);
+
+			long previousSize;
+			synchronized ( this ) {
+				if ( !untrack(ptr, false, "realloc") )
+					return NULL;
+
+				previousSize = this.previousSize;
+			}
+
+			long address = allocator.realloc(ptr, size);
+			if ( address == NULL ) {
+				// The original block is still valid
+				track(ptr, previousSize, false);
+				return NULL;
+			}
+
+			return track(address, size, false);
+		}
+
+		@Override
+		public void free(long ptr) {
+			if ( ptr != NULL && untrack(ptr, false, "free") )
+				allocator.free(ptr);
+		}
+
+		@Override
+		public long aligned_alloc(long alignment, long size) {
+			return track(allocator.aligned_alloc(alignment, size), size, true);
+		}
+
+		@Override
+		public void aligned_free(long ptr) {
+			if ( ptr != NULL && untrack(ptr, true, "aligned_free") )
+				allocator.aligned_free(ptr);
+		}
+
+		private long track(long address, long size, boolean aligned) {
+			if ( address == NULL )
+				return NULL;
+
+			Thread thread = Thread.currentThread();
+			StackTraceElement[] stackTrace = new Throwable().getStackTrace();
+
+			synchronized ( this ) {
+				StackTraceElement location = getCallSite(stackTrace);
+
+				CallSite site = callSites.get(location);
+				if ( site == null )
+					callSites.put(location, site = new CallSite(location));
+
+				site.totalCount++;
+				site.totalBytes += size;
+				site.liveCount++;
+				site.liveBytes += size;
+
+				liveBytes += size;
+
+				if ( freed.remove(address) )
+					freedOrder.remove(address);
+
+				allocations.put(address, new Allocation(address, size, aligned, thread.getName(), stackTrace, site));
+			}
+
+			return address;
+		}
+
+		private synchronized boolean untrack(long address, boolean aligned, String function) {
+			Allocation allocation = allocations.get(address);
+			if ( allocation == null ) {
+				reportError(freed.contains(address)
+				            ? "Double " + function + " detected for address 0x" + Long.toHexString(address)
+				            : "Invalid " + function + " detected. Address 0x" + Long.toHexString(address) + " was not allocated by this allocator."
+				);
+				return false;
+			}
+
+			if ( allocation.aligned != aligned ) {
+				reportError("Mismatched " + function + " detected for address 0x" + Long.toHexString(address) + ". The memory block was allocated with " +
+				            (allocation.aligned ? "aligned_alloc." : "malloc, calloc or realloc."));
+				return false;
+			}
+
+			allocations.remove(address);
+
+			allocation.site.liveCount--;
+			allocation.site.liveBytes -= allocation.size;
+
+			liveBytes -= allocation.size;
+			previousSize = allocation.size;
+
+			if ( freedOrder.size() == FREED_HISTORY )
+				freed.remove(freedOrder.removeFirst());
+			freed.add(address);
+			freedOrder.addLast(address);
+
+			return true;
+		}
+
+		private static StackTraceElement getCallSite(StackTraceElement[] stackTrace) {
+			String manage = MemoryManage.class.getName();
+
+			// Skip the allocator frames. Classes that only share the prefix, like MemoryManageTest, are call sites.
+			for ( StackTraceElement element : stackTrace ) {
+				String className = element.getClassName();
+				if ( className.equals(manage) || className.startsWith(manage + "$") || className.equals(MemoryUtil.class.getName()) )
+					continue;
+
+				return element;
+			}
+
+			return stackTrace[stackTrace.length - 1];
+		}
+
+		private static void reportError(String message) {
+			new IllegalStateException("[LWJGL] " + message).printStackTrace();
+		}
+
+		/** Returns the number of memory blocks that have been allocated and not yet freed. */
+		public synchronized int getLiveCount() {
+			return allocations.size();
+		}
+
+		/** Returns the total size of the memory blocks that have been allocated and not yet freed, in bytes. */
+		public synchronized long getLiveBytes() {
+			return liveBytes;
+		}
+
+		/** Returns a snapshot of the allocation statistics of each call site, sorted by live bytes in decreasing order. */
+		public synchronized List<CallSite> getCallSites() {
+			double seconds = (System.nanoTime() - startTime) / 1e9;
+
+			List<CallSite> sites = new ArrayList<CallSite>(callSites.size());
+			for ( CallSite site : callSites.values() )
+				sites.add(site.snapshot(seconds));
+
+			Collections.sort(sites, new Comparator<CallSite>() {
+				@Override
+				public int compare(CallSite o1, CallSite o2) {
+					return o1.liveBytes < o2.liveBytes ? 1 : (o1.liveBytes == o2.liveBytes ? 0 : -1);
+				}
+			});
+
+			return sites;
+		}
+
+		/**
+		 * Prints all memory blocks that have been allocated and not yet freed, along with the thread and stack trace that allocated them.
+		 *
+		 * @param out the stream to print to
+		 */
+		public synchronized void reportLeaks(PrintStream out) {
+			if ( allocations.isEmpty() )
+				return;
+
+			out.println("[LWJGL] " + allocations.size() + " memory leak(s) detected, " + liveBytes + " bytes total:");
+			for ( Allocation allocation : allocations.values() ) {
+				out.println("\t0x" + Long.toHexString(allocation.address) + ": " + allocation.size + " bytes, allocated in thread \"" + allocation.threadName + "\"");
+				// Skip Throwable#<init> and the allocator frames
+				boolean skip = true;
+				for ( StackTraceElement element : allocation.stackTrace ) {
+					if ( skip && element.equals(allocation.site.location) )
+						skip = false;
+					if ( !skip )
+						out.println("\t\tat " + element);
+				}
+			}
+		}
+
+		private static final class Allocation {
+
+			final long    address;
+			final long    size;
+			final boolean aligned;
+
+			final String              threadName;
+			final StackTraceElement[] stackTrace;
+
+			final CallSite site;
+
+			Allocation(long address, long size, boolean aligned, String threadName, StackTraceElement[] stackTrace, CallSite site) {
+				this.address = address;
+				this.size = size;
+				this.aligned = aligned;
+				this.threadName = threadName;
+				this.stackTrace = stackTrace;
+				this.site = site;
+			}
+		}
+
+		/** Allocation statistics for a single call site. */
+		public static final class CallSite {
+
+			final StackTraceElement location;
+
+			long liveCount;
+			long liveBytes;
+
+			long totalCount;
+			long totalBytes;
+
+			double allocationRate;
+
+			CallSite(StackTraceElement location) {
+				this.location = location;
+			}
+
+			CallSite snapshot(double seconds) {
+				CallSite snapshot = new CallSite(location);
+
+				snapshot.liveCount = liveCount;
+				snapshot.liveBytes = liveBytes;
+				snapshot.totalCount = totalCount;
+				snapshot.totalBytes = totalBytes;
+				snapshot.allocationRate = seconds == 0.0 ? 0.0 : totalCount / seconds;
+
+				return snapshot;
+			}
+
+			/** Returns the source location of the allocation. */
+			public StackTraceElement getLocation() { return location; }
+
+			/** Returns the number of memory blocks allocated at this call site that have not been freed yet. */
+			public long getLiveCount() { return liveCount; }
+
+			/** Returns the total size of the memory blocks allocated at this call site that have not been freed yet. */
+			public long getLiveBytes() { return liveBytes; }
+
+			/** Returns the total number of allocations at this call site. */
+			public long getTotalCount() { return totalCount; }
+
+			/** Returns the total number of bytes allocated at this call site. */
+			public long getTotalBytes() { return totalBytes; }
+
+			/** Returns the average number of allocations per second at this call site, since the allocator was created. */
+			public double getAllocationRate() { return allocationRate; }
+
+			@Override
+			public String toString() {
+				return String.format("%s: %d live (%d bytes), %d total (%d bytes), %.1f allocs/s", location, liveCount, liveBytes, totalCount, totalBytes, allocationRate);
+			}
+		}
+
+	}
+
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.LWJGLUtil;
+
+import java.lang.ref.WeakReference;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.List;
+
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * A size-class slab allocator for small, off-heap memory blocks, such as struct buffers.
+ * <p/>
+ * Blocks are rounded up to one of the supported size classes (powers-of-two from {@value #MIN_BLOCK_SIZE} to {@value #MAX_BLOCK_SIZE} bytes) and
+ * are carved out of large slabs allocated with {@link MemoryUtil#memAllocator()}. Each thread keeps a small cache of free blocks per size class;
+ * blocks are moved between the thread caches and the shared pool in batches, so that the shared lock is rarely contended. Slabs are never returned
+ * to the system.
+ * <p/>
+ * The blocks cached by a thread that has terminated are returned to the shared pool before a new slab is allocated, or when any thread calls
+ * {@link #flushThreadCache}. Threads that are kept alive but stop using the pool, e.g. in a thread pool, can call {@link #flushThreadCache} to return
+ * their cached blocks immediately.
+ * <p/>
+ * Blocks allocated from the pool are aligned to their size class (up to the page size) and their content is not initialized. Every block must be
+ * released with {@link #poolFree}; it is safe to release a block from a different thread than the one that allocated it.
+ */
+public final class MemoryPool {
+
+	/** The smallest size class, in bytes. */
+	public static final int MIN_BLOCK_SIZE = 16;
+
+	/** The largest size class, in bytes. Larger allocations are forwarded to the current memory allocator. */
+	public static final int MAX_BLOCK_SIZE = 4096;
+
+	private static final int MIN_BLOCK_SHIFT = 4;
+
+	private static final int SIZE_CLASSES = 9; // 16, 32, 64, ..., 4096
+
+	private static final int SLAB_SIZE = 64 * 1024;
+
+	private static final int CACHE_SIZE = 64;
+	private static final int BATCH_SIZE = CACHE_SIZE / 2;
+
+	private static final SizeClass[] POOL = new SizeClass[SIZE_CLASSES];
+
+	/** The caches of all threads that have used the pool. Guarded by itself. */
+	private static final List<ThreadCache> THREAD_CACHES = new ArrayList<ThreadCache>();
+
+	private static final ThreadLocal<long[][]> CACHES = new ThreadLocal<long[][]>() {
+		@Override
+		protected long[][] initialValue() {
+			// The first element of each cache holds its current size.
+			long[][] caches = new long[SIZE_CLASSES][];
+			for ( int i = 0; i < SIZE_CLASSES; i++ )
+				caches[i] = new long[1 + CACHE_SIZE];
+
+			synchronized ( THREAD_CACHES ) {
+				THREAD_CACHES.add(new ThreadCache(Thread.currentThread(), caches));
+			}
+
+			return caches;
+		}
+	};
+
+	static {
+		for ( int i = 0; i < SIZE_CLASSES; i++ )
+			POOL[i] = new SizeClass(MIN_BLOCK_SIZE << i);
+	}
+
+	private MemoryPool() {
+	}
+
+	/**
+	 * Returns a new {@link ByteBuffer} with the given capacity, backed by a block allocated from the pool. The buffer must be released with
+	 * {@link #poolFree}.
+	 *
+	 * @param size the buffer capacity, in bytes
+	 *
+	 * @return the allocated buffer
+	 */
+	public static ByteBuffer poolAlloc(int size) {
+		return memByteBuffer(npoolAlloc(size), size);
+	}
+
+	/** Calloc version of {@link #poolAlloc}. */
+	public static ByteBuffer poolCalloc(int size) {
+		long address = npoolAlloc(size);
+		memSet(address, 0, size);
+		return memByteBuffer(address, size);
+	}
+
+	/**
+	 * Releases a buffer previously returned by {@link #poolAlloc} or {@link #poolCalloc}. The buffer must not be used after this call.
+	 *
+	 * @param buffer the buffer to release. The buffer capacity must not have been modified. If null, this method does nothing.
+	 */
+	public static void poolFree(ByteBuffer buffer) {
+		if ( buffer != null )
+			npoolFree(memAddress0(buffer), buffer.capacity());
+	}
+
+	/**
+	 * Unsafe version of {@link #poolAlloc}.
+	 *
+	 * @param size the allocation size, in bytes
+	 *
+	 * @return the address of the allocated block
+	 */
+	public static long npoolAlloc(int size) {
+		if ( MAX_BLOCK_SIZE < size ) {
+			long address = memAllocator().malloc(size);
+			if ( address == NULL )
+				throw new OutOfMemoryError("Failed to allocate native memory.");
+			return address;
+		}
+
+		int sc = getSizeClass(size);
+
+		long[] cache = CACHES.get()[sc];
+		if ( cache[0] == 0 && !POOL[sc].refill(cache, false) ) {
+			// Try to reuse the blocks cached by terminated threads before allocating a new slab
+			reclaimThreadCaches();
+			POOL[sc].refill(cache, true);
+		}
+
+		return cache[(int)cache[0]--];
+	}
+
+	/**
+	 * Unsafe version of {@link #poolFree}.
+	 *
+	 * @param address the address of the block to release
+	 * @param size    the size that was passed to {@link #npoolAlloc}
+	 */
+	public static void npoolFree(long address, int size) {
+		if ( LWJGLUtil.CHECKS && address == NULL )
+			throw new IllegalArgumentException();
+
+		if ( MAX_BLOCK_SIZE < size ) {
+			memAllocator().free(address);
+			return;
+		}
+
+		int sc = getSizeClass(size);
+
+		long[] cache = CACHES.get()[sc];
+		if ( cache[0] == CACHE_SIZE )
+			POOL[sc].drain(cache);
+
+		cache[(int)++cache[0]] = address;
+	}
+
+	/**
+	 * Returns the blocks cached by the current thread to the shared pool, so that they can be allocated by other threads. The blocks cached by threads
+	 * that have terminated are also returned.
+	 * <p/>
+	 * This method should be called by threads that have used the pool and are kept alive, but will not use the pool again for a long time.
+	 */
+	public static void flushThreadCache() {
+		flush(CACHES.get());
+		reclaimThreadCaches();
+	}
+
+	private static void flush(long[][] caches) {
+		for ( int i = 0; i < SIZE_CLASSES; i++ ) {
+			if ( caches[i][0] != 0 )
+				POOL[i].drainAll(caches[i]);
+		}
+	}
+
+	/** Returns the blocks cached by terminated threads to the shared pool. */
+	private static void reclaimThreadCaches() {
+		synchronized ( THREAD_CACHES ) {
+			for ( Iterator<ThreadCache> it = THREAD_CACHES.iterator(); it.hasNext(); ) {
+				ThreadCache threadCache = it.next();
+
+				// Thread termination happens-before isAlive() returning false, the caches are safe to access.
+				Thread thread = threadCache.thread.get();
+				if ( thread != null && thread.isAlive() )
+					continue;
+
+				flush(threadCache.caches);
+				it.remove();
+			}
+		}
+	}
+
+	private static int getSizeClass(int size) {
+		if ( size <= MIN_BLOCK_SIZE )
+			return 0;
+
+		// ceil(log2(size)) - MIN_BLOCK_SHIFT
+		return 32 - Integer.numberOfLeadingZeros(size - 1) - MIN_BLOCK_SHIFT;
+	}
+
+	/** The caches of a thread that has used the pool. The thread is weakly referenced, so that it can be collected after it terminates. */
+	private static final class ThreadCache {
+
+		final WeakReference<Thread> thread;
+		final long[][]              caches;
+
+		ThreadCache(Thread thread, long[][] caches) {
+			this.thread = new WeakReference<Thread>(thread);
+			this.caches = caches;
+		}
+
+	}
+
+	/** The shared free list of a single size class. */
+	private static final class SizeClass {
+
+		private final int blockSize;
+
+		private long[] free = new long[SLAB_SIZE / MIN_BLOCK_SIZE];
+		private int    count;
+
+		SizeClass(int blockSize) {
+			this.blockSize = blockSize;
+		}
+
+		/**
+		 * Moves a batch of free blocks to the specified (empty) thread cache.
+		 *
+		 * @param cache    the thread cache
+		 * @param allocate if true, a new slab is allocated if there are not enough free blocks
+		 *
+		 * @return false if there were not enough free blocks and {@code allocate} was false
+		 */
+		synchronized boolean refill(long[] cache, boolean allocate) {
+			if ( count < BATCH_SIZE ) {
+				if ( !allocate )
+					return false;
+
+				allocateSlab();
+			}
+
+			System.arraycopy(free, count - BATCH_SIZE, cache, 1, BATCH_SIZE);
+			count -= BATCH_SIZE;
+
+			cache[0] = BATCH_SIZE;
+			return true;
+		}
+
+		/** Moves a batch of free blocks from the specified (full) thread cache to the shared pool. */
+		synchronized void drain(long[] cache) {
+			ensureCapacity(count + BATCH_SIZE);
+
+			System.arraycopy(cache, 1 + CACHE_SIZE - BATCH_SIZE, free, count, BATCH_SIZE);
+			count += BATCH_SIZE;
+
+			cache[0] = CACHE_SIZE - BATCH_SIZE;
+		}
+
+		/** Moves all blocks from the specified thread cache to the shared pool. */
+		synchronized void drainAll(long[] cache) {
+			int blocks = (int)cache[0];
+			ensureCapacity(count + blocks);
+
+			System.arraycopy(cache, 1, free, count, blocks);
+			count += blocks;
+
+			cache[0] = 0;
+		}
+
+		private void allocateSlab() {
+			long slab = memAllocator().aligned_alloc(Math.min(blockSize, PAGE_SIZE), SLAB_SIZE);
+			if ( slab == NULL )
+				throw new OutOfMemoryError("Failed to allocate native memory.");
+
+			int blocks = SLAB_SIZE / blockSize;
+			ensureCapacity(count + blocks);
+
+			for ( int i = 0; i < blocks; i++ )
+				free[count++] = slab + i * blockSize;
+		}
+
+		private void ensureCapacity(int capacity) {
+			if ( capacity <= free.length )
+				return;
+
+			long[] resized = new long[Math.max(capacity, free.length << 1)];
+			System.arraycopy(free, 0, resized, 0, count);
+			free = resized;
+		}
+
+	}
+
+}
@@ -0,0 +1,347 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.BufferUtils;
+import org.lwjgl.LWJGLUtil;
+import org.lwjgl.PointerBuffer;
+
+import java.nio.*;
+
+import static org.lwjgl.Pointer.*;
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * An off-heap, frame-based, thread-local stack allocator. It is meant to be used for short-lived allocations, such as
+ * output parameters and small structs, that would otherwise require a new direct buffer on every call.
+ * <p/>
+ * Allocations are only valid until the enclosing frame is popped. Typical usage:
+ * <pre>
+ * MemoryStack stack = stackPush();
+ * try {
+ *     IntBuffer w = stack.mallocInt(1);
+ *     IntBuffer h = stack.mallocInt(1);
+ *     ...
+ * } finally {
+ *     stack.pop();
+ * }</pre>
+ * <p/>
+ * The stack memory is allocated once per thread and never grows. Its size, in kilobytes, can be configured with the
+ * {@code org.lwjgl.util.StackSize} system property (default: 64).
+ */
+public class MemoryStack {
+
+	private static final int DEFAULT_STACK_SIZE = LWJGLUtil.getPrivilegedInteger("org.lwjgl.util.StackSize", 64) * 1024;
+
+	private static final ThreadLocal<MemoryStack> STACKS = new ThreadLocal<MemoryStack>() {
+		@Override
+		protected MemoryStack initialValue() {
+			return new MemoryStack(DEFAULT_STACK_SIZE);
+		}
+	};
+
+	private final ByteBuffer buffer;
+	private final long       address;
+
+	private final int size;
+
+	private int pointer;
+
+	private int   frameIndex;
+	private int[] frames = new int[16];
+
+	/**
+	 * Creates a new {@link MemoryStack} with the specified size.
+	 *
+	 * @param size the maximum number of bytes that may be allocated on the stack
+	 */
+	public MemoryStack(int size) {
+		this.buffer = BufferUtils.createAlignedByteBufferPage(size);
+		this.address = memAddress(buffer);
+
+		this.size = size;
+		this.pointer = size;
+	}
+
+	/** Returns the thread-local {@link MemoryStack} instance. */
+	public static MemoryStack stackGet() {
+		return STACKS.get();
+	}
+
+	/** Calls {@link #push} on the thread-local {@link MemoryStack} instance and returns it. */
+	public static MemoryStack stackPush() {
+		return stackGet().push();
+	}
+
+	/** Calls {@link #pop} on the thread-local {@link MemoryStack} instance and returns it. */
+	public static MemoryStack stackPop() {
+		return stackGet().pop();
+	}
+
+	/** Stores the current stack pointer and pushes a new frame to the stack. */
+	public MemoryStack push() {
+		if ( frameIndex == frames.length ) {
+			int[] resized = new int[frames.length << 1];
+			System.arraycopy(frames, 0, resized, 0, frames.length);
+			frames = resized;
+		}
+
+		frames[frameIndex++] = pointer;
+		return this;
+	}
+
+	/** Pops the current frame and restores the stack pointer to the value it had before the matching {@link #push}. */
+	public MemoryStack pop() {
+		if ( LWJGLUtil.CHECKS && frameIndex == 0 )
+			throw new IllegalStateException("Stack underflow: pop() without a matching push()");
+
+		pointer = frames[--frameIndex];
+		return this;
+	}
+
+	/** Returns the number of frames currently pushed on the stack. */
+	public int getFrameIndex() {
+		return frameIndex;
+	}
+
+	/** Returns the address of the backing off-heap memory. The stack grows "downwards", so the bottom of the stack is at {@code address + size}. */
+	public long getAddress() {
+		return address;
+	}
+
+	/** Returns the size of the backing off-heap memory, in bytes. */
+	public int getSize() {
+		return size;
+	}
+
+	/** Returns the current stack pointer, as an offset from {@link #getAddress}. */
+	public int getPointer() {
+		return pointer;
+	}
+
+	/**
+	 * Sets the current stack pointer. This method is unsafe and should only be used to restore a value that was
+	 * previously returned by {@link #getPointer}.
+	 *
+	 * @param pointer the new stack pointer
+	 */
+	public void setPointer(int pointer) {
+		if ( LWJGLUtil.CHECKS && (pointer < 0 || size < pointer) )
+			throw new IllegalArgumentException("Invalid stack pointer");
+
+		this.pointer = pointer;
+	}
+
+	/**
+	 * Allocates a block of {@code size} bytes of memory on the stack. The content of the newly allocated block of memory is not initialized,
+	 * remaining with indeterminate values.
+	 *
+	 * @param alignment the required alignment. Must be a power-of-two value.
+	 * @param size      the allocation size
+	 *
+	 * @return the memory address on the stack for the requested allocation
+	 */
+	public long nmalloc(int alignment, int size) {
+		int newPointer = (pointer - size) & -alignment;
+
+		if ( newPointer < 0 || size < 0 )
+			throw new OutOfMemoryError("Out of stack space.");
+
+		pointer = newPointer;
+		return this.address + newPointer;
+	}
+
+	/** Unsafe version of {@link #calloc(int, int)}. */
+	public long ncalloc(int alignment, int num, int size) {
+		int bytes = num * size;
+		long address = nmalloc(alignment, bytes);
+		memSet(address, 0, bytes);
+		return address;
+	}
+
+	// -------------------------------------------------
+
+	/**
+	 * Allocates an aligned {@link ByteBuffer} on the stack.
+	 *
+	 * @param alignment the required buffer alignment
+	 * @param size      the number of elements in the buffer
+	 *
+	 * @return the allocated buffer
+	 */
+	public ByteBuffer malloc(int alignment, int size) {
+		return memByteBuffer(nmalloc(alignment, size), size);
+	}
+
+	/** Calloc version of {@link #malloc(int, int)}. */
+	public ByteBuffer calloc(int alignment, int num, int size) {
+		return memByteBuffer(ncalloc(alignment, num, size), num * size);
+	}
+
+	/** Pointer-aligned version of {@link #malloc(int, int)}. Use this method to allocate structs. */
+	public ByteBuffer malloc(int size) { return malloc(POINTER_SIZE, size); }
+
+	/** Calloc version of {@link #malloc(int)}. */
+	public ByteBuffer calloc(int size) { return calloc(POINTER_SIZE, size, 1); }
+
+	/** Short version of {@link #malloc(int)}. */
+	public ShortBuffer mallocShort(int size) { return memShortBuffer(nmalloc(2, size << 1), size); }
+
+	/** Short version of {@link #calloc(int)}. */
+	public ShortBuffer callocShort(int size) { return memShortBuffer(ncalloc(2, size, 2), size); }
+
+	/** Int version of {@link #malloc(int)}. */
+	public IntBuffer mallocInt(int size) { return memIntBuffer(nmalloc(4, size << 2), size); }
+
+	/** Int version of {@link #calloc(int)}. */
+	public IntBuffer callocInt(int size) { return memIntBuffer(ncalloc(4, size, 4), size); }
+
+	/** Long version of {@link #malloc(int)}. */
+	public LongBuffer mallocLong(int size) { return memLongBuffer(nmalloc(8, size << 3), size); }
+
+	/** Long version of {@link #calloc(int)}. */
+	public LongBuffer callocLong(int size) { return memLongBuffer(ncalloc(8, size, 8), size); }
+
+	/** Float version of {@link #malloc(int)}. */
+	public FloatBuffer mallocFloat(int size) { return memFloatBuffer(nmalloc(4, size << 2), size); }
+
+	/** Float version of {@link #calloc(int)}. */
+	public FloatBuffer callocFloat(int size) { return memFloatBuffer(ncalloc(4, size, 4), size); }
+
+	/** Double version of {@link #malloc(int)}. */
+	public DoubleBuffer mallocDouble(int size) { return memDoubleBuffer(nmalloc(8, size << 3), size); }
+
+	/** Double version of {@link #calloc(int)}. */
+	public DoubleBuffer callocDouble(int size) { return memDoubleBuffer(ncalloc(8, size, 8), size); }
+
+	/** Pointer version of {@link #malloc(int)}. */
+	public PointerBuffer mallocPointer(int size) { return memPointerBuffer(nmalloc(POINTER_SIZE, size << POINTER_SHIFT), size); }
+
+	/** Pointer version of {@link #calloc(int)}. */
+	public PointerBuffer callocPointer(int size) { return memPointerBuffer(ncalloc(POINTER_SIZE, size, POINTER_SIZE), size); }
+
+	/**
+	 * Encodes the specified text on the stack using ASCII encoding and returns a ByteBuffer that points to the encoded text, including a null-terminator.
+	 *
+	 * @param text the text to encode
+	 */
+	public ByteBuffer ASCII(CharSequence text) { return ASCII(text, true); }
+
+	/**
+	 * Encodes the specified text on the stack using ASCII encoding and returns a ByteBuffer that points to the encoded text.
+	 *
+	 * @param text           the text to encode
+	 * @param nullTerminated if true, a null-terminator is included at the end of the encoded text
+	 */
+	public ByteBuffer ASCII(CharSequence text, boolean nullTerminated) {
+		int length = text.length() + (nullTerminated ? 1 : 0);
+		long target = nmalloc(1, length);
+		memEncodeASCII(text, nullTerminated, target);
+		return memByteBuffer(target, length);
+	}
+
+	/**
+	 * Encodes the specified text on the stack using UTF8 encoding and returns a ByteBuffer that points to the encoded text, including a null-terminator.
+	 *
+	 * @param text the text to encode
+	 */
+	public ByteBuffer UTF8(CharSequence text) { return UTF8(text, true); }
+
+	/**
+	 * Encodes the specified text on the stack using UTF8 encoding and returns a ByteBuffer that points to the encoded text.
+	 *
+	 * @param text           the text to encode
+	 * @param nullTerminated if true, a null-terminator is included at the end of the encoded text
+	 */
+	public ByteBuffer UTF8(CharSequence text, boolean nullTerminated) {
+		int length = memLengthUTF8(text, nullTerminated);
+		long target = nmalloc(1, length);
+		memEncodeUTF8(text, nullTerminated, target);
+		return memByteBuffer(target, length);
+	}
+
+	/**
+	 * Encodes the specified text on the stack using UTF16 encoding and returns a ByteBuffer that points to the encoded text, including a null-terminator.
+	 *
+	 * @param text the text to encode
+	 */
+	public ByteBuffer UTF16(CharSequence text) { return UTF16(text, true); }
+
+	/**
+	 * Encodes the specified text on the stack using UTF16 encoding and returns a ByteBuffer that points to the encoded text.
+	 *
+	 * @param text           the text to encode
+	 * @param nullTerminated if true, a null-terminator is included at the end of the encoded text
+	 */
+	public ByteBuffer UTF16(CharSequence text, boolean nullTerminated) {
+		int length = (text.length() + (nullTerminated ? 1 : 0)) << 1;
+		long target = nmalloc(2, length);
+		memEncodeUTF16(text, nullTerminated, target);
+		return memByteBuffer(target, length);
+	}
+
+	// -------------------------------------------------
+
+	/** Thread-local version of {@link #malloc(int)}. */
+	public static ByteBuffer stackMalloc(int size) { return stackGet().malloc(size); }
+
+	/** Thread-local version of {@link #calloc(int)}. */
+	public static ByteBuffer stackCalloc(int size) { return stackGet().calloc(size); }
+
+	/** Thread-local version of {@link #mallocShort}. */
+	public static ShortBuffer stackMallocShort(int size) { return stackGet().mallocShort(size); }
+
+	/** Thread-local version of {@link #callocShort}. */
+	public static ShortBuffer stackCallocShort(int size) { return stackGet().callocShort(size); }
+
+	/** Thread-local version of {@link #mallocInt}. */
+	public static IntBuffer stackMallocInt(int size) { return stackGet().mallocInt(size); }
+
+	/** Thread-local version of {@link #callocInt}. */
+	public static IntBuffer stackCallocInt(int size) { return stackGet().callocInt(size); }
+
+	/** Thread-local version of {@link #mallocLong}. */
+	public static LongBuffer stackMallocLong(int size) { return stackGet().mallocLong(size); }
+
+	/** Thread-local version of {@link #callocLong}. */
+	public static LongBuffer stackCallocLong(int size) { return stackGet().callocLong(size); }
+
+	/** Thread-local version of {@link #mallocFloat}. */
+	public static FloatBuffer stackMallocFloat(int size) { return stackGet().mallocFloat(size); }
+
+	/** Thread-local version of {@link #callocFloat}. */
+	public static FloatBuffer stackCallocFloat(int size) { return stackGet().callocFloat(size); }
+
+	/** Thread-local version of {@link #mallocDouble}. */
+	public static DoubleBuffer stackMallocDouble(int size) { return stackGet().mallocDouble(size); }
+
+	/** Thread-local version of {@link #callocDouble}. */
+	public static DoubleBuffer stackCallocDouble(int size) { return stackGet().callocDouble(size); }
+
+	/** Thread-local version of {@link #mallocPointer}. */
+	public static PointerBuffer stackMallocPointer(int size) { return stackGet().mallocPointer(size); }
+
+	/** Thread-local version of {@link #callocPointer}. */
+	public static PointerBuffer stackCallocPointer(int size) { return stackGet().callocPointer(size); }
+
+	/** Thread-local version of {@link #ASCII(CharSequence)}. */
+	public static ByteBuffer stackASCII(CharSequence text) { return stackGet().ASCII(text); }
+
+	/** Thread-local version of {@link #ASCII(CharSequence, boolean)}. */
+	public static ByteBuffer stackASCII(CharSequence text, boolean nullTerminated) { return stackGet().ASCII(text, nullTerminated); }
+
+	/** Thread-local version of {@link #UTF8(CharSequence)}. */
+	public static ByteBuffer stackUTF8(CharSequence text) { return stackGet().UTF8(text); }
+
+	/** Thread-local version of {@link #UTF8(CharSequence, boolean)}. */
+	public static ByteBuffer stackUTF8(CharSequence text, boolean nullTerminated) { return stackGet().UTF8(text, nullTerminated); }
+
+	/** Thread-local version of {@link #UTF16(CharSequence)}. */
+	public static ByteBuffer stackUTF16(CharSequence text) { return stackGet().UTF16(text); }
+
+	/** Thread-local version of {@link #UTF16(CharSequence, boolean)}. */
+	public static ByteBuffer stackUTF16(CharSequence text, boolean nullTerminated) { return stackGet().UTF16(text, nullTerminated); }
+
+}
@@ -10,10 +10,14 @@ import org.lwjgl.PointerBuffer;
 import org.lwjgl.Sys;
 import org.lwjgl.system.MemoryAccess.MemoryAccessor;
 
+import java.io.File;
+import java.io.IOException;
 import java.nio.*;
 import java.nio.charset.*;
 
 import static org.lwjgl.Pointer.*;
+import static org.lwjgl.system.Checks.*;
+import static org.lwjgl.system.MathUtil.*;
 
 /**
  * This class provides functionality for managing native memory.
@@ -33,9 +37,49 @@ public final class MemoryUtil {
 
 	private static final MemoryAccessor ACCESSOR;
 
+	private static final MemoryAllocator ALLOCATOR;
+
+	// Encoders are not thread-safe, but they can be reused.
+	private static final ThreadLocal<CharsetEncoder> ENCODER = new ThreadLocal<CharsetEncoder>();
+
 	/** The memory page size, in bytes. This value is always a power-of-two. */
 	public static final int PAGE_SIZE;
 
+	/** The L1 data cache line size, in bytes. Defaults to 64 if it cannot be detected. */
+	public static final int CACHE_LINE_SIZE;
+
+	/** {@link #memAllocLarge} flag: Requests transparent huge pages for the allocation (madvise(MADV_HUGEPAGE) on Linux). */
+	public static final int MEM_LARGE_PAGES_TRANSPARENT = 1;
+
+	/**
+	 * {@link #memAllocLarge} flag: Requests explicit huge pages for the allocation (MAP_HUGETLB on Linux, MEM_LARGE_PAGES on Windows). Falls back to
+	 * transparent huge pages if the system has no huge pages reserved or the process lacks the required privileges.
+	 */
+	public static final int MEM_LARGE_PAGES_EXPLICIT = 2;
+
+	/** {@link #memAllocLarge} NUMA node value: No NUMA binding is requested. */
+	public static final int MEM_NUMA_NODE_ANY = -1;
+
+	/**
+	 * Copies of at least this many bytes bypass the CPU caches, using non-temporal stores where available. Defaults to the size of the last-level
+	 * cache (8MB if it cannot be detected) and can be overridden with the {@code org.lwjgl.util.StreamingCopyThreshold} system property, in KB.
+	 */
+	public static final long MEM_COPY_STREAMING_THRESHOLD;
+
+	/** {@link #memMapFile} mode: The file is mapped read-only. Writing to the mapped memory is not allowed. */
+	public static final int MEM_MAP_READ_ONLY = 0;
+
+	/** {@link #memMapFile} mode: The file is mapped copy-on-write. Changes to the mapped memory are private and never written back to the file. */
+	public static final int MEM_MAP_COPY_ON_WRITE = 1;
+
+	/** {@link #memAdvise} advice. */
+	public static final int
+		MEM_ADVICE_NORMAL     = 0,
+		MEM_ADVICE_SEQUENTIAL = 1,
+		MEM_ADVICE_RANDOM     = 2,
+		MEM_ADVICE_WILLNEED   = 3,
+		MEM_ADVICE_DONTNEED   = 4;
+
 	static {
 		Sys.touch();
 
@@ -45,8 +89,20 @@ public final class MemoryUtil {
 
 		ACCESSOR = MemoryAccess.getInstance();
 		PAGE_SIZE = ACCESSOR.getPageSize();
+		CACHE_LINE_SIZE = ACCESSOR.getCacheLineSize();
+
+		Integer streamingThreshold = LWJGLUtil.getPrivilegedInteger("org.lwjgl.util.StreamingCopyThreshold");
+		if ( streamingThreshold != null )
+			MEM_COPY_STREAMING_THRESHOLD = streamingThreshold * 1024L;
+		else {
+			int llcSize = nMemLastLevelCacheSize();
+			MEM_COPY_STREAMING_THRESHOLD = llcSize == 0 ? 8 * 1024 * 1024 : llcSize;
+		}
+
+		ALLOCATOR = MemoryManage.getInstance();
 
 		LWJGLUtil.log("MemoryUtil MemoryAccessor: " + ACCESSOR.getClass().getSimpleName());
+		LWJGLUtil.log("MemoryUtil MemoryAllocator: " + ALLOCATOR.getClass().getSimpleName());
 	}
 
 	private MemoryUtil() {
@@ -183,9 +239,7 @@ public final class MemoryUtil {
 		if ( address == NULL )
 			return null;
 
-		ByteBuffer infPointer = ACCESSOR.newByteBuffer(address, Integer.MAX_VALUE);
-
-		return memSetupBuffer(infPointer, address, memStrLen1(infPointer, 0));
+		return ACCESSOR.newByteBuffer(address, memStrLen1(address));
 	}
 
 	/**
@@ -204,9 +258,7 @@ public final class MemoryUtil {
 		if ( address == NULL )
 			return null;
 
-		ByteBuffer infPointer = ACCESSOR.newByteBuffer(address, Integer.MAX_VALUE);
-
-		return memSetupBuffer(infPointer, address, memStrLen2(infPointer, 0));
+		return ACCESSOR.newByteBuffer(address, memStrLen2(address));
 	}
 
 	/**
@@ -383,6 +435,274 @@ public final class MemoryUtil {
 		return ACCESSOR.setupBuffer(buffer, address, capacity);
 	}
 
+	// --- [ Native heap ] ---
+
+	/**
+	 * Returns the {@link MemoryAllocator} used by the {@code memAlloc} family of methods. The allocator is selected with the
+	 * {@code org.lwjgl.util.Allocator} system property. Its methods may be used directly for address-based allocations.
+	 *
+	 * @return the memory allocator
+	 */
+	public static MemoryAllocator memAllocator() {
+		return ALLOCATOR;
+	}
+
+	/**
+	 * Allocates {@code size} bytes of memory from the native heap, using the standard C {@code malloc} function. The content of the newly
+	 * allocated block of memory is not initialized. The returned buffer must be explicitly freed with {@link #memFree}.
+	 *
+	 * @param size the size of the memory block, in bytes
+	 *
+	 * @return the allocated buffer
+	 *
+	 * @throws OutOfMemoryError if the allocation failed
+	 */
+	public static ByteBuffer memAlloc(int size) {
+		return memByteBuffer(checkAlloc(ALLOCATOR.malloc(size)), size);
+	}
+
+	/**
+	 * Allocates a block of memory for an array of {@code num} elements, each of them {@code size} bytes long, using the standard C
+	 * {@code calloc} function. All bytes of the memory block are initialized to zero. The returned buffer must be explicitly freed
+	 * with {@link #memFree}.
+	 *
+	 * @param num  the number of elements to allocate
+	 * @param size the size of each element
+	 *
+	 * @return the allocated buffer
+	 *
+	 * @throws IllegalArgumentException if {@code num} or {@code size} is negative, or if the total size does not fit in a buffer
+	 * @throws OutOfMemoryError         if the allocation failed
+	 */
+	public static ByteBuffer memCalloc(int num, int size) {
+		// Checked before allocating, the block would be leaked otherwise.
+		if ( num < 0 || size < 0 || (size != 0 && Integer.MAX_VALUE / size < num) )
+			throw new IllegalArgumentException("Invalid allocation size: " + num + " x " + size);
+
+		return memByteBuffer(checkAlloc(ALLOCATOR.calloc(num, size)), num * size);
+	}
+
+	/**
+	 * Changes the size of a memory block previously allocated with {@link #memAlloc}, {@link #memCalloc} or {@link #memRealloc}, using the
+	 * standard C {@code realloc} function. The memory block may be moved to a new location, in which case the old buffer instance must not
+	 * be used anymore.
+	 *
+	 * @param buffer the buffer to resize. May be null, in which case this method behaves like {@link #memAlloc}.
+	 * @param size   the new size of the memory block, in bytes. If zero, the memory block is freed and null is returned.
+	 *
+	 * @return the resized buffer, or null if {@code size} is zero
+	 *
+	 * @throws OutOfMemoryError if the allocation failed. The original memory block is not freed in that case.
+	 */
+	public static ByteBuffer memRealloc(ByteBuffer buffer, int size) {
+		// realloc(ptr, 0) may free the block and return NULL, which is indistinguishable from a failure. The block would then be freed twice.
+		if ( size == 0 ) {
+			memFree(buffer);
+			return null;
+		}
+
+		return memByteBuffer(checkAlloc(ALLOCATOR.realloc(memAddress0Safe(buffer), size)), size);
+	}
+
+	/**
+	 * Allocates {@code size} bytes of memory from the native heap, aligned to {@code alignment} bytes. Unlike
+	 * {@link org.lwjgl.BufferUtils#createAlignedByteBuffer}, no memory is wasted for padding. The returned buffer must be explicitly
+	 * freed with {@link #memAlignedFree}.
+	 *
+	 * @param alignment the required alignment. Must be a power-of-two value and a multiple of {@code sizeof(void *)}.
+	 * @param size      the size of the memory block, in bytes
+	 *
+	 * @return the allocated buffer
+	 *
+	 * @throws OutOfMemoryError if the allocation failed
+	 */
+	public static ByteBuffer memAlignedAlloc(int alignment, int size) {
+		if ( LWJGLUtil.CHECKS && (alignment < POINTER_SIZE || !mathIsPoT(alignment)) )
+			throw new IllegalArgumentException("Invalid alignment: " + alignment);
+
+		return memByteBuffer(checkAlloc(ALLOCATOR.aligned_alloc(alignment, size)), size);
+	}
+
+	/**
+	 * Frees a memory block previously allocated with {@link #memAlloc}, {@link #memCalloc} or {@link #memRealloc}.
+	 *
+	 * @param buffer the buffer to free. If null, this method does nothing.
+	 */
+	public static void memFree(Buffer buffer) {
+		if ( buffer != null )
+			ALLOCATOR.free(memAddress0(buffer));
+	}
+
+	/**
+	 * Frees a memory block previously allocated with {@link #memAlignedAlloc}.
+	 *
+	 * @param buffer the buffer to free. If null, this method does nothing.
+	 */
+	public static void memAlignedFree(Buffer buffer) {
+		if ( buffer != null )
+			ALLOCATOR.aligned_free(memAddress0(buffer));
+	}
+
+	private static long checkAlloc(long address) {
+		if ( address == NULL )
+			throw new OutOfMemoryError("Failed to allocate native memory.");
+
+		return address;
+	}
+
+	/**
+	 * Allocates a large block of memory directly from the operating system (mmap on Linux/Mac OS X, VirtualAlloc on Windows), optionally backed by huge
+	 * pages and bound to a NUMA node. This is meant for big, long-lived buffers, such as vertex, texture or CL staging buffers, for which TLB misses
+	 * become significant. The returned memory is page-aligned and zero-initialized. The buffer must be explicitly freed with {@link #memFreeLarge}.
+	 * <p/>
+	 * Huge pages and NUMA binding are hints; the allocation succeeds without them if they are not available. NUMA binding is supported on Linux
+	 * and Windows.
+	 *
+	 * @param size  the size of the memory block, in bytes
+	 * @param flags the allocation flags. Zero or one of:<br>{@link #MEM_LARGE_PAGES_TRANSPARENT}, {@link #MEM_LARGE_PAGES_EXPLICIT}
+	 * @param node  the NUMA node on which the memory should be allocated, or {@link #MEM_NUMA_NODE_ANY}
+	 *
+	 * @return the allocated buffer
+	 *
+	 * @throws OutOfMemoryError if the allocation failed
+	 */
+	public static ByteBuffer memAllocLarge(int size, int flags, int node) {
+		return memByteBuffer(checkAlloc(nMemAllocLarge(size, flags, node)), size);
+	}
+
+	/**
+	 * Frees a memory block previously allocated with {@link #memAllocLarge}.
+	 *
+	 * @param buffer the buffer to free. Its capacity must not have been modified. If null, this method does nothing.
+	 * @param flags  the flags that were passed to {@link #memAllocLarge}
+	 */
+	public static void memFreeLarge(ByteBuffer buffer, int flags) {
+		if ( buffer != null )
+			nMemFreeLarge(memAddress0(buffer), buffer.capacity(), flags);
+	}
+
+	// --- [ Memory-mapped files ] ---
+
+	/**
+	 * Maps the specified file into memory and returns a direct ByteBuffer that points to the file contents. No data is copied; pages are loaded
+	 * on demand by the operating system. The returned buffer can be passed directly to functions like {@code glBufferData}, {@code glTexSubImage2D},
+	 * {@code alBufferData} or {@code clEnqueueWriteBuffer}.
+	 * <p/>
+	 * The mapping must be explicitly released with {@link #memUnmapFile}. The buffer, and any buffers derived from it, must not be used after that.
+	 *
+	 * @param path the file path
+	 * @param mode the mapping mode. One of:<br>{@link #MEM_MAP_READ_ONLY}, {@link #MEM_MAP_COPY_ON_WRITE}
+	 *
+	 * @return the mapped buffer. If {@code mode} is {@link #MEM_MAP_READ_ONLY}, the buffer is read-only.
+	 *
+	 * @throws IOException if the file does not exist, is larger than 2GB or cannot be mapped
+	 */
+	public static ByteBuffer memMapFile(String path, int mode) throws IOException {
+		long size = new File(path).length();
+		if ( Integer.MAX_VALUE < size )
+			throw new IOException("The file is too large to be mapped to a ByteBuffer, use memMapFile(String, long, int) instead: " + path);
+
+		long address = memMapFile(path, size, mode);
+
+		ByteBuffer buffer = memByteBuffer(address, (int)size);
+		return mode == MEM_MAP_READ_ONLY
+		       ? buffer.asReadOnlyBuffer().order(ByteOrder.nativeOrder())
+		       : buffer;
+	}
+
+	/**
+	 * Address version of {@link #memMapFile(String, int)}. Can be used to map files larger than 2GB.
+	 *
+	 * @param path the file path
+	 * @param size the number of bytes to map, starting at the beginning of the file. Must be greater than zero and not larger than the file size.
+	 * @param mode the mapping mode. One of:<br>{@link #MEM_MAP_READ_ONLY}, {@link #MEM_MAP_COPY_ON_WRITE}
+	 *
+	 * @return the address of the mapped memory. It must be released with {@link #nMemUnmapFile}.
+	 *
+	 * @throws IOException if the file cannot be mapped
+	 */
+	public static long memMapFile(String path, long size, int mode) throws IOException {
+		if ( size <= 0L )
+			throw new IOException("The file does not exist or is empty: " + path);
+
+		ByteBuffer pathEncoded = LWJGLUtil.getPlatform() == LWJGLUtil.Platform.WINDOWS ? memEncodeUTF16(path) : memEncodeUTF8(path);
+
+		long address = nMemMapFile(memAddress(pathEncoded), size, mode);
+		if ( address == NULL )
+			throw new IOException("Failed to map file: " + path);
+
+		return address;
+	}
+
+	/**
+	 * Releases a file mapping created with {@link #memMapFile(String, int)}.
+	 *
+	 * @param buffer the mapped buffer. Its capacity must not have been modified. If null, this method does nothing.
+	 */
+	public static void memUnmapFile(ByteBuffer buffer) {
+		if ( buffer != null )
+			nMemUnmapFile(memAddress0(buffer), buffer.capacity());
+	}
+
+	/**
+	 * Gives the operating system a hint about the expected access pattern of a range of mapped memory. This is useful for mapped files: use
+	 * {@link #MEM_ADVICE_SEQUENTIAL} before streaming through a file, {@link #MEM_ADVICE_WILLNEED} to start reading ahead asynchronously and
+	 * {@link #MEM_ADVICE_DONTNEED} to drop pages that will not be accessed again.
+	 * <p/>
+	 * On Windows, only {@link #MEM_ADVICE_WILLNEED} has an effect (Windows 8 or newer).
+	 *
+	 * @param buffer the memory range, from the buffer's current position to its limit. The position should be page-aligned.
+	 * @param advice the advice. One of:<br>{@link #MEM_ADVICE_NORMAL}, {@link #MEM_ADVICE_SEQUENTIAL}, {@link #MEM_ADVICE_RANDOM},
+	 *               {@link #MEM_ADVICE_WILLNEED}, {@link #MEM_ADVICE_DONTNEED}
+	 *
+	 * @return 0 on success, -1 on failure
+	 */
+	public static int memAdvise(ByteBuffer buffer, int advice) {
+		return nMemAdvise(memAddress(buffer), buffer.remaining(), advice);
+	}
+
+	// Maps a file to memory. The path must be a null-terminated string, UTF-16 encoded on Windows and UTF-8 encoded on other platforms.
+	static native long nMemMapFile(long path, long size, int mode);
+
+	// Unsafe version of memUnmapFile.
+	public static native void nMemUnmapFile(long address, long size);
+
+	// Unsafe version of memAdvise.
+	public static native int nMemAdvise(long address, long size, int advice);
+
+	// Returns the system page size, or 0 if it cannot be detected.
+	static native int nMemPageSize();
+
+	// Returns the L1 data cache line size, or 0 if it cannot be detected.
+	static native int nMemCacheLineSize();
+
+	// Returns the last-level cache size, or 0 if it cannot be detected.
+	static native int nMemLastLevelCacheSize();
+
+	// Unsafe version of memAllocLarge.
+	public static native long nMemAllocLarge(long size, int flags, int node);
+
+	// Unsafe version of memFreeLarge. The size and flags must match the values passed to nMemAllocLarge.
+	public static native void nMemFreeLarge(long address, long size, int flags);
+
+	// The standard C malloc function. Bypasses the current allocator.
+	public static native long nMemAlloc(long size);
+
+	// The standard C calloc function. Bypasses the current allocator.
+	public static native long nMemCalloc(long num, long size);
+
+	// The standard C realloc function. Bypasses the current allocator.
+	public static native long nMemRealloc(long ptr, long size);
+
+	// posix_memalign or _aligned_malloc, depending on the platform. Bypasses the current allocator.
+	public static native long nMemAlignedAlloc(long alignment, long size);
+
+	// The standard C free function. Bypasses the current allocator.
+	public static native void nMemFree(long ptr);
+
+	// free or _aligned_free, depending on the platform. Bypasses the current allocator.
+	public static native void nMemAlignedFree(long ptr);
+
 	// --- [ Direct memory access ] ---
 
 	/**
@@ -392,25 +712,84 @@ public final class MemoryUtil {
 	 * @param value the value to set (memSet will convert it to unsigned byte)
 	 * @param bytes the number of bytes to set
 	 */
-	public static void memSet(long ptr, int value, int bytes) {
-		if ( LWJGLUtil.DEBUG && ptr == NULL )
+	public static void memSet(long ptr, int value, long bytes) {
+		if ( LWJGLUtil.DEBUG && (ptr == NULL || bytes < 0) )
 			throw new IllegalArgumentException();
 
 		ACCESSOR.memSet(ptr, value, bytes);
 	}
 
 	/**
-	 * Sets all bytes in a given block of memory to a copy of another block.
+	 * Sets all bytes in a given block of memory to a copy of another block. The two blocks must not overlap.
+	 * <p/>
+	 * Small blocks are copied without a JNI transition, when sun.misc.Unsafe is available. Blocks of at least
+	 * {@link #MEM_COPY_STREAMING_THRESHOLD} bytes are copied with non-temporal stores, so that the copy does not evict the cache contents.
 	 *
 	 * @param src   the source memory address
 	 * @param dst   the destination memory address
 	 * @param bytes the number of bytes to copy
 	 */
-	public static void memCopy(long src, long dst, int bytes) {
+	public static void memCopy(long src, long dst, long bytes) {
 		if ( LWJGLUtil.DEBUG && (src == NULL || dst == NULL || bytes < 0) )
 			throw new IllegalArgumentException();
 
-		ACCESSOR.memCopy(src, dst, bytes);
+		if ( MEM_COPY_STREAMING_THRESHOLD <= bytes )
+			nMemCopyStreaming(dst, src, bytes);
+		else
+			ACCESSOR.memCopy(src, dst, bytes);
+	}
+
+	/**
+	 * Fills a block of memory with a 2-byte pattern.
+	 *
+	 * @param ptr   the starting memory address, must be aligned to 2 bytes
+	 * @param value the value to set
+	 * @param count the number of values to set
+	 */
+	public static void memFillShort(long ptr, short value, long count) {
+		memFill(ptr, value, 2, count);
+	}
+
+	/**
+	 * Fills a block of memory with a 4-byte pattern.
+	 *
+	 * @param ptr   the starting memory address, must be aligned to 4 bytes
+	 * @param value the value to set
+	 * @param count the number of values to set
+	 */
+	public static void memFillInt(long ptr, int value, long count) {
+		memFill(ptr, value, 4, count);
+	}
+
+	/**
+	 * Fills a block of memory with an 8-byte pattern.
+	 *
+	 * @param ptr   the starting memory address, must be aligned to 8 bytes
+	 * @param value the value to set
+	 * @param count the number of values to set
+	 */
+	public static void memFillLong(long ptr, long value, long count) {
+		memFill(ptr, value, 8, count);
+	}
+
+	/** Float version of {@link #memFillInt}. Useful for initializing vertex attributes to a constant value. */
+	public static void memFillFloat(long ptr, float value, long count) {
+		memFill(ptr, Float.floatToRawIntBits(value), 4, count);
+	}
+
+	/** Double version of {@link #memFillLong}. */
+	public static void memFillDouble(long ptr, double value, long count) {
+		memFill(ptr, Double.doubleToRawLongBits(value), 8, count);
+	}
+
+	private static void memFill(long ptr, long pattern, int patternSize, long count) {
+		if ( LWJGLUtil.DEBUG && (ptr == NULL || count < 0) )
+			throw new IllegalArgumentException();
+
+		if ( LWJGLUtil.CHECKS && (ptr & (patternSize - 1)) != 0 )
+			throw new IllegalArgumentException("The memory address must be aligned to " + patternSize + " bytes.");
+
+		ACCESSOR.memFill(ptr, pattern, patternSize, count);
 	}
 
 	public static byte memGetByte(long ptr) {
@@ -528,6 +907,18 @@ public final class MemoryUtil {
 	// The standard C memcpy function
 	static native void nMemCopy(long dst, long src, long bytes);
 
+	// memcpy with non-temporal stores, for blocks larger than the last-level cache
+	static native void nMemCopyStreaming(long dst, long src, long bytes);
+
+	// Fills count elements of patternSize (2, 4 or 8) bytes with the pattern value
+	static native void nMemFill(long ptr, long pattern, int patternSize, long count);
+
+	// The standard C strlen function
+	static native long nMemStrLen1(long address);
+
+	// Returns the number of 2-byte characters before the first 2-byte \0 (wcslen on Windows)
+	static native long nMemStrLen2(long address);
+
 	// Primitive getters
 
 	static native byte nMemGetByte(long ptr);
@@ -594,14 +985,46 @@ public final class MemoryUtil {
 			return null;
 
 		ByteBuffer buffer = BufferUtils.createByteBuffer(text.length() + (nullTerminated ? 1 : 0));
+		memEncodeASCII(text, nullTerminated, memAddress0(buffer));
+		return buffer;
+	}
 
-		for ( int i = 0; i < text.length(); i++ )
-			buffer.put(i, (byte)text.charAt(i));
+	/**
+	 * Encodes and optionally null-terminates the specified text using ASCII encoding. The encoded text is stored in the specified {@link ByteBuffer},
+	 * starting at its current position. The current position is not modified by this operation.
+	 *
+	 * @param text           the text to encode
+	 * @param nullTerminated if true, the text will be terminated with a '\0'.
+	 * @param target         the buffer in which to store the encoded text. It must have enough remaining space for the encoded text.
+	 *
+	 * @return the number of bytes written, including the null-terminator
+	 */
+	public static int memEncodeASCII(CharSequence text, boolean nullTerminated, ByteBuffer target) {
+		if ( LWJGLUtil.CHECKS )
+			checkBuffer(target, text.length() + (nullTerminated ? 1 : 0));
+
+		return memEncodeASCII(text, nullTerminated, memAddress(target));
+	}
+
+	/**
+	 * Unsafe version of {@link #memEncodeASCII(CharSequence, boolean, ByteBuffer)}. The memory at {@code target} must be large enough to store
+	 * {@code text.length()} bytes, plus the null-terminator.
+	 *
+	 * @param text           the text to encode
+	 * @param nullTerminated if true, the text will be terminated with a '\0'.
+	 * @param target         the address at which to store the encoded text
+	 *
+	 * @return the number of bytes written, including the null-terminator
+	 */
+	public static int memEncodeASCII(CharSequence text, boolean nullTerminated, long target) {
+		int length = text.length();
+		for ( int i = 0; i < length; i++ )
+			ACCESSOR.memPutByte(target + i, (byte)text.charAt(i));
 
 		if ( nullTerminated )
-			buffer.put(text.length(), (byte)0);
+			ACCESSOR.memPutByte(target + length++, (byte)0);
 
-		return buffer;
+		return length;
 	}
 
 	/**
@@ -626,7 +1049,112 @@ public final class MemoryUtil {
 	 * @return the encoded text or null
 	 */
 	public static ByteBuffer memEncodeUTF8(CharSequence text, boolean nullTerminated) {
-		return memEncode(text, UTF8, nullTerminated);
+		if ( text == null )
+			return null;
+
+		ByteBuffer buffer = BufferUtils.createByteBuffer(memLengthUTF8(text, nullTerminated));
+		memEncodeUTF8(text, nullTerminated, memAddress0(buffer));
+		return buffer;
+	}
+
+	/**
+	 * Encodes and optionally null-terminates the specified text using UTF-8 encoding. The encoded text is stored in the specified {@link ByteBuffer},
+	 * starting at its current position. The current position is not modified by this operation.
+	 *
+	 * @param text           the text to encode
+	 * @param nullTerminated if true, the text will be terminated with a '\0'.
+	 * @param target         the buffer in which to store the encoded text. It must have enough remaining space for the encoded text, see
+	 *                       {@link #memLengthUTF8}.
+	 *
+	 * @return the number of bytes written, including the null-terminator
+	 */
+	public static int memEncodeUTF8(CharSequence text, boolean nullTerminated, ByteBuffer target) {
+		if ( LWJGLUtil.CHECKS )
+			checkBuffer(target, memLengthUTF8(text, nullTerminated));
+
+		return memEncodeUTF8(text, nullTerminated, memAddress(target));
+	}
+
+	/**
+	 * Unsafe version of {@link #memEncodeUTF8(CharSequence, boolean, ByteBuffer)}. The memory at {@code target} must be large enough to store
+	 * {@link #memLengthUTF8} bytes.
+	 * <p/>
+	 * Unpaired surrogate characters are encoded as '?'.
+	 *
+	 * @param text           the text to encode
+	 * @param nullTerminated if true, the text will be terminated with a '\0'.
+	 * @param target         the address at which to store the encoded text
+	 *
+	 * @return the number of bytes written, including the null-terminator
+	 */
+	public static int memEncodeUTF8(CharSequence text, boolean nullTerminated, long target) {
+		int length = text.length();
+
+		// ASCII fast path, most strings passed to native APIs end here
+		int i = 0;
+		for ( ; i < length; i++ ) {
+			char c = text.charAt(i);
+			if ( 0x80 <= c )
+				break;
+			ACCESSOR.memPutByte(target + i, (byte)c);
+		}
+
+		long p = target + i;
+		for ( ; i < length; i++ ) {
+			char c = text.charAt(i);
+			if ( c < 0x80 )
+				ACCESSOR.memPutByte(p++, (byte)c);
+			else if ( c < 0x800 ) {
+				ACCESSOR.memPutByte(p++, (byte)(0xC0 | (c >> 6)));
+				ACCESSOR.memPutByte(p++, (byte)(0x80 | (c & 0x3F)));
+			} else if ( c < Character.MIN_SURROGATE || Character.MAX_SURROGATE < c ) {
+				ACCESSOR.memPutByte(p++, (byte)(0xE0 | (c >> 12)));
+				ACCESSOR.memPutByte(p++, (byte)(0x80 | ((c >> 6) & 0x3F)));
+				ACCESSOR.memPutByte(p++, (byte)(0x80 | (c & 0x3F)));
+			} else if ( Character.isHighSurrogate(c) && i + 1 < length && Character.isLowSurrogate(text.charAt(i + 1)) ) {
+				int cp = Character.toCodePoint(c, text.charAt(++i));
+				ACCESSOR.memPutByte(p++, (byte)(0xF0 | (cp >> 18)));
+				ACCESSOR.memPutByte(p++, (byte)(0x80 | ((cp >> 12) & 0x3F)));
+				ACCESSOR.memPutByte(p++, (byte)(0x80 | ((cp >> 6) & 0x3F)));
+				ACCESSOR.memPutByte(p++, (byte)(0x80 | (cp & 0x3F)));
+			} else
+				ACCESSOR.memPutByte(p++, (byte)'?');
+		}
+
+		if ( nullTerminated )
+			ACCESSOR.memPutByte(p++, (byte)0);
+
+		return (int)(p - target);
+	}
+
+	/**
+	 * Returns the number of bytes required to encode the specified text using UTF-8 encoding.
+	 *
+	 * @param text           the text to encode
+	 * @param nullTerminated if true, the null-terminator is included in the returned length
+	 *
+	 * @return the encoded text length, in bytes
+	 */
+	public static int memLengthUTF8(CharSequence text, boolean nullTerminated) {
+		int length = text.length();
+		int bytes = length + (nullTerminated ? 1 : 0);
+
+		for ( int i = 0; i < length; i++ ) {
+			char c = text.charAt(i);
+			if ( c < 0x80 )
+				continue;
+
+			if ( c < 0x800 )
+				bytes += 1;
+			else if ( c < Character.MIN_SURROGATE || Character.MAX_SURROGATE < c )
+				bytes += 2;
+			else if ( Character.isHighSurrogate(c) && i + 1 < length && Character.isLowSurrogate(text.charAt(i + 1)) ) {
+				bytes += 2; // 4 bytes for 2 chars
+				i++;
+			}
+		}
+
+		return bytes;
 	}
 
 	/**
@@ -655,26 +1183,46 @@ public final class MemoryUtil {
 			return null;
 
 		ByteBuffer buffer = BufferUtils.createByteBuffer((text.length() + (nullTerminated ? 1 : 0)) << 1);
+		memEncodeUTF16(text, nullTerminated, memAddress0(buffer));
+		return buffer;
+	}
 
-		memEncodeUTF16(text, nullTerminated, buffer);
+	/**
+	 * Encodes and optionally null-terminates the given text using UTF-16 encoding. The encoded text is stored in the given {@link ByteBuffer}, starting at
+	 * its current position. The current position is not modified by this operation.
+	 *
+	 * @param text           the text to encode
+	 * @param nullTerminated if true, the text will be terminated with a '\0'.
+	 * @param target         the buffer in which to store the encoded text. It must have enough remaining space for the encoded text.
+	 *
+	 * @return the number of bytes written, including the null-terminator
+	 */
+	public static int memEncodeUTF16(CharSequence text, boolean nullTerminated, ByteBuffer target) {
+		if ( LWJGLUtil.CHECKS )
+			checkBuffer(target, (text.length() + (nullTerminated ? 1 : 0)) << 1);
 
-		return buffer;
+		return memEncodeUTF16(text, nullTerminated, memAddress(target));
 	}
 
 	/**
-	 * Encodes and optionally null-terminates the given text using UTF-16 encoding. The encoded text is stored in the given {@link ByteBuffer}. The
-	 * {@code target} buffer is assumed to have enough remaining space to store the encoded text.
+	 * Unsafe version of {@link #memEncodeUTF16(CharSequence, boolean, ByteBuffer)}. The memory at {@code target} must be large enough to store
+	 * {@code text.length()} characters, plus the null-terminator.
 	 *
 	 * @param text           the text to encode
 	 * @param nullTerminated if true, the text will be terminated with a '\0'.
-	 * @param target         the buffer in which to store the encoded text
+	 * @param target         the address at which to store the encoded text
+	 *
+	 * @return the number of bytes written, including the null-terminator
 	 */
-	public static void memEncodeUTF16(CharSequence text, boolean nullTerminated, ByteBuffer target) {
-		for ( int i = 0; i < text.length(); i++ )
-			target.putChar(i << 1, text.charAt(i));
+	public static int memEncodeUTF16(CharSequence text, boolean nullTerminated, long target) {
+		int length = text.length();
+		for ( int i = 0; i < length; i++ )
+			ACCESSOR.memPutShort(target + (i << 1), (short)text.charAt(i));
 
 		if ( nullTerminated )
-			target.putChar(target.capacity() - 2, '\0');
+			ACCESSOR.memPutShort(target + (length++ << 1), (short)0);
+
+		return length << 1;
 	}
 
 	/**
@@ -702,6 +1250,9 @@ public final class MemoryUtil {
 		if ( text == null )
 			return null;
 
+		if ( UTF8.equals(charset) )
+			return memEncodeUTF8(text, nullTerminated);
+
 		return encode(CharBuffer.wrap(nullTerminated ? new CharSequenceNT(text) : text), charset);
 	}
 
@@ -712,9 +1263,12 @@ public final class MemoryUtil {
 	 * @see java.nio.charset.CharsetEncoder#encode(java.nio.CharBuffer)
 	 */
 	private static ByteBuffer encode(CharBuffer in, Charset charset) {
-		CharsetEncoder encoder = charset.newEncoder(); // encoders are not thread-safe, create a new one on every call
+		CharsetEncoder encoder = ENCODER.get();
+		if ( encoder == null || !encoder.charset().equals(charset) )
+			ENCODER.set(encoder = charset.newEncoder());
 
-		int n = (int)(in.remaining() * encoder.averageBytesPerChar());
+		// Use the worst-case size, so that the loop below does not have to grow the buffer
+		int n = (int)Math.ceil(in.remaining() * encoder.maxBytesPerChar());
 		ByteBuffer out = BufferUtils.createByteBuffer(n);
 
 		if ( n == 0 && in.remaining() == 0 )
@@ -748,6 +1302,39 @@ public final class MemoryUtil {
 		return out;
 	}
 
+	/**
+	 * Calculates the length of the null-terminated string that starts at the specified memory address. The null-terminator is assumed to be a single
+	 * {@code \0} character.
+	 * <p/>
+	 * Short strings are scanned a word at a time, without a JNI transition (if sun.misc.Unsafe is available). Longer strings are scanned with the native
+	 * {@code strlen}.
+	 *
+	 * @param address the string memory address
+	 *
+	 * @return the string length, <strong>in bytes</strong>
+	 */
+	public static int memStrLen1(long address) {
+		if ( LWJGLUtil.DEBUG && address == NULL )
+			throw new IllegalArgumentException();
+
+		return ACCESSOR.memStrLen1(address);
+	}
+
+	/**
+	 * Calculates the length of the null-terminated string that starts at the specified memory address. The null-terminator is assumed to be 2 consecutive
+	 * {@code \0} characters, at an even offset.
+	 *
+	 * @param address the string memory address
+	 *
+	 * @return the string length, <strong>in bytes</strong>
+	 */
+	public static int memStrLen2(long address) {
+		if ( LWJGLUtil.DEBUG && address == NULL )
+			throw new IllegalArgumentException();
+
+		return ACCESSOR.memStrLen2(address);
+	}
+
 	/**
 	 * Calculates the length of the null-terminated string in {@code buffer} that starts at the current {@code buffer} position. The null-terminator is assumed
 	 * to be a single {@code \0} character.
@@ -860,6 +1447,164 @@ public final class MemoryUtil {
 		return new String(chars);
 	}
 
+	/**
+	 * Decodes the null-terminated string at the specified memory address, as an ASCII string. Bytes outside the ASCII range are decoded as ISO-8859-1.
+	 *
+	 * @param address the string memory address, may be {@link #NULL}
+	 *
+	 * @return the decoded {@link String} or null if the given {@code address} is {@link #NULL}
+	 */
+	public static String memDecodeASCII(long address) {
+		if ( address == NULL )
+			return null;
+
+		return memDecodeASCII(address, ACCESSOR.memStrLen1(address));
+	}
+
+	/**
+	 * Decodes {@code length} bytes starting at the specified memory address, as an ASCII string. Bytes outside the ASCII range are decoded as
+	 * ISO-8859-1.
+	 *
+	 * @param address the string memory address
+	 * @param length  the number of bytes to decode
+	 *
+	 * @return the decoded {@link String}
+	 */
+	public static String memDecodeASCII(long address, int length) {
+		char[] chars = new char[length];
+
+		for ( int i = 0; i < length; i++ )
+			chars[i] = (char)(ACCESSOR.memGetByte(address + i) & 0xFF);
+
+		return new String(chars);
+	}
+
+	/**
+	 * Decodes the null-terminated string at the specified memory address, as a UTF-8 string.
+	 *
+	 * @param address the string memory address, may be {@link #NULL}
+	 *
+	 * @return the decoded {@link String} or null if the given {@code address} is {@link #NULL}
+	 */
+	public static String memDecodeUTF8(long address) {
+		if ( address == NULL )
+			return null;
+
+		return memDecodeUTF8(address, ACCESSOR.memStrLen1(address));
+	}
+
+	/**
+	 * Decodes {@code length} bytes starting at the specified memory address, as a UTF-8 string. Malformed input is decoded as U+FFFD.
+	 *
+	 * @param address the string memory address
+	 * @param length  the number of bytes to decode
+	 *
+	 * @return the decoded {@link String}
+	 */
+	public static String memDecodeUTF8(long address, int length) {
+		char[] chars = new char[length]; // UTF-8 never decodes to more UTF-16 units than bytes
+
+		// ASCII fast path
+		int i = 0;
+		for ( ; i < length; i++ ) {
+			byte b = ACCESSOR.memGetByte(address + i);
+			if ( b < 0 )
+				break;
+			chars[i] = (char)b;
+		}
+
+		int c = i;
+		while ( i < length ) {
+			int b0 = ACCESSOR.memGetByte(address + i++);
+			if ( 0 <= b0 ) {
+				chars[c++] = (char)b0;
+				continue;
+			}
+
+			b0 &= 0xFF;
+
+			int cp;
+			if ( b0 < 0xC2 ) // Continuation byte or overlong 2-byte sequence
+				cp = -1;
+			else if ( b0 < 0xE0 ) {
+				int b1 = utf8Continuation(address, i, length);
+				if ( b1 < 0 )
+					cp = -1;
+				else {
+					cp = ((b0 & 0x1F) << 6) | b1;
+					i += 1;
+				}
+			} else if ( b0 < 0xF0 ) {
+				int b1 = utf8Continuation(address, i, length);
+				int b2 = utf8Continuation(address, i + 1, length);
+				cp = (b1 | b2) < 0 ? -1 : ((b0 & 0x0F) << 12) | (b1 << 6) | b2;
+				if ( cp < 0x800 || (Character.MIN_SURROGATE <= cp && cp <= Character.MAX_SURROGATE) )
+					cp = -1;
+				else
+					i += 2;
+			} else if ( b0 < 0xF5 ) {
+				int b1 = utf8Continuation(address, i, length);
+				int b2 = utf8Continuation(address, i + 1, length);
+				int b3 = utf8Continuation(address, i + 2, length);
+				cp = (b1 | b2 | b3) < 0 ? -1 : ((b0 & 0x07) << 18) | (b1 << 12) | (b2 << 6) | b3;
+				if ( cp < Character.MIN_SUPPLEMENTARY_CODE_POINT || Character.MAX_CODE_POINT < cp )
+					cp = -1;
+				else {
+					i += 3;
+
+					cp -= Character.MIN_SUPPLEMENTARY_CODE_POINT;
+					chars[c++] = (char)(Character.MIN_HIGH_SURROGATE + (cp >>> 10));
+					cp = Character.MIN_LOW_SURROGATE + (cp & 0x3FF);
+				}
+			} else
+				cp = -1;
+
+			chars[c++] = cp == -1 ? '\uFFFD' : (char)cp;
+		}
+
+		return new String(chars, 0, c);
+	}
+
+	/** Returns the payload bits of the UTF-8 continuation byte at the specified index, or -1 if there is no continuation byte at that index. */
+	private static int utf8Continuation(long address, int index, int length) {
+		if ( length <= index )
+			return -1;
+
+		int b = ACCESSOR.memGetByte(address + index);
+		return (b & 0xC0) == 0x80 ? b & 0x3F : -1;
+	}
+
+	/**
+	 * Decodes the null-terminated string at the specified memory address, as a UTF-16 string.
+	 *
+	 * @param address the string memory address, may be {@link #NULL}
+	 *
+	 * @return the decoded {@link String} or null if the given {@code address} is {@link #NULL}
+	 */
+	public static String memDecodeUTF16(long address) {
+		if ( address == NULL )
+			return null;
+
+		return memDecodeUTF16(address, ACCESSOR.memStrLen2(address));
+	}
+
+	/**
+	 * Decodes {@code length} bytes starting at the specified memory address, as a UTF-16 string.
+	 *
+	 * @param address the string memory address
+	 * @param length  the number of bytes to decode
+	 *
+	 * @return the decoded {@link String}
+	 */
+	public static String memDecodeUTF16(long address, int length) {
+		char[] chars = new char[length >> 1];
+
+		for ( int i = 0; i < chars.length; i++ )
+			chars[i] = (char)ACCESSOR.memGetShort(address + (i << 1));
+
+		return new String(chars);
+	}
+
 	/**
 	 * Decodes the bytes with index {@code [position(), position()+remaining()}) in {@code buffer}, as a UTF-8 string.
 	 * <p/>
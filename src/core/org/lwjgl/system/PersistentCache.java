@@ -0,0 +1,475 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.LWJGLUtil;
+
+import java.io.*;
+import java.nio.ByteBuffer;
+import java.security.AccessController;
+import java.security.PrivilegedAction;
+import java.util.*;
+
+import static org.lwjgl.Pointer.*;
+import static org.lwjgl.system.APIUtil.*;
+import static org.lwjgl.system.MemoryStack.*;
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * An optional on-disk cache of the extension set and function addresses of a native API, for a specific driver signature. It is used by
+ * {@code GL.createCapabilities}, {@code ALC.createCapabilities} and {@code CL.createCapabilities} to skip the extension string parsing and the function
+ * address lookups on startup.
+ * <p/>
+ * Function addresses are stored as offsets relative to the base address of the shared object that contains them. An entry is only used if every shared
+ * object it references is currently loaded and has the same inode, modification time, size and build-id as when the entry was written. Function
+ * addresses that do not belong to a shared object (e.g. dispatch stubs generated at runtime) are not cached; the entry only records that they must be
+ * resolved on every start, so that they do not invalidate it.
+ * <p/>
+ * The cache is only available on Linux and is disabled by default. It can be enabled with the {@code org.lwjgl.util.PersistentCache} property. Files are
+ * stored in the directory specified by the {@code org.lwjgl.util.PersistentCacheDir} property, or {@code $XDG_CACHE_HOME/lwjgl}, or
+ * {@code ~/.cache/lwjgl}.
+ */
+public final class PersistentCache {
+
+	/** Whether the persistent cache is enabled. */
+	public static final boolean ENABLED =
+		LWJGLUtil.getPlatform() == LWJGLUtil.Platform.LINUX && LWJGLUtil.getPrivilegedBoolean("org.lwjgl.util.PersistentCache");
+
+	private static final int MAGIC   = 0x4C574A43; // LWJC
+	private static final int VERSION = 2;
+
+	// Library indices of the function entries that do not reference a shared object.
+	private static final int
+		LIBRARY_NULL    = -1, // the function is not available
+		LIBRARY_RUNTIME = -2; // the function address does not belong to a shared object
+
+	// Layout of the native SharedObjectInfo struct.
+	private static final int
+		INFO_BASE            = 0,
+		INFO_INODE           = 8,
+		INFO_MTIME           = 16,
+		INFO_SIZE            = 24,
+		INFO_BUILD_ID_LENGTH = 32,
+		INFO_BUILD_ID        = 36,
+		INFO_SIZEOF          = 104;
+
+	private final File   file;
+	private final String signature;
+
+	private Set<String>       extensions;
+	private Map<String, Long> functions;
+
+	// The functions that must be resolved on every start, see LIBRARY_RUNTIME.
+	private Set<String> runtimeFunctions;
+
+	// Every lookup made through the wrapped providers, cached or not.
+	private final Map<String, Long> resolved = new HashMap<String, Long>(256);
+
+	private boolean dirty;
+
+	private PersistentCache(File file, String signature) {
+		this.file = file;
+		this.signature = signature;
+	}
+
+	/**
+	 * Opens the cache entry of the specified API and driver signature.
+	 *
+	 * @param api       a short API identifier, used in the file name
+	 * @param signature a string that uniquely identifies the driver and the context configuration
+	 *
+	 * @return the cache entry, or null if the persistent cache is disabled
+	 */
+	public static PersistentCache open(String api, String signature) {
+		return ENABLED ? open(getDirectory(), api, signature) : null;
+	}
+
+	static PersistentCache open(File directory, String api, String signature) {
+		File file = new File(directory, api + "-" + Integer.toHexString(signature.hashCode()) + ".bin");
+
+		PersistentCache cache = new PersistentCache(file, signature);
+		if ( file.isFile() ) {
+			try {
+				cache.read();
+			} catch (IOException e) {
+				LWJGLUtil.log("Failed to read " + file + ": " + e.getMessage());
+				cache.extensions = null;
+				cache.functions = null;
+				cache.runtimeFunctions = null;
+			}
+		}
+		return cache;
+	}
+
+	private static File getDirectory() {
+		return AccessController.doPrivileged(new PrivilegedAction<File>() {
+			@Override
+			public File run() {
+				String dir = System.getProperty("org.lwjgl.util.PersistentCacheDir");
+				if ( dir != null )
+					return new File(dir);
+
+				dir = System.getenv("XDG_CACHE_HOME");
+				if ( dir != null && dir.length() != 0 )
+					return new File(dir, "lwjgl");
+
+				return new File(System.getProperty("user.home"), ".cache" + File.separator + "lwjgl");
+			}
+		});
+	}
+
+	/** Returns the cached extension set, or null if this entry is empty or invalid. */
+	public Set<String> getExtensions() {
+		return extensions;
+	}
+
+	/** Sets the extension set that will be written by {@link #store}. */
+	public void setExtensions(Set<String> extensions) {
+		this.extensions = extensions;
+		this.dirty = true;
+	}
+
+	private long getFunctionAddress(FunctionProvider provider, long handle, String functionName) {
+		Long address = functions == null ? null : functions.get(functionName);
+		if ( address == null ) {
+			address = provider instanceof FunctionProviderLocal && handle != NULL
+				? ((FunctionProviderLocal)provider).getFunctionAddress(handle, functionName)
+				: provider.getFunctionAddress(functionName);
+			if ( runtimeFunctions == null || !runtimeFunctions.contains(functionName) )
+				dirty = true;
+		}
+
+		resolved.put(functionName, address);
+		return address;
+	}
+
+	private void getFunctionAddresses(FunctionProvider provider, long handle, ByteBuffer names, long[] addresses) {
+		String[] functionNames = new String[addresses.length];
+
+		long name = memAddress(names);
+		for ( int i = 0; i < addresses.length; i++ ) {
+			int length = memStrLen1(name);
+			functionNames[i] = memDecodeASCII(name, length);
+			name += length + 1;
+		}
+
+		// Served from the cache if all functions are in it, otherwise everything is resolved with a single bulk lookup. The entry is only rewritten if a
+		// function is missing from it, not if it must be resolved on every start.
+		boolean cached = functions != null;
+		boolean missing = !cached;
+		for ( int i = 0; functions != null && i < addresses.length; i++ ) {
+			Long address = functions.get(functionNames[i]);
+			if ( address != null )
+				addresses[i] = address;
+			else {
+				cached = false;
+				if ( !runtimeFunctions.contains(functionNames[i]) ) {
+					missing = true;
+					break;
+				}
+			}
+		}
+
+		if ( !cached ) {
+			if ( provider instanceof FunctionProviderLocal && handle != NULL )
+				apiGetFunctionAddresses((FunctionProviderLocal)provider, handle, names, addresses);
+			else
+				apiGetFunctionAddresses(provider, names, addresses);
+			if ( missing )
+				dirty = true;
+		}
+
+		for ( int i = 0; i < addresses.length; i++ )
+			resolved.put(functionNames[i], addresses[i]);
+	}
+
+	/** Returns a {@link FunctionProvider} that returns cached addresses when available and records all lookups. */
+	public FunctionProvider wrap(final FunctionProvider provider) {
+		return new AbstractFunctionProvider() {
+			@Override
+			public long getFunctionAddress(String functionName) {
+				return PersistentCache.this.getFunctionAddress(provider, NULL, functionName);
+			}
+
+			@Override
+			public void getFunctionAddresses(ByteBuffer names, long[] addresses) {
+				PersistentCache.this.getFunctionAddresses(provider, NULL, names, addresses);
+			}
+
+			@Override
+			public void destroy() {
+				// The wrapped provider is owned by the API class.
+			}
+		};
+	}
+
+	/**
+	 * Returns a {@link FunctionProviderLocal} that returns cached addresses when available and records all lookups. Local addresses are cached by function
+	 * name only, the driver signature must identify the handles that are used.
+	 */
+	public FunctionProviderLocal wrap(final FunctionProviderLocal provider) {
+		return new AbstractFunctionProviderLocal() {
+			@Override
+			public long getFunctionAddress(String functionName) {
+				return PersistentCache.this.getFunctionAddress(provider, NULL, functionName);
+			}
+
+			@Override
+			public long getFunctionAddress(long handle, String functionName) {
+				return PersistentCache.this.getFunctionAddress(provider, handle, functionName);
+			}
+
+			@Override
+			public void getFunctionAddresses(ByteBuffer names, long[] addresses) {
+				PersistentCache.this.getFunctionAddresses(provider, NULL, names, addresses);
+			}
+
+			@Override
+			public void getFunctionAddresses(long handle, ByteBuffer names, long[] addresses) {
+				PersistentCache.this.getFunctionAddresses(provider, handle, names, addresses);
+			}
+
+			@Override
+			public void destroy() {
+				// The wrapped provider is owned by the API class.
+			}
+		};
+	}
+
+	/** Writes this entry to disk, if anything was missing from the cache. Failures are logged and otherwise ignored. */
+	public void store() {
+		if ( !dirty || extensions == null )
+			return;
+
+		try {
+			write();
+			dirty = false;
+		} catch (IOException e) {
+			LWJGLUtil.log("Failed to write " + file + ": " + e.getMessage());
+		}
+	}
+
+	private void read() throws IOException {
+		byte[] data;
+
+		RandomAccessFile raf = new RandomAccessFile(file, "r");
+		try {
+			data = new byte[(int)raf.length()];
+			raf.readFully(data);
+		} finally {
+			raf.close();
+		}
+
+		DataInputStream in = new DataInputStream(new ByteArrayInputStream(data));
+		if ( in.readInt() != MAGIC || in.readInt() != VERSION || in.readInt() != POINTER_SIZE || !signature.equals(in.readUTF()) )
+			return;
+
+		int libraryCount = in.readInt();
+		long[] bases = new long[libraryCount];
+		for ( int i = 0; i < libraryCount; i++ ) {
+			SharedObject library = new SharedObject(in);
+			SharedObject loaded = SharedObject.get(library.path);
+			if ( loaded == null || !loaded.matches(library) ) {
+				LWJGLUtil.log("Ignoring stale cache entry: " + file);
+				return;
+			}
+			bases[i] = loaded.base;
+		}
+
+		int extensionCount = in.readInt();
+		Set<String> extensions = new HashSet<String>(extensionCount);
+		for ( int i = 0; i < extensionCount; i++ )
+			extensions.add(in.readUTF());
+
+		int functionCount = in.readInt();
+		Map<String, Long> functions = new HashMap<String, Long>(functionCount);
+		Set<String> runtimeFunctions = new HashSet<String>();
+		for ( int i = 0; i < functionCount; i++ ) {
+			String name = in.readUTF();
+			int library = in.readInt();
+			long offset = in.readLong();
+
+			if ( library == LIBRARY_RUNTIME )
+				runtimeFunctions.add(name);
+			else
+				functions.put(name, library == LIBRARY_NULL ? NULL : bases[library] + offset);
+		}
+
+		this.extensions = extensions;
+		this.functions = functions;
+		this.runtimeFunctions = runtimeFunctions;
+	}
+
+	private void write() throws IOException {
+		List<SharedObject> libraries = new ArrayList<SharedObject>();
+		Map<String, Integer> libraryIndices = new HashMap<String, Integer>();
+
+		Map<String, Integer> functionLibraries = new HashMap<String, Integer>(resolved.size());
+		Map<String, Long> functionOffsets = new HashMap<String, Long>(resolved.size());
+
+		for ( Map.Entry<String, Long> entry : resolved.entrySet() ) {
+			long address = entry.getValue();
+			if ( address == NULL ) {
+				functionLibraries.put(entry.getKey(), LIBRARY_NULL);
+				functionOffsets.put(entry.getKey(), 0L);
+				continue;
+			}
+
+			long name = nSharedObjectName(address);
+			if ( name == NULL ) {
+				functionLibraries.put(entry.getKey(), LIBRARY_RUNTIME);
+				functionOffsets.put(entry.getKey(), 0L);
+				continue;
+			}
+
+			String path = memDecodeUTF8(name);
+
+			Integer index = libraryIndices.get(path);
+			if ( index == null ) {
+				SharedObject library = SharedObject.get(path);
+				if ( library == null ) {
+					functionLibraries.put(entry.getKey(), LIBRARY_RUNTIME);
+					functionOffsets.put(entry.getKey(), 0L);
+					continue;
+				}
+
+				index = libraries.size();
+				libraries.add(library);
+				libraryIndices.put(path, index);
+			}
+
+			functionLibraries.put(entry.getKey(), index);
+			functionOffsets.put(entry.getKey(), address - libraries.get(index).base);
+		}
+
+		ByteArrayOutputStream bytes = new ByteArrayOutputStream(16 * 1024);
+		DataOutputStream out = new DataOutputStream(bytes);
+
+		out.writeInt(MAGIC);
+		out.writeInt(VERSION);
+		out.writeInt(POINTER_SIZE);
+		out.writeUTF(signature);
+
+		out.writeInt(libraries.size());
+		for ( SharedObject library : libraries )
+			library.write(out);
+
+		out.writeInt(extensions.size());
+		for ( String extension : extensions )
+			out.writeUTF(extension);
+
+		out.writeInt(functionLibraries.size());
+		for ( Map.Entry<String, Integer> entry : functionLibraries.entrySet() ) {
+			out.writeUTF(entry.getKey());
+			out.writeInt(entry.getValue());
+			out.writeLong(functionOffsets.get(entry.getKey()));
+		}
+		out.flush();
+
+		File dir = file.getParentFile();
+		if ( !dir.isDirectory() && !dir.mkdirs() )
+			throw new IOException("Failed to create directory " + dir);
+
+		// Write to a temporary file and rename, so that concurrent readers never see a partial entry.
+		File tmp = File.createTempFile(file.getName(), ".tmp", dir);
+		try {
+			FileOutputStream fos = new FileOutputStream(tmp);
+			try {
+				bytes.writeTo(fos);
+			} finally {
+				fos.close();
+			}
+
+			if ( !tmp.renameTo(file) )
+				throw new IOException("Failed to rename " + tmp + " to " + file);
+		} finally {
+			if ( tmp.exists() )
+				tmp.delete();
+		}
+	}
+
+	/** The identity of a loaded shared object. */
+	private static final class SharedObject {
+
+		final String path;
+
+		final long inode;
+		final long mtime;
+		final long size;
+
+		final byte[] buildId;
+
+		final long base;
+
+		SharedObject(String path, long inode, long mtime, long size, byte[] buildId, long base) {
+			this.path = path;
+			this.inode = inode;
+			this.mtime = mtime;
+			this.size = size;
+			this.buildId = buildId;
+			this.base = base;
+		}
+
+		SharedObject(DataInput in) throws IOException {
+			path = in.readUTF();
+			inode = in.readLong();
+			mtime = in.readLong();
+			size = in.readLong();
+			buildId = new byte[in.readUnsignedByte()];
+			in.readFully(buildId);
+			base = NULL;
+		}
+
+		/** Returns the shared object loaded from the specified path, or null if no such object is loaded. */
+		static SharedObject get(String path) {
+			MemoryStack stack = stackPush();
+			try {
+				long info = stack.nmalloc(8, INFO_SIZEOF);
+				if ( !nSharedObjectInfo(memAddress(stack.UTF8(path)), info) )
+					return null;
+
+				byte[] buildId = new byte[memGetInt(info + INFO_BUILD_ID_LENGTH)];
+				for ( int i = 0; i < buildId.length; i++ )
+					buildId[i] = memGetByte(info + INFO_BUILD_ID + i);
+
+				return new SharedObject(
+					path,
+					memGetLong(info + INFO_INODE),
+					memGetLong(info + INFO_MTIME),
+					memGetLong(info + INFO_SIZE),
+					buildId,
+					memGetLong(info + INFO_BASE)
+				);
+			} finally {
+				stack.pop();
+			}
+		}
+
+		boolean matches(SharedObject other) {
+			return inode == other.inode && mtime == other.mtime && size == other.size && Arrays.equals(buildId, other.buildId);
+		}
+
+		void write(DataOutput out) throws IOException {
+			out.writeUTF(path);
+			out.writeLong(inode);
+			out.writeLong(mtime);
+			out.writeLong(size);
+			out.writeByte(buildId.length);
+			out.write(buildId);
+		}
+
+	}
+
+	/** Returns the path of the shared object that contains the specified address, or {@code NULL} if it does not belong to one. */
+	private static native long nSharedObjectName(long address);
+
+	/**
+	 * Fills the specified {@code SharedObjectInfo} struct with the base address, file identity and build-id of a loaded shared object.
+	 *
+	 * @return false if the shared object is not loaded
+	 */
+	private static native boolean nSharedObjectInfo(long path, long info);
+
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.LWJGLUtil;
+import org.lwjgl.PointerBuffer;
+
+import java.io.PrintStream;
+import java.nio.*;
+import java.util.*;
+
+/**
+ * Per-function call counters for the generated bindings. When enabled, every generated method that calls a JNI method records the number of calls,
+ * the time spent in the JNI method and the number of bytes passed in buffer arguments.
+ * <p/>
+ * The profiling code is only emitted in instrumented builds of the bindings, generated with the {@code lwjgl.instrument} Ant property. It adds a
+ * try/finally block to every generated method, which makes their bytecode larger and may prevent the JIT from inlining hot methods, even when
+ * profiling is disabled. Normal builds have no profiling code and ignore this class.
+ * <p/>
+ * In instrumented builds, profiling is enabled with the {@code org.lwjgl.util.Profile} system property. The counters are kept per thread and summed when a snapshot is
+ * taken, so that recording does not cause contention between threads. Snapshots are approximate while other threads are still making calls.
+ * <p/>
+ * A snapshot can be printed periodically, by setting {@code org.lwjgl.util.ProfileInterval} to the dump interval in milliseconds. A final
+ * snapshot is printed at exit in that case.
+ */
+public final class Profiler {
+
+	/** Profiling flag, set with the {@code org.lwjgl.util.Profile} system property. */
+	public static final boolean ENABLED = LWJGLUtil.getPrivilegedBoolean("org.lwjgl.util.Profile");
+
+	private static final int INTERVAL = ENABLED ? LWJGLUtil.getPrivilegedInteger("org.lwjgl.util.ProfileInterval", 0) : 0;
+
+	private static final int DUMP_LIMIT = 32;
+
+	private static final Object lock = new Object();
+
+	// Function names and classes, indexed by function id. Guarded by lock.
+	private static String[]   names     = new String[512];
+	private static Class<?>[] classes   = new Class<?>[512];
+	private static int        nameCount;
+
+	// The counters of all threads that have recorded calls. Guarded by lock.
+	private static final List<Counters> threads = new ArrayList<Counters>();
+
+	private static final ThreadLocal<Counters> COUNTERS = new ThreadLocal<Counters>() {
+		@Override
+		protected Counters initialValue() {
+			Counters counters = new Counters();
+			synchronized ( lock ) {
+				counters.ensureCapacity(nameCount);
+				threads.add(counters);
+			}
+			return counters;
+		}
+	};
+
+	static {
+		if ( 0 < INTERVAL ) {
+			Thread dumper = new Thread("LWJGL Profiler") {
+				@Override
+				public void run() {
+					while ( true ) {
+						try {
+							Thread.sleep(INTERVAL);
+						} catch (InterruptedException e) {
+							return;
+						}
+						dump(System.err);
+					}
+				}
+			};
+			dumper.setDaemon(true);
+			dumper.start();
+
+			Runtime.getRuntime().addShutdownHook(new Thread("LWJGL Profiler") {
+				@Override
+				public void run() {
+					dump(System.err);
+				}
+			});
+		}
+	}
+
+	private Profiler() {
+	}
+
+	/**
+	 * Registers the functions of a generated class. Called once per class, when profiling or tracing is enabled. The function ids are shared with
+	 * {@link Trace}.
+	 *
+	 * @param type      the class
+	 * @param functions the function names, in the order of their ids
+	 *
+	 * @return the id of the first function. The function at index {@code i} has id {@code base + i}.
+	 */
+	public static int register(Class<?> type, String... functions) {
+		synchronized ( lock ) {
+			int base = nameCount;
+
+			nameCount += functions.length;
+			if ( names.length < nameCount ) {
+				int capacity = Math.max(names.length << 1, nameCount);
+				names = Arrays.copyOf(names, capacity);
+				classes = Arrays.copyOf(classes, capacity);
+			}
+
+			String className = type.getSimpleName();
+			for ( int i = 0; i < functions.length; i++ ) {
+				names[base + i] = className + '.' + functions[i];
+				classes[base + i] = type;
+			}
+
+			return base;
+		}
+	}
+
+	/** Returns the number of registered functions. */
+	public static int getFunctionCount() {
+		synchronized ( lock ) {
+			return nameCount;
+		}
+	}
+
+	/** Returns the name of the specified function, in the {@code <class>.<function>} format. */
+	public static String getFunctionName(int function) {
+		synchronized ( lock ) {
+			return names[function];
+		}
+	}
+
+	/** Returns the class of the specified function. */
+	public static Class<?> getFunctionClass(int function) {
+		synchronized ( lock ) {
+			return classes[function];
+		}
+	}
+
+	/**
+	 * Records a call. Called by the generated methods after the JNI method returns.
+	 *
+	 * @param function  the function id
+	 * @param startTime the {@link System#nanoTime} value before the JNI method was called
+	 * @param bytes     the number of bytes passed in buffer arguments
+	 */
+	public static void record(int function, long startTime, long bytes) {
+		long time = System.nanoTime() - startTime;
+
+		Counters counters = COUNTERS.get();
+		if ( counters.calls.length <= function ) {
+			synchronized ( lock ) {
+				counters.ensureCapacity(nameCount);
+			}
+		}
+
+		counters.calls[function]++;
+		counters.nanos[function] += time;
+		counters.bytes[function] += bytes;
+	}
+
+	/** Returns the number of bytes remaining in the specified buffer, or 0 if the buffer is null. */
+	public static long bytes(Buffer buffer) {
+		if ( buffer == null )
+			return 0L;
+
+		int remaining = buffer.remaining();
+		if ( buffer instanceof ByteBuffer )
+			return remaining;
+		if ( buffer instanceof IntBuffer || buffer instanceof FloatBuffer )
+			return (long)remaining << 2;
+		if ( buffer instanceof LongBuffer || buffer instanceof DoubleBuffer )
+			return (long)remaining << 3;
+		return (long)remaining << 1; // ShortBuffer, CharBuffer
+	}
+
+	/** PointerBuffer version of {@link #bytes(Buffer)}. */
+	public static long bytes(PointerBuffer buffer) {
+		return buffer == null ? 0L : buffer.remainingByte();
+	}
+
+	/**
+	 * Returns the counters of all functions that have been called at least once, summed over all threads, sorted by descending native time. Returns an
+	 * empty list if profiling is disabled.
+	 */
+	public static List<FunctionStats> getSnapshot() {
+		List<FunctionStats> snapshot = new ArrayList<FunctionStats>();
+
+		synchronized ( lock ) {
+			long[] calls = new long[nameCount];
+			long[] nanos = new long[nameCount];
+			long[] bytes = new long[nameCount];
+
+			for ( Counters counters : threads ) {
+				// The arrays may be replaced by the owner thread, read each reference once.
+				long[] c = counters.calls;
+				long[] n = counters.nanos;
+				long[] b = counters.bytes;
+
+				int count = Math.min(nameCount, Math.min(c.length, Math.min(n.length, b.length)));
+				for ( int i = 0; i < count; i++ ) {
+					calls[i] += c[i];
+					nanos[i] += n[i];
+					bytes[i] += b[i];
+				}
+			}
+
+			for ( int i = 0; i < nameCount; i++ ) {
+				if ( calls[i] != 0 )
+					snapshot.add(new FunctionStats(names[i], calls[i], nanos[i], bytes[i]));
+			}
+		}
+
+		Collections.sort(snapshot, new Comparator<FunctionStats>() {
+			@Override
+			public int compare(FunctionStats o1, FunctionStats o2) {
+				return o1.nanos < o2.nanos ? 1 : (o1.nanos == o2.nanos ? 0 : -1);
+			}
+		});
+
+		return snapshot;
+	}
+
+	/** Resets the counters of all threads. Calls recorded concurrently may be lost. */
+	public static void reset() {
+		synchronized ( lock ) {
+			for ( Counters counters : threads ) {
+				Arrays.fill(counters.calls, 0L);
+				Arrays.fill(counters.nanos, 0L);
+				Arrays.fill(counters.bytes, 0L);
+			}
+		}
+	}
+
+	/** Prints a snapshot of the most expensive functions to the specified stream. */
+	public static void dump(PrintStream out) {
+		List<FunctionStats> snapshot = getSnapshot();
+
+		StringBuilder builder = new StringBuilder(256);
+		builder.append("[LWJGL] Profiler snapshot, ").append(snapshot.size()).append(" functions called\n");
+		for ( int i = 0; i < Math.min(snapshot.size(), DUMP_LIMIT); i++ ) {
+			FunctionStats stats = snapshot.get(i);
+			builder.append(String.format(
+				"\t%-48s %12d calls %12.3fms %10.1fns/call %14d bytes%n",
+				stats.name, stats.calls, stats.nanos / 1000000.0, (double)stats.nanos / stats.calls, stats.bytes
+			));
+		}
+
+		out.print(builder);
+	}
+
+	/** The counters of a single function. */
+	public static final class FunctionStats {
+
+		/** The function name, in the {@code <class>.<function>} format. */
+		public final String name;
+
+		/** The number of calls. */
+		public final long calls;
+		/** The total time spent in native code, in nanoseconds. */
+		public final long nanos;
+		/** The total number of bytes passed in buffer arguments. */
+		public final long bytes;
+
+		FunctionStats(String name, long calls, long nanos, long bytes) {
+			this.name = name;
+			this.calls = calls;
+			this.nanos = nanos;
+			this.bytes = bytes;
+		}
+
+		@Override
+		public String toString() {
+			return name + ": " + calls + " calls, " + nanos + "ns, " + bytes + " bytes";
+		}
+
+	}
+
+	/** The counters of a single thread. Only written by the owner thread. */
+	private static final class Counters {
+
+		long[] calls = new long[0];
+		long[] nanos = new long[0];
+		long[] bytes = new long[0];
+
+		void ensureCapacity(int capacity) {
+			if ( capacity <= calls.length )
+				return;
+
+			capacity = Math.max(capacity, calls.length << 1);
+			calls = Arrays.copyOf(calls, capacity);
+			nanos = Arrays.copyOf(nanos, capacity);
+			bytes = Arrays.copyOf(bytes, capacity);
+		}
+
+	}
+
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.LWJGLUtil;
+
+import java.io.File;
+import java.io.IOException;
+
+/**
+ * Captures the native binding calls to a binary trace file, that can be replayed later. When enabled, every generated method that calls a JNI method
+ * writes the function id, the argument values and the contents of the buffer arguments to the trace, before calling the JNI method. See
+ * {@link TraceWriter} for the file format and {@link TraceReader} for reading a trace.
+ * <p/>
+ * Tracing is enabled with the {@code org.lwjgl.util.Trace} system property. It is configured with:
+ * <ul>
+ * <li>{@code org.lwjgl.util.TraceFile}: the trace file path, {@code lwjgl.trace} by default.</li>
+ * <li>{@code org.lwjgl.util.TraceSize}: the trace ring size, in megabytes, 64 by default, at most 2047. When the ring is full, the oldest calls are
+ * overwritten.</li>
+ * <li>{@code org.lwjgl.util.TraceDataLimit}: the maximum number of bytes captured per buffer argument, 65536 by default.</li>
+ * </ul>
+ * The tracing code is only emitted in instrumented builds of the bindings, generated with the {@code lwjgl.instrument} Ant property, see
+ * {@link Profiler}. Applications should call
+ * {@link #frame} at the end of each frame, so that the trace can be replayed frame by frame.
+ */
+public final class Trace {
+
+	/** The maximum trace ring size, in megabytes. */
+	private static final int MAX_SIZE = (Integer.MAX_VALUE - TraceWriter.HEADER_SIZE) >> 20;
+
+	private static final long[] NO_ARGS = new long[0];
+
+	private static final TraceWriter WRITER = createWriter();
+
+	/** Tracing flag, set with the {@code org.lwjgl.util.Trace} system property. False if the trace file could not be created. */
+	public static final boolean ENABLED = WRITER != null;
+
+	static {
+		if ( ENABLED ) {
+			Runtime.getRuntime().addShutdownHook(new Thread("LWJGL Trace") {
+				@Override
+				public void run() {
+					WRITER.flush();
+				}
+			});
+		}
+	}
+
+	private Trace() {
+	}
+
+	private static TraceWriter createWriter() {
+		if ( !LWJGLUtil.getPrivilegedBoolean("org.lwjgl.util.Trace") )
+			return null;
+
+		String path = LWJGLUtil.getPrivilegedProperty("org.lwjgl.util.TraceFile");
+		File file = new File(path == null ? "lwjgl.trace" : path);
+
+		int size = LWJGLUtil.getPrivilegedInteger("org.lwjgl.util.TraceSize", 64);
+		int dataLimit = LWJGLUtil.getPrivilegedInteger("org.lwjgl.util.TraceDataLimit", 64 * 1024);
+
+		// The ring is addressed with int offsets and mapped with a single MappedByteBuffer.
+		if ( size <= 0 || MAX_SIZE < size ) {
+			LWJGLUtil.log("Invalid trace size: " + size + "MB, must be between 1 and " + MAX_SIZE + ". Tracing is disabled.");
+			return null;
+		}
+
+		try {
+			TraceWriter writer = new TraceWriter(file, size << 20, dataLimit);
+			LWJGLUtil.log("Tracing native calls to: " + file.getAbsolutePath());
+			return writer;
+		} catch (IOException e) {
+			LWJGLUtil.log("Failed to create the trace file " + file + ", tracing is disabled: " + e);
+			return null;
+		}
+	}
+
+	/** Writes a call without arguments to the trace. Called by the generated methods before the JNI method is called. */
+	public static void call(int function) {
+		WRITER.call(function, NO_ARGS, null);
+	}
+
+	/**
+	 * Writes a call to the trace. Called by the generated methods before the JNI method is called.
+	 *
+	 * @see TraceWriter#call
+	 */
+	public static void call(int function, long[] values, long[] sizes) {
+		WRITER.call(function, values, sizes);
+	}
+
+	/** Marks the end of a frame. Does nothing if tracing is disabled. */
+	public static void frame() {
+		if ( ENABLED )
+			WRITER.frame();
+	}
+
+	/** Flushes the trace to disk. Does nothing if tracing is disabled. */
+	public static void flush() {
+		if ( ENABLED )
+			WRITER.flush();
+	}
+
+}
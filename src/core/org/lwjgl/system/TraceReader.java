@@ -0,0 +1,206 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import java.io.*;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.Map;
+
+import static org.lwjgl.system.TraceWriter.*;
+
+/**
+ * Reads a trace file written by {@link TraceWriter}, from the oldest record to the newest. The reader is a cursor: {@link #next} advances to the next
+ * record and the getters return the values of the current record.
+ * <p/>
+ * The trace may be read while it is being written, but the records written after the reader was created are not visited.
+ */
+public final class TraceReader {
+
+	private final RandomAccessFile raf;
+	private final ByteBuffer       ring;
+
+	private final int  capacity;
+	private final int  head;
+	private final long records;
+
+	private final Map<Integer, String[]> functions = new HashMap<Integer, String[]>();
+
+	// The cursor is in the records of the previous lap, before the ring wraps.
+	private boolean previousLap;
+
+	private int position;
+
+	private int   function;
+	private long  time;
+	private int   argCount;
+	private int[] args = new int[16];
+
+	/**
+	 * Opens a trace file and its function names file.
+	 *
+	 * @param file the trace file
+	 */
+	public TraceReader(File file) throws IOException {
+		raf = new RandomAccessFile(file, "r");
+
+		ByteBuffer header;
+		try {
+			FileChannel channel = raf.getChannel();
+			if ( channel.size() < HEADER_SIZE )
+				throw new IOException("Invalid trace file: " + file);
+
+			header = channel.map(FileChannel.MapMode.READ_ONLY, 0, HEADER_SIZE).order(ByteOrder.nativeOrder());
+			for ( int i = 0; i < MAGIC.length(); i++ ) {
+				if ( header.get((int)MAGIC_OFFSET + i) != MAGIC.charAt(i) )
+					throw new IOException("Invalid trace file: " + file);
+			}
+
+			if ( header.getInt((int)BOM_OFFSET) != BOM )
+				header.order(ByteOrder.nativeOrder() == ByteOrder.LITTLE_ENDIAN ? ByteOrder.BIG_ENDIAN : ByteOrder.LITTLE_ENDIAN);
+
+			int version = header.getInt((int)VERSION_OFFSET);
+			if ( version != VERSION )
+				throw new IOException("Unsupported trace file version: " + version);
+
+			capacity = (int)header.getLong((int)CAPACITY_OFFSET);
+			ring = channel.map(FileChannel.MapMode.READ_ONLY, HEADER_SIZE, capacity).order(header.order());
+		} catch (IOException e) {
+			raf.close();
+			throw e;
+		}
+
+		head = (int)header.getLong((int)HEAD_OFFSET);
+		records = header.getLong((int)RECORDS_OFFSET);
+
+		int tail = (int)header.getLong((int)TAIL_OFFSET);
+		boolean wrapped = header.getInt((int)WRAPPED_OFFSET) != 0;
+
+		previousLap = wrapped && tail != 0;
+		position = tail;
+
+		File functionsFile = getFunctionsFile(file);
+		if ( functionsFile.exists() )
+			readFunctions(functionsFile);
+	}
+
+	private void readFunctions(File file) throws IOException {
+		BufferedReader reader = new BufferedReader(new FileReader(file));
+		try {
+			String line;
+			while ( (line = reader.readLine()) != null ) {
+				String[] tokens = line.split(" ");
+				if ( tokens.length == 3 )
+					functions.put(Integer.parseInt(tokens[0]), new String[] { tokens[1], tokens[2] });
+			}
+		} finally {
+			reader.close();
+		}
+	}
+
+	/** Returns the number of records written to the trace, including the records that have been overwritten. */
+	public long getRecordCount() {
+		return records;
+	}
+
+	/** Returns the fully qualified class name of the specified function, or null if the function is unknown. */
+	public String getFunctionClass(int function) {
+		String[] names = functions.get(function);
+		return names == null ? null : names[0];
+	}
+
+	/** Returns the name of the specified function, or null if the function is unknown. */
+	public String getFunctionName(int function) {
+		String[] names = functions.get(function);
+		return names == null ? null : names[1];
+	}
+
+	/** Advances to the next record. Returns false if there are no more records. */
+	public boolean next() {
+		if ( previousLap && (capacity - position < 4 || ring.getInt(position) == WRAP) ) {
+			previousLap = false;
+			position = 0;
+		}
+
+		if ( !previousLap && head <= position )
+			return false;
+
+		int size = ring.getInt(position);
+		function = ring.getInt(position + 4);
+		time = ring.getLong(position + 8);
+		argCount = ring.getInt(position + 16);
+
+		if ( args.length < argCount )
+			args = Arrays.copyOf(args, Math.max(argCount, args.length << 1));
+
+		int arg = position + RECORD_HEADER_SIZE;
+		for ( int i = 0; i < argCount; i++ ) {
+			args[i] = arg;
+			arg += 9;
+			if ( ring.get(args[i]) == ARG_DATA )
+				arg += 8 + ring.getInt(arg + 4);
+		}
+
+		position += size;
+		return true;
+	}
+
+	/** Returns the function id of the current record, or {@link TraceWriter#FRAME} for frame markers. */
+	public int getFunction() {
+		return function;
+	}
+
+	/** Returns true if the current record is a frame marker. */
+	public boolean isFrame() {
+		return function == FRAME;
+	}
+
+	/** Returns the {@link System#nanoTime} value at the time of the call. */
+	public long getTime() {
+		return time;
+	}
+
+	/** Returns the number of arguments of the current record. */
+	public int getArgumentCount() {
+		return argCount;
+	}
+
+	/** Returns the tag of the specified argument, one of {@link TraceWriter#ARG_VALUE}, {@link TraceWriter#ARG_DATA} or {@link TraceWriter#ARG_POINTER}. */
+	public byte getArgumentTag(int index) {
+		return ring.get(args[index]);
+	}
+
+	/** Returns the value of the specified argument, as it was passed to the JNI method. */
+	public long getArgumentValue(int index) {
+		return ring.getLong(args[index] + 1);
+	}
+
+	/** Returns the size of the memory referenced by the specified {@link TraceWriter#ARG_DATA} argument. */
+	public int getArgumentSize(int index) {
+		return ring.getInt(args[index] + 9);
+	}
+
+	/**
+	 * Returns the captured contents of the specified {@link TraceWriter#ARG_DATA} argument. The captured data may be smaller than
+	 * {@link #getArgumentSize}, if the argument was larger than the data limit of the trace.
+	 */
+	public ByteBuffer getArgumentData(int index) {
+		int arg = args[index] + 9;
+
+		ByteBuffer data = ring.duplicate();
+		data.position(arg + 8);
+		data.limit(arg + 8 + ring.getInt(arg + 4));
+		return data.slice().order(ring.order());
+	}
+
+	/** Closes the trace file. */
+	public void close() throws IOException {
+		raf.close();
+	}
+
+}
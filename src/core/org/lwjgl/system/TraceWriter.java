@@ -0,0 +1,313 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import java.io.*;
+import java.nio.ByteOrder;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * Writes native binding calls to a binary trace file. The file is memory-mapped and used as a ring buffer: when it is full, the oldest calls are
+ * overwritten. When the ring wraps, the remaining records of the older lap are dropped too. The trace survives a crash of the process, up to the
+ * last complete call.
+ * <p/>
+ * The file starts with a header of {@link #HEADER_SIZE} bytes, in the native byte order:
+ * <pre>
+ * 0:  8 bytes  magic, "LWJGLTRC"
+ * 8:  int      version
+ * 12: int      byte order mark, 0x01020304
+ * 16: long     ring capacity, in bytes
+ * 24: long     head, the ring offset of the next record
+ * 32: long     tail, the ring offset of the oldest record
+ * 40: int      1 if the ring has wrapped
+ * 48: long     the number of records written
+ * </pre>
+ * Each record is:
+ * <pre>
+ * int   record size, in bytes
+ * int   function id, or {@link #FRAME} for a frame marker
+ * long  {@link System#nanoTime} at the time of the call
+ * int   argument count
+ * </pre>
+ * followed by the arguments. Each argument starts with a tag byte and a long value. {@link #ARG_DATA} arguments are followed by the size of the
+ * memory the pointer references, the number of bytes captured and the captured bytes. A record that does not fit at the end of the ring is written at
+ * the start of the ring and a {@link #WRAP} marker is left in its place, if there is room for one.
+ * <p/>
+ * The function ids are assigned by {@link Profiler#register}. The function names are written to a text file next to the trace, with a
+ * {@code .functions} extension, one {@code <id> <class> <function>} line per function.
+ * <p/>
+ * Instances of this class are thread-safe. Calls from multiple threads are serialized.
+ */
+public final class TraceWriter {
+
+	/** The trace file version. */
+	public static final int VERSION = 1;
+
+	/** The header size, in bytes. */
+	public static final int HEADER_SIZE = 64;
+
+	/** The function id of frame markers. */
+	public static final int FRAME = -1;
+
+	/** Ring marker that indicates that the next record is at the start of the ring. */
+	public static final int WRAP = -1;
+
+	/** Argument tag: a scalar value or a pointer that is not dereferenced by the function (e.g. a buffer object offset). */
+	public static final byte ARG_VALUE = 0;
+	/** Argument tag: a pointer, followed by the contents of the memory it references. */
+	public static final byte ARG_DATA  = 1;
+	/** Argument tag: a pointer to memory of unknown size, the contents are not captured. */
+	public static final byte ARG_POINTER = 2;
+
+	static final long MAGIC_OFFSET    = 0;
+	static final long VERSION_OFFSET  = 8;
+	static final long BOM_OFFSET      = 12;
+	static final long CAPACITY_OFFSET = 16;
+	static final long HEAD_OFFSET     = 24;
+	static final long TAIL_OFFSET     = 32;
+	static final long WRAPPED_OFFSET  = 40;
+	static final long RECORDS_OFFSET  = 48;
+
+	static final String MAGIC = "LWJGLTRC";
+
+	static final int BOM = 0x01020304;
+
+	static final int RECORD_HEADER_SIZE = 4 + 4 + 8 + 4;
+
+	private final Object lock = new Object();
+
+	private final File             file;
+	private final RandomAccessFile raf;
+	private final MappedByteBuffer mapped;
+
+	private final long address;
+	private final long ring;
+	private final int  capacity;
+
+	private final int dataLimit;
+
+	private int     head;
+	private int     tail;
+	private boolean wrapped;
+	private long    records;
+
+	private int functionsWritten;
+
+	/**
+	 * Creates a new trace file. An existing file is replaced.
+	 *
+	 * @param file      the trace file
+	 * @param capacity  the ring capacity, in bytes, at least 4096 and at most {@code Integer.MAX_VALUE - HEADER_SIZE}
+	 * @param dataLimit the maximum number of bytes captured per pointer argument
+	 */
+	public TraceWriter(File file, int capacity, int dataLimit) throws IOException {
+		if ( capacity < 4096 || Integer.MAX_VALUE - HEADER_SIZE < capacity )
+			throw new IllegalArgumentException("Invalid trace capacity: " + capacity);
+
+		this.file = file;
+		this.capacity = capacity;
+		this.dataLimit = Math.max(0, Math.min(dataLimit, capacity >> 2));
+
+		if ( file.exists() && !file.delete() )
+			throw new IOException("Failed to delete the existing trace file: " + file);
+
+		raf = new RandomAccessFile(file, "rw");
+		try {
+			raf.setLength(HEADER_SIZE + capacity);
+			mapped = raf.getChannel().map(FileChannel.MapMode.READ_WRITE, 0, HEADER_SIZE + capacity);
+		} catch (IOException e) {
+			raf.close();
+			throw e;
+		}
+		mapped.order(ByteOrder.nativeOrder());
+
+		address = memAddress(mapped);
+		ring = address + HEADER_SIZE;
+
+		for ( int i = 0; i < MAGIC.length(); i++ )
+			memPutByte(address + MAGIC_OFFSET + i, (byte)MAGIC.charAt(i));
+		memPutInt(address + VERSION_OFFSET, VERSION);
+		memPutInt(address + BOM_OFFSET, BOM);
+		memPutLong(address + CAPACITY_OFFSET, capacity);
+		updateHeader();
+	}
+
+	/** Returns the trace file. */
+	public File getFile() {
+		return file;
+	}
+
+	/** Returns the function name file of the trace file. */
+	public static File getFunctionsFile(File file) {
+		return new File(file.getPath() + ".functions");
+	}
+
+	/**
+	 * Writes a call.
+	 *
+	 * @param function the function id
+	 * @param values   the argument values. Floating-point values are passed as raw bits, booleans as 0 or 1.
+	 * @param sizes    the argument sizes: -1 for values, -2 for pointers to memory of unknown size, otherwise the size of the memory referenced by the
+	 *                 pointer, in bytes. May be null if all arguments are values.
+	 */
+	public void call(int function, long[] values, long[] sizes) {
+		int size = RECORD_HEADER_SIZE + values.length * 9;
+		boolean capture = sizes != null;
+		if ( capture ) {
+			long dataSize = 0L;
+			for ( int i = 0; i < values.length; i++ ) {
+				if ( 0 <= sizes[i] )
+					dataSize += 8 + getCaptured(values[i], sizes[i]);
+			}
+
+			// Very large records would drop most of the ring, the contents are not captured in that case.
+			if ( size + dataSize <= capacity >> 1 )
+				size += (int)dataSize;
+			else
+				capture = false;
+		}
+
+		synchronized ( lock ) {
+			if ( functionsWritten <= function )
+				writeFunctions();
+
+			long record = reserve(size);
+			memPutInt(record, size);
+			memPutInt(record + 4, function);
+			memPutLong(record + 8, System.nanoTime());
+			memPutInt(record + 16, values.length);
+
+			long arg = record + RECORD_HEADER_SIZE;
+			for ( int i = 0; i < values.length; i++ ) {
+				long value = values[i];
+				long argSize = sizes == null ? -1L : sizes[i];
+
+				memPutByte(arg, argSize == -1L ? ARG_VALUE : (argSize < 0L || !capture ? ARG_POINTER : ARG_DATA));
+				memPutLong(arg + 1, value);
+				arg += 9;
+
+				if ( 0 <= argSize && capture ) {
+					int captured = getCaptured(value, argSize);
+					memPutInt(arg, (int)Math.min(argSize, Integer.MAX_VALUE));
+					memPutInt(arg + 4, captured);
+					if ( captured != 0 )
+						memCopy(value, arg + 8, captured);
+					arg += 8 + captured;
+				}
+			}
+
+			commit(size);
+		}
+	}
+
+	/** Writes a frame marker. */
+	public void frame() {
+		synchronized ( lock ) {
+			long record = reserve(RECORD_HEADER_SIZE);
+			memPutInt(record, RECORD_HEADER_SIZE);
+			memPutInt(record + 4, FRAME);
+			memPutLong(record + 8, System.nanoTime());
+			memPutInt(record + 16, 0);
+
+			commit(RECORD_HEADER_SIZE);
+		}
+	}
+
+	/** Flushes the trace and the function names to disk. */
+	public void flush() {
+		synchronized ( lock ) {
+			writeFunctions();
+			mapped.force();
+		}
+	}
+
+	/** Flushes and closes the trace file. The writer must not be used after this call. */
+	public void close() throws IOException {
+		synchronized ( lock ) {
+			flush();
+			raf.close();
+		}
+	}
+
+	private int getCaptured(long pointer, long size) {
+		return pointer == NULL ? 0 : (int)Math.min(size, dataLimit);
+	}
+
+	/**
+	 * Returns the address of a ring region of {@code size} bytes at the head, dropping the oldest records it overlaps.
+	 * <p/>
+	 * When the record does not fit at the end of the ring, the ring wraps and the records of the older lap that are still after the head are dropped,
+	 * even though they have not been overwritten. Keeping them would split the trace into three segments (the older lap, the rest of the current lap
+	 * and the new lap), which {@link TraceReader} cannot order. They occupy less than {@code size} bytes, so less than one record's worth of calls is
+	 * lost, in addition to the overwritten records.
+	 */
+	private long reserve(int size) {
+		if ( capacity - head < size ) {
+			if ( 4 <= capacity - head )
+				memPutInt(ring + head, WRAP);
+
+			// Drop the older lap, the oldest record is now at the start of the current lap.
+			tail = 0;
+			head = 0;
+			wrapped = true;
+		}
+
+		if ( wrapped ) {
+			// Advance the tail past the records that will be overwritten.
+			while ( head <= tail && tail < head + size ) {
+				if ( capacity - tail < 4 || memGetInt(ring + tail) == WRAP )
+					tail = 0;
+				else
+					tail += memGetInt(ring + tail);
+
+				if ( tail == capacity )
+					tail = 0;
+				if ( tail == 0 )
+					break;
+			}
+		}
+
+		return ring + head;
+	}
+
+	private void commit(int size) {
+		head += size;
+		records++;
+		updateHeader();
+	}
+
+	private void updateHeader() {
+		memPutLong(address + HEAD_OFFSET, head);
+		memPutLong(address + TAIL_OFFSET, tail);
+		memPutInt(address + WRAPPED_OFFSET, wrapped ? 1 : 0);
+		memPutLong(address + RECORDS_OFFSET, records);
+	}
+
+	private void writeFunctions() {
+		int count = Profiler.getFunctionCount();
+		if ( count == functionsWritten )
+			return;
+
+		try {
+			PrintWriter writer = new PrintWriter(new BufferedWriter(new FileWriter(getFunctionsFile(file))));
+			try {
+				for ( int i = 0; i < count; i++ ) {
+					String name = Profiler.getFunctionName(i);
+					writer.println(i + " " + Profiler.getFunctionClass(i).getName() + " " + name.substring(name.indexOf('.') + 1));
+				}
+			} finally {
+				writer.close();
+			}
+		} catch (IOException e) {
+			throw new RuntimeException("Failed to write the trace function names.", e);
+		}
+
+		functionsWritten = count;
+	}
+
+}
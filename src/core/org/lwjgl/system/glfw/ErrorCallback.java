@@ -49,7 +49,7 @@ public class ErrorCallback {
 	 * @param description a UTF-8 encoded string describing the error
 	 */
 	public void invoke(int error, long description) {
-		invoke(error, memDecodeUTF8(memByteBufferNT1(description)));
+		invoke(error, memDecodeUTF8(description));
 	}
 
 	/** String version of {@link #invoke(int, long)}. */
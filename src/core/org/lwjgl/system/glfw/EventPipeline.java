@@ -0,0 +1,463 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system.glfw;
+
+import org.lwjgl.LWJGLUtil;
+import org.lwjgl.LWJGLUtil.Platform;
+
+import java.io.PrintStream;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.locks.LockSupport;
+
+import com.lmax.disruptor.*;
+
+import static org.lwjgl.system.glfw.GLFW.*;
+import static org.lwjgl.system.glfw.WindowCallback.*;
+
+/**
+ * Decouples the GLFW event loop from the thread that consumes the window events. Events are published to the pipeline by the thread that runs the event
+ * loop and fired in the thread that calls {@link #poll} or {@link #waitEvents}.
+ * <p/>
+ * The pipeline uses a single-producer/single-consumer LMAX {@link RingBuffer}. It enables lock-free synchronization, bounded batching and no runtime
+ * allocations. The {@link WaitStrategy} is used by {@link #waitEvents} and can be selected per pipeline, e.g. {@link BlockingWaitStrategy} for the least
+ * CPU usage or {@link BusySpinWaitStrategy} for the lowest latency.
+ * <p/>
+ * The consumer is the last thread that called {@link #poll} or {@link #waitEvents}. If the ring-buffer is full when an event is published:
+ * <ul>
+ * <li>in the consumer thread, e.g. with {@link GLFW#glfwPollEvents} followed by {@link #poll} in the same thread, the pending events and the new event
+ * are fired immediately.</li>
+ * <li>in any other thread, the producer waits until the consumer catches up. No events are lost.</li>
+ * </ul>
+ * A thread that both runs the event loop and consumes the events must call {@link #poll} once before it runs the event loop for the first time, so that
+ * it is known as the consumer.
+ * <p/>
+ * Typical usage on Linux, where the render thread can then render without pumping the event loop:
+ * <pre>
+ * EventPipeline pipeline = new EventPipeline(1024, new SleepingWaitStrategy());
+ * pipeline.set(window, callback, WindowCallback.ALL);
+ * pipeline.start(1L, TimeUnit.MILLISECONDS); // glfwPollEvents is called in the pipeline thread from now on
+ *
+ * while ( running ) {
+ *     pipeline.poll(); // fires the pending events, never blocks
+ *     render();
+ * }
+ *
+ * pipeline.stop();</pre>
+ * {@link #start} is only supported on Linux. On Windows, window messages are delivered to the thread that created the window. On Mac OS X, the event loop
+ * already runs in the main thread and the events are forwarded to the client thread through an internal EventPipeline.
+ * <p/>
+ * The pipeline records the latency of each event, from the time it was received by the producer until it was fired by the consumer, see
+ * {@link #getLatencyHistogram}.
+ *
+ * @see <a href="http://github.com/LMAX-Exchange/disruptor">LMAX Exchange - Disruptor</a>
+ */
+public final class EventPipeline {
+
+	/** The event ring-buffer. */
+	private final RingBuffer<Event> ringBuffer;
+
+	/** Tracks the last published event. */
+	private final SequenceBarrier publishBarrier;
+
+	/** Tracks the last consumed event. */
+	private final Sequence consumeSequence = new Sequence(Sequencer.INITIAL_CURSOR_VALUE);
+
+	/** Updated in the consumer thread only. */
+	private final LatencyHistogram latency = new LatencyHistogram();
+
+	/** The thread that last called {@link #poll} or {@link #waitEvents}. */
+	private volatile Thread consumer;
+
+	/** True while {@link #poll} fires events. Accessed in the consumer thread only. */
+	private boolean firing;
+
+	private Thread  thread;
+	private volatile boolean running;
+
+	/**
+	 * Creates a new EventPipeline.
+	 *
+	 * @param bufferSize   the ring-buffer size, in events. Must be a power of two.
+	 * @param waitStrategy the strategy used by {@link #waitEvents} to wait for events
+	 */
+	public EventPipeline(int bufferSize, WaitStrategy waitStrategy) {
+		ringBuffer = RingBuffer.createSingleProducer(
+			// Used to fill the ring-buffer with pre-allocated events.
+			new EventFactory<Event>() {
+				@Override
+				public Event newInstance() {
+					return new Event();
+				}
+			},
+			bufferSize,
+			waitStrategy
+		);
+
+		publishBarrier = ringBuffer.newBarrier();
+		ringBuffer.addGatingSequences(consumeSequence);
+	}
+
+	/**
+	 * Returns a WindowCallback that publishes the events to this pipeline. The events are fired on {@code target} in the consumer thread.
+	 *
+	 * @param target the target WindowCallback
+	 */
+	public WindowCallback wrap(WindowCallback target) {
+		return new Producer(this, target);
+	}
+
+	/**
+	 * Enables window event callbacks for the given GLFW window, through this pipeline. On Mac OS X, this is the same as
+	 * {@link WindowCallback#set(long, WindowCallback, int)}.
+	 *
+	 * @param window     the GLFW window
+	 * @param proc       the WindowCallback instance, or NULL to disable event callbacks.
+	 * @param eventTypes the event types bit-field
+	 */
+	public void set(long window, WindowCallback proc, int eventTypes) {
+		if ( proc != null && LWJGLUtil.getPlatform() != Platform.MACOSX )
+			proc = wrap(proc);
+
+		WindowCallback.set(window, proc, eventTypes);
+	}
+
+	/**
+	 * Starts a thread that runs the GLFW event loop, by calling {@link GLFW#glfwPollEvents} every {@code interval}. The thread is the producer of this
+	 * pipeline from then on; it is a daemon thread with maximum priority. No other thread may process events until {@link #stop} is called.
+	 * <p/>
+	 * On X11, {@code XInitThreads} must be called before {@link GLFW#glfwInit}, because the render thread uses the display connection concurrently.
+	 *
+	 * @param interval the polling interval
+	 * @param unit     the interval unit
+	 *
+	 * @throws IllegalStateException if the thread has already been started or the platform is not Linux
+	 */
+	public synchronized void start(long interval, TimeUnit unit) {
+		if ( LWJGLUtil.getPlatform() != Platform.LINUX )
+			throw new IllegalStateException("The event thread is not supported on " + LWJGLUtil.getPlatformName());
+		if ( thread != null )
+			throw new IllegalStateException("The event thread has already been started.");
+
+		final long intervalNanos = unit.toNanos(interval);
+
+		running = true;
+		thread = new Thread("GLFW Event Thread") {
+			@Override
+			public void run() {
+				while ( running ) {
+					glfwPollEvents();
+					LockSupport.parkNanos(intervalNanos);
+				}
+			}
+		};
+		thread.setDaemon(true);
+		thread.setPriority(Thread.MAX_PRIORITY);
+		thread.start();
+	}
+
+	/** Stops the event thread and waits for it to terminate. Does nothing if the thread has not been started. */
+	public synchronized void stop() {
+		if ( thread == null )
+			return;
+
+		running = false;
+		try {
+			thread.join();
+		} catch (InterruptedException e) {
+			Thread.currentThread().interrupt();
+		}
+		thread = null;
+	}
+
+	/**
+	 * Publishes an event to the ring-buffer. This method is called from the producer thread.
+	 *
+	 * @param target the target WindowCallback
+	 * @param type   the event type
+	 * @param window the window handle
+	 * @param x      the first parameter
+	 * @param y      the second parameter
+	 */
+	void offer(WindowCallback target, int type, long window, double x, double y) {
+		long next;
+		try {
+			next = ringBuffer.tryNext();
+		} catch (InsufficientCapacityException e) {
+			if ( consumer == Thread.currentThread() ) {
+				// Waiting would never return, the consumer cannot catch up while it is publishing. Fire the pending events, then this one, in order.
+				if ( !firing )
+					poll();
+				dispatch(target, type, window, x, y);
+				return;
+			}
+
+			next = ringBuffer.next();
+		}
+
+		try {
+			Event event = ringBuffer.get(next);
+
+			event.target = target;
+			event.type = type;
+			event.window = window;
+			event.x = x;
+			event.y = y;
+			event.time = System.nanoTime();
+		} finally {
+			ringBuffer.publish(next);
+		}
+	}
+
+	/**
+	 * Fires the events that have been published so far, in the current thread. Never blocks.
+	 *
+	 * @return the number of events fired
+	 */
+	public int poll() {
+		setConsumer();
+
+		long consumeNext = consumeSequence.get() + 1L;
+		long consumeMax = publishBarrier.getCursor();
+
+		// See if there's an event available
+		if ( consumeMax < consumeNext )
+			return 0;
+
+		int count = (int)(consumeMax - consumeNext + 1L);
+
+		firing = true;
+		try {
+			do {
+				// Fire in the current thread
+				Event event = ringBuffer.get(consumeNext);
+				latency.record(System.nanoTime() - event.time);
+				event.fire();
+
+				// Keep firing until we reach consumeMax (batch-processing).
+				consumeNext++;
+			} while ( consumeNext <= consumeMax );
+		} finally {
+			firing = false;
+
+			// Let the ring-buffer know we're done processing this batch.
+			consumeSequence.set(consumeMax);
+		}
+
+		return count;
+	}
+
+	/** Blocks with the pipeline's wait strategy until at least one event is available, then fires the available events in the current thread. */
+	public void waitEvents() {
+		setConsumer();
+
+		try {
+			publishBarrier.waitFor(consumeSequence.get() + 1L);
+		} catch (Exception e) {
+			throw new RuntimeException(e);
+		}
+
+		poll();
+	}
+
+	private void setConsumer() {
+		Thread current = Thread.currentThread();
+		if ( consumer != current )
+			consumer = current;
+	}
+
+	/**
+	 * Returns the latency histogram of this pipeline. It must only be accessed in the consumer thread.
+	 *
+	 * @return the latency histogram
+	 */
+	public LatencyHistogram getLatencyHistogram() {
+		return latency;
+	}
+
+	/**
+	 * A histogram of event latencies, from the time an event was published until it was fired. The buckets are powers of two of nanoseconds, so the
+	 * percentiles are upper bounds within a factor of two. Recording does not allocate.
+	 */
+	public static final class LatencyHistogram {
+
+		private static final int BUCKETS = 64;
+
+		private final long[] buckets = new long[BUCKETS];
+
+		private long count;
+		private long total;
+		private long max;
+
+		LatencyHistogram() {
+		}
+
+		void record(long latency) {
+			if ( latency < 0L )
+				latency = 0L;
+
+			buckets[BUCKETS - Long.numberOfLeadingZeros(latency)]++;
+			count++;
+			total += latency;
+			if ( max < latency )
+				max = latency;
+		}
+
+		/** Returns the number of recorded events. */
+		public long getCount() {
+			return count;
+		}
+
+		/** Returns the mean latency, in nanoseconds. */
+		public double getMean() {
+			return count == 0L ? 0.0 : (double)total / count;
+		}
+
+		/** Returns the maximum latency, in nanoseconds. */
+		public long getMax() {
+			return max;
+		}
+
+		/**
+		 * Returns an upper bound of the specified latency percentile, in nanoseconds.
+		 *
+		 * @param percentile the percentile, in [0.0, 100.0]
+		 */
+		public long getPercentile(double percentile) {
+			if ( count == 0L )
+				return 0L;
+
+			long rank = (long)Math.ceil(count * percentile / 100.0);
+			long sum = 0L;
+			for ( int i = 0; i < BUCKETS; i++ ) {
+				sum += buckets[i];
+				if ( rank <= sum )
+					return Math.min(i == 0 ? 0L : (1L << i) - 1L, max);
+			}
+			return max;
+		}
+
+		/** Clears the histogram. */
+		public void reset() {
+			for ( int i = 0; i < BUCKETS; i++ )
+				buckets[i] = 0L;
+			count = 0L;
+			total = 0L;
+			max = 0L;
+		}
+
+		/**
+		 * Prints the histogram summary and the non-empty buckets to the specified stream.
+		 *
+		 * @param out the output stream
+		 */
+		public void dump(PrintStream out) {
+			out.format(
+				"%d events: mean %.1fus, 50th %.1fus, 99th %.1fus, 99.9th %.1fus, max %.1fus%n",
+				count, getMean() / 1000.0, getPercentile(50.0) / 1000.0, getPercentile(99.0) / 1000.0, getPercentile(99.9) / 1000.0, max / 1000.0
+			);
+			for ( int i = 0; i < BUCKETS; i++ ) {
+				if ( buckets[i] != 0L )
+					out.format("\t< %12dns: %d%n", 1L << i, buckets[i]);
+			}
+		}
+
+	}
+
+	/** Forwards the events of a window to the pipeline. */
+	private static final class Producer extends WindowCallback {
+
+		private static final double NULL = 0.0;
+
+		private final EventPipeline  pipeline;
+		private final WindowCallback target;
+
+		Producer(EventPipeline pipeline, WindowCallback target) {
+			this.pipeline = pipeline;
+			this.target = target;
+		}
+
+		@Override
+		public void windowPos(long window, int xpos, int ypos) {
+			pipeline.offer(target, WINDOW_POS, window, xpos, ypos);
+		}
+
+		@Override
+		public void windowSize(long window, int width, int height) {
+			pipeline.offer(target, WINDOW_SIZE, window, width, height);
+		}
+
+		@Override
+		public void windowClose(long window) {
+			pipeline.offer(target, WINDOW_CLOSE, window, NULL, NULL);
+		}
+
+		@Override
+		public void windowRefresh(long window) {
+			pipeline.offer(target, WINDOW_REFRESH, window, NULL, NULL);
+		}
+
+		@Override
+		public void windowFocus(long window, int focused) {
+			pipeline.offer(target, WINDOW_FOCUS, window, focused, NULL);
+		}
+
+		@Override
+		public void windowIconify(long window, int iconified) {
+			pipeline.offer(target, WINDOW_ICONIFY, window, iconified, NULL);
+		}
+
+		@Override
+		public void key(long window, int key, int action) {
+			pipeline.offer(target, KEY, window, key, action);
+		}
+
+		@Override
+		public void character(long window, int character) {
+			pipeline.offer(target, CHARACTER, window, character, NULL);
+		}
+
+		@Override
+		public void mouseButton(long window, int button, int action) {
+			pipeline.offer(target, MOUSE_BUTTON, window, button, action);
+		}
+
+		@Override
+		public void cursorPos(long window, double xpos, double ypos) {
+			pipeline.offer(target, CURSOR_POS, window, xpos, ypos);
+		}
+
+		@Override
+		public void cursorEnter(long window, int entered) {
+			pipeline.offer(target, CURSOR_ENTER, window, entered, NULL);
+		}
+
+		@Override
+		public void scroll(long window, double xpos, double ypos) {
+			pipeline.offer(target, SCROLL, window, xpos, ypos);
+		}
+
+	}
+
+	/** Mutable event for use in the ring-buffer. Integer parameters are encoded as doubles. */
+	private static class Event {
+
+		WindowCallback target;
+
+		int type;
+
+		long window;
+
+		double x;
+		double y;
+
+		/** The {@link System#nanoTime} value at the time the event was published. */
+		long time;
+
+		void fire() {
+			dispatch(target, type, window, x, y);
+		}
+	}
+
+}
@@ -9,9 +9,10 @@ import org.lwjgl.LWJGLUtil;
 import org.lwjgl.LWJGLUtil.Platform;
 import org.lwjgl.PointerBuffer;
 import org.lwjgl.opengl.GL11;
-import org.lwjgl.system.FastLongMap;
+import org.lwjgl.system.LongMap;
 
 import java.lang.reflect.Method;
+import java.nio.ByteBuffer;
 
 import static org.lwjgl.system.MemoryUtil.*;
 import static org.lwjgl.system.glfw.GLFW.*;
@@ -51,6 +52,21 @@ public abstract class WindowCallback {
 
 	public static final int ALL = 0xFFFF;
 
+	/** The initial batched event queue capacity, in events. */
+	private static final int EVENT_QUEUE_CAPACITY = 1024;
+
+	// Batched event queue layout, see org_lwjgl_system_glfw_WindowCallback.c
+	private static final int QUEUE_COUNT       = 0;
+	private static final int QUEUE_CAPACITY    = 4;
+	private static final int QUEUE_HEADER_SIZE = 16;
+
+	private static final int EVENT_WINDOW = 0;
+	private static final int EVENT_X      = 8;
+	private static final int EVENT_Y      = 16;
+	private static final int EVENT_TIME   = 24;
+	private static final int EVENT_TYPE   = 32;
+	private static final int EVENT_SIZE   = 40;
+
 	static {
 		try {
 			Method[] callbacks = new Method[LAST_INDEX + 1];
@@ -80,8 +96,16 @@ public abstract class WindowCallback {
 		}
 	}
 
-	// This is used like a Set.
-	private static final FastLongMap<Long> windows = new FastLongMap<Long>();
+	/** The WindowCallback of each window. */
+	private static final LongMap<WindowCallback> windows = new LongMap<WindowCallback>();
+
+	/** The batched event queue and its callbacks, allocated when batching is first enabled. */
+	private static ByteBuffer eventQueueBuffer;
+	private static long       eventQueue;
+	private static long[]     queueCallbacks;
+
+	private static boolean draining;
+	private static double  eventTime;
 
 	private int eventTypes;
 
@@ -94,6 +118,30 @@ public abstract class WindowCallback {
 
 	private static native void setCallbacks(Method[] callbacks, long procs);
 
+	private static native void setEventQueue(Method flushEventQueue, long queue, long procs);
+
+	private static void initEventQueue() {
+		if ( eventQueue != NULL )
+			return;
+
+		try {
+			PointerBuffer procs = BufferUtils.createPointerBuffer(LAST_INDEX + 1);
+
+			eventQueueBuffer = BufferUtils.createByteBuffer(QUEUE_HEADER_SIZE + EVENT_QUEUE_CAPACITY * EVENT_SIZE);
+			eventQueue = memAddress(eventQueueBuffer);
+			memPutInt(eventQueue + QUEUE_CAPACITY, EVENT_QUEUE_CAPACITY);
+
+			setEventQueue(WindowCallback.class.getDeclaredMethod("flushEventQueue"), eventQueue, memAddress(procs));
+
+			long[] callbacks = new long[procs.capacity()];
+			for ( int i = 0; i < callbacks.length; i++ )
+				callbacks[i] = procs.get(i);
+			queueCallbacks = callbacks;
+		} catch (Exception e) {
+			throw new RuntimeException(e);
+		}
+	}
+
 	/**
 	 * Enables all window event callbacks for the given GLFW window.
 	 *
@@ -113,6 +161,28 @@ public abstract class WindowCallback {
 	 * @param eventTypes the event types bit-field
 	 */
 	public static void set(long window, WindowCallback proc, int eventTypes) {
+		set(window, proc, eventTypes, false);
+	}
+
+	/**
+	 * Enables window event callbacks for the given GLFW window, optionally in batched mode.
+	 * <p/>
+	 * In batched mode, the native callbacks do not call into Java. They append the events to an off-heap queue, which is drained after
+	 * {@link GLFW#glfwPollEvents} and {@link GLFW#glfwWaitEvents} return, with a single pass that invokes the WindowCallback methods. The methods are
+	 * invoked in the same order and in the same thread, only later. {@link #getEventTime} returns the time each event was received. If the queue fills
+	 * up, it is drained immediately, or grows if it is being drained.
+	 * <p/>
+	 * Batched mode is ignored on Mac OS X, where events are already queued by the main thread.
+	 *
+	 * @param window     the GLFW window
+	 * @param proc       the WindowCallback instance, or NULL to disable event callbacks.
+	 * @param eventTypes the event types bit-field
+	 * @param batched    if true, events are queued and dispatched in batches
+	 */
+	public static void set(long window, WindowCallback proc, int eventTypes, boolean batched) {
+		// Dispatch queued events before the callback changes
+		drainEvents();
+
 		long oldRef = glfwGetWindowUserPointer(window);
 		if ( oldRef != NULL ) {
 			cleanup(window, oldRef);
@@ -122,21 +192,25 @@ public abstract class WindowCallback {
 		if ( proc != null ) {
 			if ( LWJGLUtil.getPlatform() == Platform.MACOSX ) {
 				// Wrap the user-specified callback
-				proc = new WindowCallbackMacOSX(proc);
+				proc = WindowCallbackMacOSX.wrap(proc);
 				// Enable all event types, else glfwWaitEvents can block
 				eventTypes = ALL;
+				batched = false;
 			}
 
-			windows.put(window, window);
+			if ( batched )
+				initEventQueue();
+
+			windows.put(window, proc);
 			glfwSetWindowUserPointer(window, memGlobalRefNew(proc));
 
-			configEvents(window, proc.eventTypes = eventTypes, 1L);
+			configEvents(window, proc.eventTypes = eventTypes, batched ? queueCallbacks : CALLBACKS, 1L);
 		}
 	}
 
 	private static void cleanup(long window, long oldRef) {
 		WindowCallback old = memGlobalRefToObject(oldRef);
-		configEvents(window, old.eventTypes, 0L);
+		configEvents(window, old.eventTypes, CALLBACKS, 0L);
 
 		glfwSetWindowUserPointer(window, NULL);
 		memGlobalRefDelete(oldRef);
@@ -146,42 +220,42 @@ public abstract class WindowCallback {
 		return (eventTypes & type) != 0;
 	}
 
-	private static void configEvents(long window, int eventTypes, long enable) {
+	private static void configEvents(long window, int eventTypes, long[] callbacks, long enable) {
 		if ( isEventEnabled(eventTypes, WINDOW_POS) )
-			glfwSetWindowPosCallback(window, CALLBACKS[WINDOW_POS_INDEX] * enable);
+			glfwSetWindowPosCallback(window, callbacks[WINDOW_POS_INDEX] * enable);
 
 		if ( isEventEnabled(eventTypes, WINDOW_SIZE) )
-			glfwSetWindowSizeCallback(window, CALLBACKS[WINDOW_SIZE_INDEX] * enable);
+			glfwSetWindowSizeCallback(window, callbacks[WINDOW_SIZE_INDEX] * enable);
 
 		if ( isEventEnabled(eventTypes, WINDOW_CLOSE) )
-			glfwSetWindowCloseCallback(window, CALLBACKS[WINDOW_CLOSE_INDEX] * enable);
+			glfwSetWindowCloseCallback(window, callbacks[WINDOW_CLOSE_INDEX] * enable);
 
 		if ( isEventEnabled(eventTypes, WINDOW_REFRESH) )
-			glfwSetWindowRefreshCallback(window, CALLBACKS[WINDOW_REFRESH_INDEX] * enable);
+			glfwSetWindowRefreshCallback(window, callbacks[WINDOW_REFRESH_INDEX] * enable);
 
 		if ( isEventEnabled(eventTypes, WINDOW_FOCUS) )
-			glfwSetWindowFocusCallback(window, CALLBACKS[WINDOW_FOCUS_INDEX] * enable);
+			glfwSetWindowFocusCallback(window, callbacks[WINDOW_FOCUS_INDEX] * enable);
 
 		if ( isEventEnabled(eventTypes, WINDOW_ICONIFY) )
-			glfwSetWindowIconifyCallback(window, CALLBACKS[WINDOW_ICONIFY_INDEX] * enable);
+			glfwSetWindowIconifyCallback(window, callbacks[WINDOW_ICONIFY_INDEX] * enable);
 
 		if ( isEventEnabled(eventTypes, KEY) )
-			glfwSetKeyCallback(window, CALLBACKS[KEY_INDEX] * enable);
+			glfwSetKeyCallback(window, callbacks[KEY_INDEX] * enable);
 
 		if ( isEventEnabled(eventTypes, CHARACTER) )
-			glfwSetCharCallback(window, CALLBACKS[CHARACTER_INDEX] * enable);
+			glfwSetCharCallback(window, callbacks[CHARACTER_INDEX] * enable);
 
 		if ( isEventEnabled(eventTypes, MOUSE_BUTTON) )
-			glfwSetMouseButtonCallback(window, CALLBACKS[MOUSE_BUTTON_INDEX] * enable);
+			glfwSetMouseButtonCallback(window, callbacks[MOUSE_BUTTON_INDEX] * enable);
 
 		if ( isEventEnabled(eventTypes, CURSOR_POS) )
-			glfwSetCursorPosCallback(window, CALLBACKS[CURSOR_POS_INDEX] * enable);
+			glfwSetCursorPosCallback(window, callbacks[CURSOR_POS_INDEX] * enable);
 
 		if ( isEventEnabled(eventTypes, CURSOR_ENTER) )
-			glfwSetCursorEnterCallback(window, CALLBACKS[CURSOR_ENTER_INDEX] * enable);
+			glfwSetCursorEnterCallback(window, callbacks[CURSOR_ENTER_INDEX] * enable);
 
 		if ( isEventEnabled(eventTypes, SCROLL) )
-			glfwSetScrollCallback(window, CALLBACKS[SCROLL_INDEX] * enable);
+			glfwSetScrollCallback(window, callbacks[SCROLL_INDEX] * enable);
 	}
 
 	/**
@@ -190,12 +264,126 @@ public abstract class WindowCallback {
 	 * from the global reference we create in {@link #set(long, WindowCallback, int)}.
 	 */
 	static void clearAll() {
-		for ( FastLongMap.Entry<Long> entry : windows )
-			cleanup(entry.getKey(), glfwGetWindowUserPointer(entry.getKey()));
+		drainEvents();
+
+		for ( LongMap.Cursor<WindowCallback> cursor = windows.cursor(); cursor.next(); )
+			cleanup(cursor.key(), glfwGetWindowUserPointer(cursor.key()));
 
 		windows.clear();
 	}
 
+	/**
+	 * Returns the {@link GLFW#glfwGetTime} value at which the event being dispatched was received, if it is a batched event. Returns 0.0 otherwise.
+	 *
+	 * @see #set(long, WindowCallback, int, boolean)
+	 */
+	public static double getEventTime() {
+		return eventTime;
+	}
+
+	/**
+	 * Called from native code when the batched event queue is full. Returns the address of the queue, which is reallocated if it grows.
+	 */
+	static long flushEventQueue() {
+		if ( draining ) {
+			// A callback is polling events. The new events must be dispatched after the events that are still queued, so the queue grows instead.
+			int capacity = memGetInt(eventQueue + QUEUE_CAPACITY) << 1;
+
+			ByteBuffer buffer = BufferUtils.createByteBuffer(QUEUE_HEADER_SIZE + capacity * EVENT_SIZE);
+			long queue = memAddress(buffer);
+			memCopy(eventQueue, queue, QUEUE_HEADER_SIZE + memGetInt(eventQueue + QUEUE_COUNT) * EVENT_SIZE);
+			memPutInt(queue + QUEUE_CAPACITY, capacity);
+
+			// The draining loop reads eventQueue on every iteration, it continues in the new queue.
+			eventQueueBuffer = buffer;
+			eventQueue = queue;
+		} else
+			drainEvents();
+
+		return eventQueue;
+	}
+
+	/**
+	 * Dispatches the events in the batched event queue. Called after {@link GLFW#glfwPollEvents} and {@link GLFW#glfwWaitEvents} and from native
+	 * code when the queue is full.
+	 */
+	static void drainEvents() {
+		// Events queued while draining, e.g. by a callback that polls events, are dispatched by the outer loop. The queue grows as needed, see
+		// flushEventQueue.
+		if ( eventQueue == NULL || draining || memGetInt(eventQueue + QUEUE_COUNT) == 0 )
+			return;
+
+		draining = true;
+		try {
+			long window = NULL;
+			WindowCallback target = null;
+
+			for ( int i = 0; i < memGetInt(eventQueue + QUEUE_COUNT); i++ ) {
+				long event = eventQueue + QUEUE_HEADER_SIZE + i * EVENT_SIZE;
+
+				long eventWindow = memGetLong(event + EVENT_WINDOW);
+				if ( eventWindow != window ) {
+					window = eventWindow;
+					target = windows.get(window);
+				}
+
+				if ( target == null )
+					continue;
+
+				eventTime = memGetDouble(event + EVENT_TIME);
+				dispatch(target, memGetInt(event + EVENT_TYPE), window, memGetDouble(event + EVENT_X), memGetDouble(event + EVENT_Y));
+			}
+		} finally {
+			memPutInt(eventQueue + QUEUE_COUNT, 0);
+			eventTime = 0.0;
+			draining = false;
+		}
+	}
+
+	/** Invokes the WindowCallback method that corresponds to {@code type}. Integer arguments are encoded as doubles. */
+	static void dispatch(WindowCallback target, int type, long window, double x, double y) {
+		switch ( type ) {
+			case WINDOW_POS:
+				target.windowPos(window, (int)x, (int)y);
+				break;
+			case WINDOW_SIZE:
+				target.windowSize(window, (int)x, (int)y);
+				break;
+			case WINDOW_CLOSE:
+				target.windowClose(window);
+				break;
+			case WINDOW_REFRESH:
+				target.windowRefresh(window);
+				break;
+			case WINDOW_FOCUS:
+				target.windowFocus(window, (int)x);
+				break;
+			case WINDOW_ICONIFY:
+				target.windowIconify(window, (int)x);
+				break;
+			case KEY:
+				target.key(window, (int)x, (int)y);
+				break;
+			case CHARACTER:
+				target.character(window, (int)x);
+				break;
+			case MOUSE_BUTTON:
+				target.mouseButton(window, (int)x, (int)y);
+				break;
+			case CURSOR_POS:
+				target.cursorPos(window, x, y);
+				break;
+			case CURSOR_ENTER:
+				target.cursorEnter(window, (int)x);
+				break;
+			case SCROLL:
+				target.scroll(window, x, y);
+				break;
+			default:
+				throw new IllegalStateException("Invalid event type: " + LWJGLUtil.toHexString(type));
+		}
+	}
+
 	/**
 	 * The window move callback.
 	 *
@@ -287,17 +287,22 @@ class GLFWwindowLinux extends GLFWwindow {
 
 				ByteBuffer request = event;
 
-				ByteBuffer response = createByteBuffer(XEvent.SIZEOF);
-
-				XSelectionRequestEvent.propertySet(response, writeSelection(request));
-				XSelectionRequestEvent.typeSet(response, SelectionNotify);
-				XSelectionRequestEvent.displaySet(response, XSelectionRequestEvent.displayGet(request));
-				XSelectionRequestEvent.requestorSet(response, XSelectionRequestEvent.requestorGet(request));
-				XSelectionRequestEvent.selectionSet(response, XSelectionRequestEvent.selectionGet(request));
-				XSelectionRequestEvent.targetSet(response, XSelectionRequestEvent.targetGet(request));
-				XSelectionRequestEvent.timeSet(response, XSelectionRequestEvent.timeGet(request));
-
-				XSendEvent(x11.display, XSelectionRequestEvent.requestorGet(request), False, 0, response);
+				ByteBuffer response = XEvent.allocate();
+				try {
+					zeroBuffer(response);
+
+					XSelectionRequestEvent.propertySet(response, writeSelection(request));
+					XSelectionRequestEvent.typeSet(response, SelectionNotify);
+					XSelectionRequestEvent.displaySet(response, XSelectionRequestEvent.displayGet(request));
+					XSelectionRequestEvent.requestorSet(response, XSelectionRequestEvent.requestorGet(request));
+					XSelectionRequestEvent.selectionSet(response, XSelectionRequestEvent.selectionGet(request));
+					XSelectionRequestEvent.targetSet(response, XSelectionRequestEvent.targetGet(request));
+					XSelectionRequestEvent.timeSet(response, XSelectionRequestEvent.timeGet(request));
+
+					XSendEvent(x11.display, XSelectionRequestEvent.requestorGet(request), False, 0, response);
+				} finally {
+					XEvent.release(response);
+				}
 				break;
 			}
 
@@ -5,10 +5,11 @@
  */
 package org.lwjgl.system.jglfw;
 
-import org.lwjgl.BufferUtils;
+import org.lwjgl.system.MemoryStack;
 
 import java.nio.IntBuffer;
 
+import static org.lwjgl.system.MemoryStack.*;
 import static org.lwjgl.system.jglfw.JGLFW.*;
 import static org.lwjgl.system.jglfw.WindowUtil.*;
 
@@ -43,16 +44,20 @@ final class InputUtil {
 				cursorPosX = window.cursorPosX;
 				cursorPosY = window.cursorPosY;
 
-				// TODO: optimize
-				IntBuffer widthOut = BufferUtils.createIntBuffer(1);
-				IntBuffer heightOut = BufferUtils.createIntBuffer(1);
+				MemoryStack stack = stackPush();
+				try {
+					IntBuffer widthOut = stack.mallocInt(1);
+					IntBuffer heightOut = stack.mallocInt(1);
 
-				platform.getWindowSize(window, widthOut, heightOut);
+					platform.getWindowSize(window, widthOut, heightOut);
 
-				int width = widthOut.get(0);
-				int height = heightOut.get(0);
+					int width = widthOut.get(0);
+					int height = heightOut.get(0);
 
-				platform.setCursorPos(window, width / 2.0, height / 2.0);
+					platform.setCursorPos(window, width / 2.0, height / 2.0);
+				} finally {
+					stack.pop();
+				}
 			}
 		}
 
@@ -10,6 +10,7 @@ import org.lwjgl.PointerBuffer;
 import org.lwjgl.opengl.GL;
 import org.lwjgl.system.APIBuffer;
 import org.lwjgl.system.FunctionProvider;
+import org.lwjgl.system.MemoryStack;
 import org.lwjgl.system.glfw.GLFWgammaramp;
 import org.lwjgl.system.linux.*;
 import org.lwjgl.system.linux.opengl.LinuxGLContext;
@@ -37,6 +38,7 @@ import static org.lwjgl.opengl.GLXEXTSwapControl.*;
 import static org.lwjgl.opengl.GLXSGISwapControl.*;
 import static org.lwjgl.opengl.GLXSGIXFBConfig.*;
 import static org.lwjgl.system.APIUtil.*;
+import static org.lwjgl.system.MemoryStack.*;
 import static org.lwjgl.system.MemoryUtil.*;
 import static org.lwjgl.system.jglfw.GLFWwindowLinux.*;
 import static org.lwjgl.system.jglfw.JGLFW.*;
@@ -592,35 +594,40 @@ class PlatformLinux implements Platform<GLFWwindowLinux> {
 	public void pollEvents() {
 		int count = XPending(x11.display);
 
-		ByteBuffer event = XEvent.malloc();
-		while ( count-- > 0 ) {
-			zeroBuffer(event);
-			XNextEvent(x11.display, event);
-			processEvent(event);
-		}
+		MemoryStack stack = stackPush();
+		try {
+			ByteBuffer event = stack.malloc(XEvent.SIZEOF);
+			while ( count-- > 0 ) {
+				zeroBuffer(event);
+				XNextEvent(x11.display, event);
+				processEvent(event);
+			}
 
-		// Check whether the cursor has moved inside an focused window that has
-		// captured the cursor (because then it needs to be re-centered)
+			// Check whether the cursor has moved inside an focused window that has
+			// captured the cursor (because then it needs to be re-centered)
 
-		GLFWwindowLinux window = focusedWindow;
-		if ( window != null ) {
-			if ( window.cursorMode == GLFW_CURSOR_CAPTURED && !window.cursorCentered ) {
-				IntBuffer widthOut = BufferUtils.createIntBuffer(1);
-				IntBuffer heightOut = BufferUtils.createIntBuffer(1);
+			GLFWwindowLinux window = focusedWindow;
+			if ( window != null ) {
+				if ( window.cursorMode == GLFW_CURSOR_CAPTURED && !window.cursorCentered ) {
+					IntBuffer widthOut = stack.mallocInt(1);
+					IntBuffer heightOut = stack.mallocInt(1);
 
-				getWindowSize(window, widthOut, heightOut);
+					getWindowSize(window, widthOut, heightOut);
 
-				int width = widthOut.get(0);
-				int height = heightOut.get(0);
+					int width = widthOut.get(0);
+					int height = heightOut.get(0);
 
-				setCursorPos(window, width / 2, height / 2);
-				window.cursorCentered = true;
+					setCursorPos(window, width / 2, height / 2);
+					window.cursorCentered = true;
 
-				// NOTE: This is a temporary fix.  It works as long as you use
-				//       offsets accumulated over the course of a frame, instead of
-				//       performing the necessary actions per callback call.
-				XFlush(x11.display);
+					// NOTE: This is a temporary fix.  It works as long as you use
+					//       offsets accumulated over the course of a frame, instead of
+					//       performing the necessary actions per callback call.
+					XFlush(x11.display);
+				}
 			}
+		} finally {
+			stack.pop();
 		}
 	}
 
@@ -791,7 +798,7 @@ class PlatformLinux implements Platform<GLFWwindowLinux> {
 			XDeleteProperty(x11.display, XEvent.xselectionRequestorGet(event), XEvent.xselectionPropertyGet(event));
 
 			if ( __buffer.pointerValue(actualType) == XEvent.xselectionTargetGet(event) )
-				x11.selection.string = memDecodeUTF8(memByteBufferNT1(__buffer.pointerValue(data)));
+				x11.selection.string = memDecodeUTF8(__buffer.pointerValue(data));
 
 			nXFree(__buffer.pointerValue(data));
 
@@ -1440,7 +1447,7 @@ class PlatformLinux implements Platform<GLFWwindowLinux> {
 		glx.GetVisualFromFBConfig = functionProvider.getFunctionAddress("glXGetVisualFromFBConfig");
 		glx.CreateNewContext = functionProvider.getFunctionAddress("glXCreateNewContext");
 
-		String extensionsString = memDecodeASCII(memByteBufferNT1(nglXQueryExtensionsString(x11.display, x11.screen, glx.QueryExtensionsString)));
+		String extensionsString = memDecodeASCII(nglXQueryExtensionsString(x11.display, x11.screen, glx.QueryExtensionsString));
 		Set<String> extensions = new HashSet<String>(32);
 		StringTokenizer tokenizer = new StringTokenizer(extensionsString);
 		while ( tokenizer.hasMoreTokens() )
@@ -2182,7 +2189,7 @@ class PlatformLinux implements Platform<GLFWwindowLinux> {
 		if ( ioctl(fd, JSIOCGNAME(256), __buffer.address()) < 0 )
 			x11.joystick[joy].name = "Unknown";
 		else
-			x11.joystick[joy].name = memDecodeUTF8(memByteBufferNT1(__buffer.address()));
+			x11.joystick[joy].name = memDecodeUTF8(__buffer.address());
 
 		ioctl(fd, JSIOCGAXES(), __buffer.address());
 		x11.joystick[joy].numAxes = __buffer.intValue(0);
@@ -2213,48 +2220,51 @@ class PlatformLinux implements Platform<GLFWwindowLinux> {
 
 	// Polls for and processes events for all present joysticks
 	static void pollJoystickEvents() {
-		ByteBuffer e = JSEvent.malloc();
-
-		for ( int i = 0; i <= GLFW_JOYSTICK_LAST; i++ ) {
-			if ( !x11.joystick[i].present )
-				continue;
+		ByteBuffer e = JSEvent.allocate();
+		try {
+			for ( int i = 0; i <= GLFW_JOYSTICK_LAST; i++ ) {
+				if ( !x11.joystick[i].present )
+					continue;
 
-			// Read all queued events (non-blocking)
-			for (; ; ) {
-				int errno = 0;
-				long result = read(x11.joystick[i].fd, e, JSEvent.SIZEOF);
+				// Read all queued events (non-blocking)
+				for (; ; ) {
+					int errno = 0;
+					long result = read(x11.joystick[i].fd, e, JSEvent.SIZEOF);
 
-				// LWJGL TODO: what?
-				if ( errno == 19 ) // ENODEV: No such device
-					x11.joystick[i].present = false;
+					// LWJGL TODO: what?
+					if ( errno == 19 ) // ENODEV: No such device
+						x11.joystick[i].present = false;
 
-				if ( result == -1 )
-					break;
+					if ( result == -1 )
+						break;
 
-				// We don't care if it's an init event or not
-				JSEvent.typeSet(e, JSEvent.typeGet(e) & ~JS_EVENT_INIT);
+					// We don't care if it's an init event or not
+					JSEvent.typeSet(e, JSEvent.typeGet(e) & ~JS_EVENT_INIT);
 
-				int number = JSEvent.numberGet(e);
-				switch ( JSEvent.typeGet(e) ) {
-					case JS_EVENT_AXIS:
-						x11.joystick[i].axis.put(number, (float)JSEvent.valueGet(e) / 32767.0f);
+					int number = JSEvent.numberGet(e);
+					switch ( JSEvent.typeGet(e) ) {
+						case JS_EVENT_AXIS:
+							x11.joystick[i].axis.put(number, (float)JSEvent.valueGet(e) / 32767.0f);
 
-						// We need to change the sign for the Y axes, so that
-						// positive = up/forward, according to the GLFW spec.
-						if ( (number & 1) == 1 ) {
-							x11.joystick[i].axis.put(number, -x11.joystick[i].axis.get(number));
-						}
+							// We need to change the sign for the Y axes, so that
+							// positive = up/forward, according to the GLFW spec.
+							if ( (number & 1) == 1 ) {
+								x11.joystick[i].axis.put(number, -x11.joystick[i].axis.get(number));
+							}
 
-						break;
+							break;
 
-					case JS_EVENT_BUTTON:
-						x11.joystick[i].button.put(number, (byte)(JSEvent.valueGet(e) != 0 ? GLFW_PRESS : GLFW_RELEASE));
-						break;
+						case JS_EVENT_BUTTON:
+							x11.joystick[i].button.put(number, (byte)(JSEvent.valueGet(e) != 0 ? GLFW_PRESS : GLFW_RELEASE));
+							break;
 
-					default:
-						break;
+						default:
+							break;
+					}
 				}
 			}
+		} finally {
+			JSEvent.release(e);
 		}
 	}
 
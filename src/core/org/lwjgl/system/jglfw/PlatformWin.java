@@ -12,6 +12,7 @@ import org.lwjgl.opengl.GL;
 import org.lwjgl.opengl.GL11;
 import org.lwjgl.system.APIBuffer;
 import org.lwjgl.system.FunctionProvider;
+import org.lwjgl.system.MemoryStack;
 import org.lwjgl.system.windows.*;
 import org.lwjgl.system.windows.opengl.WindowsGLContext;
 
@@ -31,6 +32,7 @@ import static org.lwjgl.opengl.WGLARBPixelFormat.*;
 import static org.lwjgl.opengl.WGLEXTSwapControl.*;
 import static org.lwjgl.system.APIUtil.*;
 import static org.lwjgl.system.MathUtil.*;
+import static org.lwjgl.system.MemoryStack.*;
 import static org.lwjgl.system.MemoryUtil.*;
 import static org.lwjgl.system.jglfw.InputUtil.*;
 import static org.lwjgl.system.jglfw.JGLFW.*;
@@ -707,7 +709,7 @@ class PlatformWin implements Platform<GLFWwindowWin> {
 			return null;
 		}
 
-		String string = memDecodeUTF16(memByteBufferNT2(GlobalLock(stringHandle)));
+		String string = memDecodeUTF16(GlobalLock(stringHandle));
 
 		GlobalUnlock(stringHandle);
 		CloseClipboard();
@@ -757,13 +759,18 @@ class PlatformWin implements Platform<GLFWwindowWin> {
 		if ( window.monitor != null ) {
 			window.dwStyle |= WS_POPUP;
 
-			IntBuffer xposOut = BufferUtils.createIntBuffer(1);
-			IntBuffer yposOut = BufferUtils.createIntBuffer(1);
+			MemoryStack stack = stackPush();
+			try {
+				IntBuffer xposOut = stack.mallocInt(1);
+				IntBuffer yposOut = stack.mallocInt(1);
 
-			getMonitorPos(wndconfig.monitor, xposOut, yposOut);
+				getMonitorPos(wndconfig.monitor, xposOut, yposOut);
 
-			xpos = xposOut.get(0);
-			ypos = yposOut.get(0);
+				xpos = xposOut.get(0);
+				ypos = yposOut.get(0);
+			} finally {
+				stack.pop();
+			}
 
 			fullWidth = wndconfig.width;
 			fullHeight = wndconfig.height;
@@ -813,11 +820,16 @@ class PlatformWin implements Platform<GLFWwindowWin> {
 			return false;
 		}
 
-		ByteBuffer cursorPos = POINT.malloc();
-		GetCursorPos(cursorPos);
-		ScreenToClient(window.handle, cursorPos);
-		window.cursorPosX = window.oldCursorX = POINT.xGet(cursorPos);
-		window.cursorPosY = window.oldCursorY = POINT.yGet(cursorPos);
+		MemoryStack stack = stackPush();
+		try {
+			ByteBuffer cursorPos = stack.malloc(POINT.SIZEOF);
+			GetCursorPos(cursorPos);
+			ScreenToClient(window.handle, cursorPos);
+			window.cursorPosX = window.oldCursorX = POINT.xGet(cursorPos);
+			window.cursorPosY = window.oldCursorY = POINT.yGet(cursorPos);
+		} finally {
+			stack.pop();
+		}
 
 		return createContext(window, wndconfig, fbconfig);
 	}
@@ -8,6 +8,7 @@ import org.lwjgl.system.DynamicLinkLibrary;
 
 import java.nio.ByteBuffer;
 
+import static org.lwjgl.system.MemoryUtil.*;
 import static org.lwjgl.system.linux.DynamicLinkLoader.*;
 
 /** Implements a {@link DynamicLinkLibrary} on the Linux OS. */
@@ -44,9 +45,32 @@ public class LinuxLibrary implements DynamicLinkLibrary {
 		return dlsym(handle, name);
 	}
 
+	/**
+	 * Returns the addresses of multiple functions in the library, with a single native call.
+	 *
+	 * @param names     the function names, as consecutive null-terminated ASCII strings, starting at the current buffer position
+	 * @param count     the number of function names
+	 * @param addresses the address of a table of {@code count} 8-byte values, that will receive the function addresses. Missing functions are set to 0L.
+	 */
+	public void getFunctionAddresses(ByteBuffer names, int count, long addresses) {
+		nGetFunctionAddresses(handle, memAddress(names), count, addresses, NULL);
+	}
+
+	/**
+	 * Like {@link #getFunctionAddresses(ByteBuffer, int, long)}, but each function is first looked up with a {@code glXGetProcAddress}-like function,
+	 * with {@code dlsym} as the fallback. This is done in a single native call too.
+	 *
+	 * @param getProcAddress the address of a function with the {@code void *(*)(const char *)} signature, or {@link org.lwjgl.system.MemoryUtil#NULL}
+	 */
+	public void getFunctionAddresses(ByteBuffer names, int count, long addresses, long getProcAddress) {
+		nGetFunctionAddresses(handle, memAddress(names), count, addresses, getProcAddress);
+	}
+
 	@Override
 	public void destroy() {
 		dlclose(handle);
 	}
 
+	private static native void nGetFunctionAddresses(long handle, long names, int count, long addresses, long getProcAddress);
+
 }
\ No newline at end of file
@@ -5,9 +5,11 @@
 package org.lwjgl.system.macosx;
 
 import org.lwjgl.system.DynamicLinkLibrary;
+import org.lwjgl.system.MemoryStack;
 
 import java.nio.ByteBuffer;
 
+import static org.lwjgl.system.MemoryStack.*;
 import static org.lwjgl.system.MemoryUtil.*;
 import static org.lwjgl.system.macosx.CoreFoundation.*;
 
@@ -65,7 +67,12 @@ public class MacOSXLibrary implements DynamicLinkLibrary {
 
 	@Override
 	public long getFunctionAddress(String name) {
-		return getFunctionAddress(memEncodeASCII(name));
+		MemoryStack stack = stackPush();
+		try {
+			return getFunctionAddress(stack.ASCII(name));
+		} finally {
+			stack.pop();
+		}
 	}
 
 	@Override
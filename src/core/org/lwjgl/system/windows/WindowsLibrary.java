@@ -6,9 +6,11 @@ package org.lwjgl.system.windows;
 
 import org.lwjgl.Sys;
 import org.lwjgl.system.DynamicLinkLibrary;
+import org.lwjgl.system.MemoryStack;
 
 import java.nio.ByteBuffer;
 
+import static org.lwjgl.system.MemoryStack.*;
 import static org.lwjgl.system.MemoryUtil.*;
 import static org.lwjgl.system.windows.WinBase.*;
 import static org.lwjgl.system.windows.WindowsPlatform.*;
@@ -52,7 +54,12 @@ public class WindowsLibrary implements DynamicLinkLibrary {
 
 	@Override
 	public long getFunctionAddress(String name) {
-		return GetProcAddress(handle, memEncodeASCII(name));
+		MemoryStack stack = stackPush();
+		try {
+			return GetProcAddress(handle, stack.ASCII(name));
+		} finally {
+			stack.pop();
+		}
 	}
 
 	@Override
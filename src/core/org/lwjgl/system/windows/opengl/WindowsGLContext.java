@@ -1,15 +1,16 @@
 package org.lwjgl.system.windows.opengl;
 
-import org.lwjgl.BufferUtils;
 import org.lwjgl.opengl.ContextCapabilities;
 import org.lwjgl.opengl.GL;
 import org.lwjgl.opengl.GLContext;
+import org.lwjgl.system.MemoryStack;
 
 import java.nio.IntBuffer;
 
 import static org.lwjgl.opengl.WGLARBCreateContext.*;
 import static org.lwjgl.opengl.WGLARBCreateContextProfile.*;
 import static org.lwjgl.opengl.WGLARBMakeCurrentRead.*;
+import static org.lwjgl.system.MemoryStack.*;
 import static org.lwjgl.system.MemoryUtil.*;
 import static org.lwjgl.system.windows.WGL.*;
 import static org.lwjgl.system.windows.WinBase.*;
@@ -98,24 +99,32 @@ public class WindowsGLContext extends GLContext {
 	}
 
 	private static WindowsGLContext createARB(long hdc) {
-		IntBuffer attribs = BufferUtils.createIntBuffer(16);
+		long hglrc;
 
-		/*attribs.put(WGL_CONTEXT_MAJOR_VERSION_ARB);
-		attribs.put(4);
+		MemoryStack stack = stackPush();
+		try {
+			IntBuffer attribs = stack.mallocInt(16);
+
+			/*attribs.put(WGL_CONTEXT_MAJOR_VERSION_ARB);
+			attribs.put(4);
+
+			attribs.put(WGL_CONTEXT_MINOR_VERSION_ARB);
+			attribs.put(2);*/
 
-		attribs.put(WGL_CONTEXT_MINOR_VERSION_ARB);
-		attribs.put(2);*/
+			attribs.put(WGL_CONTEXT_FLAGS_ARB);
+			attribs.put(WGL_CONTEXT_DEBUG_BIT_ARB);
 
-		attribs.put(WGL_CONTEXT_FLAGS_ARB);
-		attribs.put(WGL_CONTEXT_DEBUG_BIT_ARB);
+			attribs.put(WGL_CONTEXT_PROFILE_MASK_ARB);
+			attribs.put(WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB);
 
-		attribs.put(WGL_CONTEXT_PROFILE_MASK_ARB);
-		attribs.put(WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB);
+			attribs.put(0);
+			attribs.flip();
 
-		attribs.put(0);
-		attribs.flip();
+			hglrc = wglCreateContextAttribsARB(hdc, NULL, attribs);
+		} finally {
+			stack.pop();
+		}
 
-		long hglrc = wglCreateContextAttribsARB(hdc, NULL, attribs);
 		if ( hglrc == NULL )
 			throw new RuntimeException("Failed to create OpenGL context.");
 
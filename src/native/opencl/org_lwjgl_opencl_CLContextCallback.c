@@ -15,13 +15,9 @@ static void CL_CALLBACK CLContextCallbackFunction(
 ) {
 	jobject callback;
 
-	JNIEnv *env = getThreadEnv();
-	jboolean async = env == NULL;
-	if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL )
-            return;
-	}
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	// user_data is a weak global reference
 	callback = (*env)->NewLocalRef(env, (jweak)user_data);
@@ -31,11 +27,9 @@ static void CL_CALLBACK CLContextCallbackFunction(
 	        (jlong)(intptr_t)private_info,
 	        (jlong)cb
 	    );
+	    checkCallbackException(env);
 	    (*env)->DeleteLocalRef(env, callback);
     }
-
-	if ( async )
-        detachCurrentThread();
 }
 
 // setCallback(Ljava/lang/reflect/Method;)J
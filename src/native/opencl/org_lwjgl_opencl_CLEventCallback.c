@@ -12,24 +12,18 @@ static void CL_CALLBACK CLEventCallbackFunction(
 	cl_int event_command_exec_status,
 	void *user_data
 ) {
-	JNIEnv *env = getThreadEnv();
-	jboolean async = env == NULL;
-	if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL )
-            return;
-	}
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
     (*env)->CallVoidMethod(env, (jobject)user_data, CLEventCallbackMethod,
         (jlong)(intptr_t)event,
         (jint)event_command_exec_status
     );
+	checkCallbackException(env);
 
 	// Delete the global reference, will not be needed anymore
 	(*env)->DeleteGlobalRef(env, (jobject)user_data);
-
-	if ( async )
-        detachCurrentThread();
 }
 
 // setCallback(Ljava/lang/reflect/Method;)J
@@ -13,24 +13,18 @@ static void CL_CALLBACK CLNativeKernelFunction(
 	// Grab the native kernel object from the first args slot
 	jobject kernel = (jobject)*(intptr_t *)args;
 
-	JNIEnv *env = getThreadEnv();
-	jboolean async = env == NULL;
-	if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL )
-            return;
-	}
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
     (*env)->CallVoidMethod(env, kernel, CLNativeKernelMethod,
         // Skip the native kernel object
         (jlong)((intptr_t)args + sizeof(jobject))
     );
+	checkCallbackException(env);
 
 	// Delete the global reference, will not be needed anymore
 	(*env)->DeleteGlobalRef(env, kernel);
-
-	if ( async )
-        detachCurrentThread();
 }
 
 // setCallback(Ljava/lang/reflect/Method;)J
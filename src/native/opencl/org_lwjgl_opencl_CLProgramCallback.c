@@ -11,23 +11,17 @@ static void CL_CALLBACK CLProgramCallbackFunction(
 	cl_program program,
 	void *user_data
 ) {
-	JNIEnv *env = getThreadEnv();
-	jboolean async = env == NULL;
-	if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL )
-            return;
-	}
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
     (*env)->CallVoidMethod(env, (jobject)user_data, CLProgramCallbackMethod,
         (jlong)(intptr_t)program
     );
+	checkCallbackException(env);
 
 	// Delete the global reference, will not be needed anymore
 	(*env)->DeleteGlobalRef(env, (jobject)user_data);
-
-	if ( async )
-        detachCurrentThread();
 }
 
 // setCallback(Ljava/lang/reflect/Method;)J
@@ -0,0 +1,24 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+#ifndef __LWJGL_GLCOMMANDBUFFER_H__
+#define __LWJGL_GLCOMMANDBUFFER_H__
+
+#include "common_tools.h"
+
+// A GLCommandBuffer slot. Values are written by Java at the start of the slot, so the union members line up on both byte orders.
+typedef union {
+	jboolean z;
+	jbyte b;
+	jshort s;
+	jint i;
+	jlong j;
+	jfloat f;
+	jdouble d;
+} GLCommandSlot;
+
+// Executes the command that starts at cmd and returns the start of the next command.
+typedef const GLCommandSlot *(*GLCommandPROC)(const GLCommandSlot *cmd);
+
+#endif
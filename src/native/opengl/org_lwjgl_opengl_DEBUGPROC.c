@@ -8,13 +8,9 @@
 static jmethodID DEBUGPROCMethod;
 
 static void APIENTRY DEBUGPROCFunction(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, GLvoid* userParam) {
-	JNIEnv *env = getThreadEnv();
-	jboolean async = env == NULL;
-	if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL )
-            return;
-	}
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
     (*env)->CallVoidMethod(env, (jobject)userParam, DEBUGPROCMethod,
         (jint)source,
@@ -24,9 +20,7 @@ static void APIENTRY DEBUGPROCFunction(GLenum source, GLenum type, GLuint id, GL
         (jint)length,
         (jlong)(intptr_t)message
     );
-
-	if ( async )
-        detachCurrentThread();
+	checkCallbackException(env);
 }
 
 // setCallback(Ljava/lang/reflect/Method;)J
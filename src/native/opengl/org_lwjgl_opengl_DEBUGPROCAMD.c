@@ -8,13 +8,9 @@
 static jmethodID DEBUGPROCAMDMethod;
 
 static void APIENTRY DEBUGPROCAMDFunction(GLuint id, GLenum category, GLenum severity, GLsizei length, const GLchar* message, GLvoid* userParam) {
-	JNIEnv *env = (getThreadEnv());
-	jboolean async = (env == NULL);
-	if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL )
-            return;
-	}
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
     (*env)->CallVoidMethod(env, (jobject)userParam, DEBUGPROCAMDMethod,
         (jint)id,
@@ -23,9 +19,7 @@ static void APIENTRY DEBUGPROCAMDFunction(GLuint id, GLenum category, GLenum sev
         (jint)length,
         (jlong)(intptr_t)message
     );
-
-	if ( async )
-        detachCurrentThread();
+	checkCallbackException(env);
 }
 
 // setCallback(Ljava/lang/reflect/Method;)J
@@ -0,0 +1,17 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+#include "common_tools.h"
+#include "GLCommandBuffer.h"
+
+// nExecute(JJ)V
+JNIEXPORT void JNICALL Java_org_lwjgl_opengl_GLCommandBuffer_nExecute(JNIEnv *env, jclass clazz,
+	jlong address, jlong end
+) {
+	const GLCommandSlot *cmd = (const GLCommandSlot *)(intptr_t)address;
+	const GLCommandSlot *last = (const GLCommandSlot *)(intptr_t)end;
+
+	while ( cmd < last )
+		cmd = ((GLCommandPROC)(intptr_t)cmd->j)(cmd);
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+#include "common_tools.h"
+#include "OpenGL.h"
+
+#include <string.h>
+
+#ifdef LWJGL_WINDOWS
+	#define compareAndSwap(ptr, expected, value) (InterlockedCompareExchange((volatile LONG *)(ptr), (value), (expected)) == (expected))
+	#define atomicIncrement(ptr) InterlockedIncrement((volatile LONG *)(ptr))
+	#define memoryBarrier() MemoryBarrier()
+#else
+	#define compareAndSwap(ptr, expected, value) __sync_bool_compare_and_swap((ptr), (expected), (value))
+	#define atomicIncrement(ptr) __sync_add_and_fetch((ptr), 1)
+	#define memoryBarrier() __sync_synchronize()
+#endif
+
+// Must match the GLDebugMessageCollector ring layout. The ring is a bounded multi-producer/single-consumer queue of fixed-size message slots. Each slot
+// has a sequence number: a producer claims the slot at position p when its sequence is p and publishes it by setting the sequence to p + 1. The
+// consumer releases the slot by setting the sequence to p + capacity.
+typedef struct {
+	volatile jint head; // the next position to claim
+	volatile jint dropped; // the number of messages dropped because the ring was full
+	jint mask; // capacity - 1
+	jint messageSize; // the maximum message length, in bytes
+	jint tail; // the next position to consume
+	jint padding[3];
+	// followed by capacity GLDebugMessageSlot structs
+} GLDebugMessageRing;
+
+typedef struct {
+	volatile jint sequence;
+	jint source;
+	jint type;
+	jint id;
+	jint severity;
+	jint length; // the message length, it may be greater than the ring's message size
+	// followed by messageSize bytes
+} GLDebugMessageSlot;
+
+#define SLOT_SIZE(ring) (sizeof(GLDebugMessageSlot) + (ring)->messageSize)
+#define SLOT(ring, position) ((GLDebugMessageSlot *)((char *)((ring) + 1) + (size_t)((position) & (ring)->mask) * SLOT_SIZE(ring)))
+
+// Copies a message to the ring, without blocking and without calling into the JVM. The message is dropped if the ring is full.
+static void offer(GLDebugMessageRing *ring, jint source, jint type, jint id, jint severity, jint length, const GLchar* message) {
+	GLDebugMessageSlot *slot;
+	jint position;
+
+	if ( length < 0 )
+		length = (jint)strlen(message);
+
+	for ( ;; ) {
+		jint diff;
+
+		position = ring->head;
+		slot = SLOT(ring, position);
+
+		diff = (jint)((unsigned int)slot->sequence - (unsigned int)position);
+		if ( diff == 0 ) {
+			if ( compareAndSwap(&ring->head, position, position + 1) )
+				break;
+		} else if ( diff < 0 ) {
+			// The slot has not been released by the consumer yet
+			atomicIncrement(&ring->dropped);
+			return;
+		}
+		// else another producer claimed the slot, try again
+	}
+
+	slot->source = source;
+	slot->type = type;
+	slot->id = id;
+	slot->severity = severity;
+	slot->length = length;
+	memcpy(slot + 1, message, length < ring->messageSize ? length : ring->messageSize);
+
+	memoryBarrier();
+	slot->sequence = position + 1;
+}
+
+static void APIENTRY GLDebugMessageCollectorFunction(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, GLvoid* userParam) {
+	offer((GLDebugMessageRing *)userParam, (jint)source, (jint)type, (jint)id, (jint)severity, (jint)length, message);
+}
+
+static void APIENTRY GLDebugMessageCollectorFunctionAMD(GLuint id, GLenum category, GLenum severity, GLsizei length, const GLchar* message, GLvoid* userParam) {
+	offer((GLDebugMessageRing *)userParam, 0, (jint)category, (jint)id, (jint)severity, (jint)length, message);
+}
+
+// getCallback()J
+JNIEXPORT jlong JNICALL Java_org_lwjgl_opengl_GLDebugMessageCollector_getCallback(JNIEnv *env, jclass clazz) {
+	return (jlong)(intptr_t)&GLDebugMessageCollectorFunction;
+}
+
+// getCallbackAMD()J
+JNIEXPORT jlong JNICALL Java_org_lwjgl_opengl_GLDebugMessageCollector_getCallbackAMD(JNIEnv *env, jclass clazz) {
+	return (jlong)(intptr_t)&GLDebugMessageCollectorFunctionAMD;
+}
+
+// nDrain(JJI)I
+JNIEXPORT jint JNICALL Java_org_lwjgl_opengl_GLDebugMessageCollector_nDrain(JNIEnv *env, jclass clazz,
+	jlong ringAddress, jlong outputAddress, jint max
+) {
+	GLDebugMessageRing *ring = (GLDebugMessageRing *)(intptr_t)ringAddress;
+	char *output = (char *)(intptr_t)outputAddress;
+	size_t slotSize = SLOT_SIZE(ring);
+	jint count = 0;
+
+	while ( count < max ) {
+		jint position = ring->tail;
+		GLDebugMessageSlot *slot = SLOT(ring, position);
+
+		if ( slot->sequence != position + 1 )
+			break;
+
+		memoryBarrier();
+		memcpy(output, slot, slotSize);
+		output += slotSize;
+
+		memoryBarrier();
+		slot->sequence = position + ring->mask + 1;
+		ring->tail = position + 1;
+
+		count++;
+	}
+
+	return count;
+}
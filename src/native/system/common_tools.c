@@ -3,9 +3,37 @@
  * License terms: http://lwjgl.org/license.php
  */
 #include "common_tools.h"
+#ifdef LWJGL_WINDOWS
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <pthread.h>
+#endif
 
 static JavaVM *jvm;
 
+/*
+ * Foreign threads that call back into Java are attached once, as daemon threads, and stay attached until they exit. The thread-local value below is
+ * set when a thread is attached, its destructor detaches the thread. If the thread-local could not be allocated, foreign threads are still attached
+ * but are never detached.
+ */
+#ifdef LWJGL_WINDOWS
+	static DWORD envKey = FLS_OUT_OF_INDEXES;
+	#define isAttachedThread() (envKey != FLS_OUT_OF_INDEXES && FlsGetValue(envKey) != NULL)
+#else
+	static pthread_key_t envKey;
+	static jboolean envKeyCreated = JNI_FALSE;
+	#define isAttachedThread() (envKeyCreated && pthread_getspecific(envKey) != NULL)
+#endif
+
+#ifdef LWJGL_WINDOWS
+static VOID WINAPI detachCurrentThread(PVOID value) {
+#else
+static void detachCurrentThread(void *value) {
+#endif
+	(*jvm)->DetachCurrentThread(jvm);
+}
+
 JNIEnv *getThreadEnv(void) {
 	JNIEnv *env;
 	(*jvm)->GetEnv(jvm, (void **)&env, JNI_VERSION_1_4);
@@ -13,19 +41,48 @@ JNIEnv *getThreadEnv(void) {
 }
 
 JNIEnv *attachCurrentThread(void) {
-    JNIEnv *env;
-    (*jvm)->AttachCurrentThread(jvm, (void **)&env, NULL);
-    return env;
+	JNIEnv *env;
+	jint status = (*jvm)->GetEnv(jvm, (void **)&env, JNI_VERSION_1_4);
+
+	if ( status == JNI_OK )
+		return env;
+
+	if ( status != JNI_EDETACHED || (*jvm)->AttachCurrentThreadAsDaemon(jvm, (void **)&env, NULL) != JNI_OK )
+		return NULL;
+
+#ifdef LWJGL_WINDOWS
+	if ( envKey != FLS_OUT_OF_INDEXES )
+		FlsSetValue(envKey, env);
+#else
+	if ( envKeyCreated )
+		pthread_setspecific(envKey, env);
+#endif
+
+	return env;
 }
 
-void detachCurrentThread(void) {
-    (*jvm)->DetachCurrentThread(jvm);
+void checkCallbackException(JNIEnv *env) {
+	// There is no Java caller to propagate the exception to in a foreign thread, report it and clear it before returning to native code.
+	if ( (*env)->ExceptionCheck(env) && isAttachedThread() ) {
+		(*env)->ExceptionDescribe(env);
+		(*env)->ExceptionClear(env);
+	}
 }
 
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
-    jvm = vm;
-    return JNI_VERSION_1_4;
+	jvm = vm;
+#ifdef LWJGL_WINDOWS
+	envKey = FlsAlloc(&detachCurrentThread);
+#else
+	envKeyCreated = pthread_key_create(&envKey, &detachCurrentThread) == 0;
+#endif
+	return JNI_VERSION_1_4;
 }
 
 JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved) {
-}
\ No newline at end of file
+#ifndef LWJGL_WINDOWS
+	// FlsFree is not used on Windows, it runs the callbacks of all threads in the calling thread.
+	if ( envKeyCreated )
+		pthread_key_delete(envKey);
+#endif
+}
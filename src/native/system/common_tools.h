@@ -16,8 +16,13 @@
 	#include "MacOSXConfig.h"
 #endif
 
+// Returns the JNIEnv of the current thread, or NULL if the thread is not attached to the JVM.
 extern JNIEnv *getThreadEnv(void);
+// Returns the JNIEnv of the current thread. A foreign thread is attached as a daemon thread on the first call and stays attached until it exits.
+// Returns NULL if the thread could not be attached.
 extern JNIEnv *attachCurrentThread(void);
-extern void detachCurrentThread(void);
+// Must be called after a callback that may run in a foreign thread returns. If the thread was attached by attachCurrentThread, an exception thrown by
+// the callback is reported and cleared. Otherwise, it is left pending and is thrown when the native method returns.
+extern void checkCallbackException(JNIEnv *env);
 
 #endif
\ No newline at end of file
@@ -12,21 +12,14 @@ static void GLFWerrorfunProc(
 	int error,
 	const char* description
 ) {
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL )
-            return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallStaticVoidMethod(
 		env, GLFWerrorfunClass, GLFWerrorfunInvoke,
 		(jint)error, (jlong)(intptr_t)description
 	);
-
-	if ( async )
-		detachCurrentThread();
 }
 
 // setCallback(Ljava/lang/reflect/Method;)J
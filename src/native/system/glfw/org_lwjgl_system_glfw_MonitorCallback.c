@@ -12,21 +12,14 @@ static void GLFWmonitorfunProc(
 	GLFWmonitor* monitor,
 	int event
 ) {
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL )
-            return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallStaticVoidMethod(
 		env, GLFWmonitorfunClass, GLFWmonitorfunInvoke,
 		(jlong)(intptr_t)monitor, (jint)event
 	);
-
-	if ( async )
-		detachCurrentThread();
 }
 
 // setCallback(Ljava/lang/reflect/Method;)J
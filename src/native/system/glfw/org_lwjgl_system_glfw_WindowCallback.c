@@ -21,181 +21,252 @@ static jmethodID GLFWscrollfunInvoke;
 static void GLFWwindowposfunProc(GLFWwindow* window, int xpos, int ypos) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWwindowposfunInvoke, (jlong)(intptr_t)window, (jint)xpos, (jint)ypos);
-
-	if ( async ) detachCurrentThread();
 }
 
 static void GLFWwindowsizefunProc(GLFWwindow* window, int width, int height) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWwindowsizefunInvoke, (jlong)(intptr_t)window, (jint)width, (jint)height);
-
-	if ( async ) detachCurrentThread();
 }
 
 static void GLFWwindowclosefunProc(GLFWwindow* window) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWwindowclosefunInvoke, (jlong)(intptr_t)window);
-
-	if ( async ) detachCurrentThread();
 }
 
 static void GLFWwindowrefreshfunProc(GLFWwindow* window) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWwindowrefreshfunInvoke, (jlong)(intptr_t)window);
-
-	if ( async ) detachCurrentThread();
 }
 
 static void GLFWwindowfocusfunProc(GLFWwindow* window, int focus) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWwindowfocusfunInvoke, (jlong)(intptr_t)window, (jint)focus);
-
-	if ( async ) detachCurrentThread();
 }
 
 static void GLFWwindowiconifyfunProc(GLFWwindow* window, int iconified) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWwindowiconifyfunInvoke, (jlong)(intptr_t)window, (jint)iconified);
-
-	if ( async ) detachCurrentThread();
 }
 
 static void GLFWkeyfunProc(GLFWwindow* window, int key, int action) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWkeyfunInvoke, (jlong)(intptr_t)window, (jint)key, (jint)action);
-
-	if ( async ) detachCurrentThread();
 }
 
 static void GLFWcharfunProc(GLFWwindow* window, int character) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWcharfunInvoke, (jlong)(intptr_t)window, (jint)character);
-
-	if ( async ) detachCurrentThread();
 }
 
 static void GLFWmousebuttonfunProc(GLFWwindow* window, int button, int action) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWmousebuttonfunInvoke, (jlong)(intptr_t)window, (jint)button, (jint)action);
-
-	if ( async ) detachCurrentThread();
 }
 
 static void GLFWcursorposfunProc(GLFWwindow* window, double xpos, double ypos) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWcursorposfunInvoke, (jlong)(intptr_t)window, (jdouble)xpos, (jdouble)ypos);
-
-	if ( async ) detachCurrentThread();
 }
 
 static void GLFWcursorenterfunProc(GLFWwindow* window, int entered) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWcursorenterfunInvoke, (jlong)(intptr_t)window, (jint)entered);
-
-	if ( async ) detachCurrentThread();
 }
 
 static void GLFWscrollfunProc(GLFWwindow* window, double xpos, double ypos) {
 	jobject callback = (jobject)glfwGetWindowUserPointer(window);
 
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) return;
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL )
+		return;
 
 	(*env)->CallVoidMethod(env, callback, GLFWscrollfunInvoke, (jlong)(intptr_t)window, (jdouble)xpos, (jdouble)ypos);
+}
+
+// --- [ Batched events ] ---
+
+// Must match the WindowCallback event types.
+#define WINDOW_POS     (1 << 0)
+#define WINDOW_SIZE    (1 << 1)
+#define WINDOW_CLOSE   (1 << 2)
+#define WINDOW_REFRESH (1 << 3)
+#define WINDOW_FOCUS   (1 << 4)
+#define WINDOW_ICONIFY (1 << 5)
+#define KEY            (1 << 6)
+#define CHARACTER      (1 << 7)
+#define MOUSE_BUTTON   (1 << 8)
+#define CURSOR_POS     (1 << 9)
+#define CURSOR_ENTER   (1 << 10)
+#define SCROLL         (1 << 11)
+
+// Must match the WindowCallback event queue layout. Integer arguments are stored as doubles.
+typedef struct {
+	jlong window;
+	jdouble x;
+	jdouble y;
+	jdouble time;
+	jint type;
+	jint padding;
+} GLFWevent;
+
+typedef struct {
+	jint count;
+	jint capacity;
+	jlong padding;
+	// followed by capacity GLFWevent structs
+} GLFWeventQueue;
+
+static GLFWeventQueue *eventQueue;
+
+static jclass WindowCallbackClass;
+static jmethodID WindowCallbackFlushEventQueue;
+
+// Appends an event to the queue. If the queue is full, it is drained first, or grows if it is being drained (i.e. we're inside a callback), so that
+// events are always dispatched in order. Returns JNI_FALSE if the event could not be queued, it must be dispatched directly in that case.
+static jboolean queueEvent(GLFWwindow* window, jint type, jdouble x, jdouble y) {
+	GLFWevent *event;
+
+	if ( eventQueue->count == eventQueue->capacity ) {
+		jlong queue;
+		JNIEnv *env = attachCurrentThread();
+		if ( env == NULL )
+			return JNI_FALSE;
+
+		queue = (*env)->CallStaticLongMethod(env, WindowCallbackClass, WindowCallbackFlushEventQueue);
+
+		// The queue could not grow, e.g. because of an OutOfMemoryError.
+		if ( (*env)->ExceptionCheck(env) )
+			return JNI_FALSE;
+
+		eventQueue = (GLFWeventQueue *)(intptr_t)queue;
+		if ( eventQueue->count == eventQueue->capacity )
+			return JNI_FALSE;
+	}
+
+	event = (GLFWevent *)(eventQueue + 1) + eventQueue->count;
+	event->window = (jlong)(intptr_t)window;
+	event->x = x;
+	event->y = y;
+	event->time = glfwGetTime();
+	event->type = type;
+
+	eventQueue->count++;
+	return JNI_TRUE;
+}
+
+static void GLFWwindowposfunQueue(GLFWwindow* window, int xpos, int ypos) {
+	if ( !queueEvent(window, WINDOW_POS, xpos, ypos) )
+		GLFWwindowposfunProc(window, xpos, ypos);
+}
+
+static void GLFWwindowsizefunQueue(GLFWwindow* window, int width, int height) {
+	if ( !queueEvent(window, WINDOW_SIZE, width, height) )
+		GLFWwindowsizefunProc(window, width, height);
+}
+
+static void GLFWwindowclosefunQueue(GLFWwindow* window) {
+	if ( !queueEvent(window, WINDOW_CLOSE, 0.0, 0.0) )
+		GLFWwindowclosefunProc(window);
+}
+
+static void GLFWwindowrefreshfunQueue(GLFWwindow* window) {
+	if ( !queueEvent(window, WINDOW_REFRESH, 0.0, 0.0) )
+		GLFWwindowrefreshfunProc(window);
+}
+
+static void GLFWwindowfocusfunQueue(GLFWwindow* window, int focused) {
+	if ( !queueEvent(window, WINDOW_FOCUS, focused, 0.0) )
+		GLFWwindowfocusfunProc(window, focused);
+}
+
+static void GLFWwindowiconifyfunQueue(GLFWwindow* window, int iconified) {
+	if ( !queueEvent(window, WINDOW_ICONIFY, iconified, 0.0) )
+		GLFWwindowiconifyfunProc(window, iconified);
+}
+
+static void GLFWkeyfunQueue(GLFWwindow* window, int key, int action) {
+	if ( !queueEvent(window, KEY, key, action) )
+		GLFWkeyfunProc(window, key, action);
+}
+
+static void GLFWcharfunQueue(GLFWwindow* window, int character) {
+	if ( !queueEvent(window, CHARACTER, character, 0.0) )
+		GLFWcharfunProc(window, character);
+}
+
+static void GLFWmousebuttonfunQueue(GLFWwindow* window, int button, int action) {
+	if ( !queueEvent(window, MOUSE_BUTTON, button, action) )
+		GLFWmousebuttonfunProc(window, button, action);
+}
 
-	if ( async ) detachCurrentThread();
+static void GLFWcursorposfunQueue(GLFWwindow* window, double xpos, double ypos) {
+	if ( !queueEvent(window, CURSOR_POS, xpos, ypos) )
+		GLFWcursorposfunProc(window, xpos, ypos);
+}
+
+static void GLFWcursorenterfunQueue(GLFWwindow* window, int entered) {
+	if ( !queueEvent(window, CURSOR_ENTER, entered, 0.0) )
+		GLFWcursorenterfunProc(window, entered);
+}
+
+static void GLFWscrollfunQueue(GLFWwindow* window, double xpos, double ypos) {
+	if ( !queueEvent(window, SCROLL, xpos, ypos) )
+		GLFWscrollfunProc(window, xpos, ypos);
 }
 
 // setCallbacks([Ljava/lang/reflect/Method;J)V
@@ -231,4 +302,29 @@ JNIEXPORT void JNICALL Java_org_lwjgl_system_glfw_WindowCallback_setCallbacks(JN
 	procs[i++] = (intptr_t)&GLFWcursorposfunProc;
 	procs[i++] = (intptr_t)&GLFWcursorenterfunProc;
     procs[i] = (intptr_t)&GLFWscrollfunProc;
+}
+
+// setEventQueue(Ljava/lang/reflect/Method;JJ)V
+JNIEXPORT void JNICALL Java_org_lwjgl_system_glfw_WindowCallback_setEventQueue(JNIEnv *env, jclass clazz,
+	jobject flushEventQueue, jlong queueAddress, jlong procsAddress
+) {
+	intptr_t *procs = (intptr_t *)procsAddress;
+	jint i = 0;
+
+	WindowCallbackClass = (*env)->NewGlobalRef(env, clazz);
+	WindowCallbackFlushEventQueue = (*env)->FromReflectedMethod(env, flushEventQueue);
+	eventQueue = (GLFWeventQueue *)(intptr_t)queueAddress;
+
+	procs[i++] = (intptr_t)&GLFWwindowposfunQueue;
+	procs[i++] = (intptr_t)&GLFWwindowsizefunQueue;
+	procs[i++] = (intptr_t)&GLFWwindowclosefunQueue;
+	procs[i++] = (intptr_t)&GLFWwindowrefreshfunQueue;
+	procs[i++] = (intptr_t)&GLFWwindowfocusfunQueue;
+	procs[i++] = (intptr_t)&GLFWwindowiconifyfunQueue;
+	procs[i++] = (intptr_t)&GLFWkeyfunQueue;
+	procs[i++] = (intptr_t)&GLFWcharfunQueue;
+	procs[i++] = (intptr_t)&GLFWmousebuttonfunQueue;
+	procs[i++] = (intptr_t)&GLFWcursorposfunQueue;
+	procs[i++] = (intptr_t)&GLFWcursorenterfunQueue;
+	procs[i] = (intptr_t)&GLFWscrollfunQueue;
 }
\ No newline at end of file
@@ -0,0 +1,110 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+#define _GNU_SOURCE
+#include "common_tools.h"
+#include <dlfcn.h>
+#include <link.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifndef NT_GNU_BUILD_ID
+	#define NT_GNU_BUILD_ID 3
+#endif
+
+// Must match the layout read by PersistentCache.SharedObject.get
+typedef struct {
+	jlong base;
+	jlong inode;
+	jlong mtime;
+	jlong size;
+	jint buildIdLength;
+	jbyte buildId[64];
+} SharedObjectInfo;
+
+typedef struct {
+	const char *name;
+	SharedObjectInfo *info;
+	jboolean found;
+} SharedObjectQuery;
+
+static void readBuildId(struct dl_phdr_info *phdr, const ElfW(Phdr) *note, SharedObjectInfo *info) {
+	const char *p = (const char *)(phdr->dlpi_addr + note->p_vaddr);
+	const char *end = p + note->p_memsz;
+
+	while ( p + sizeof(ElfW(Nhdr)) <= end ) {
+		const ElfW(Nhdr) *nhdr = (const ElfW(Nhdr) *)p;
+		const char *name = p + sizeof(ElfW(Nhdr));
+		const char *desc = name + ((nhdr->n_namesz + 3) & ~3);
+
+		if ( nhdr->n_type == NT_GNU_BUILD_ID && nhdr->n_namesz == 4 && memcmp(name, "GNU", 4) == 0 ) {
+			jint length = (jint)nhdr->n_descsz;
+			if ( (jint)sizeof(info->buildId) < length )
+				length = (jint)sizeof(info->buildId);
+
+			memcpy(info->buildId, desc, (size_t)length);
+			info->buildIdLength = length;
+			return;
+		}
+
+		p = desc + ((nhdr->n_descsz + 3) & ~3);
+	}
+}
+
+static int findSharedObject(struct dl_phdr_info *phdr, size_t size, void *data) {
+	SharedObjectQuery *query = (SharedObjectQuery *)data;
+	jboolean baseFound = JNI_FALSE;
+	int i;
+
+	if ( phdr->dlpi_name == NULL || strcmp(phdr->dlpi_name, query->name) != 0 )
+		return 0;
+
+	for ( i = 0; i < phdr->dlpi_phnum; i++ ) {
+		const ElfW(Phdr) *segment = &phdr->dlpi_phdr[i];
+		if ( segment->p_type == PT_LOAD && !baseFound ) {
+			// The address where the start of the file is mapped
+			query->info->base = (jlong)(intptr_t)(phdr->dlpi_addr + (segment->p_vaddr - segment->p_offset));
+			baseFound = JNI_TRUE;
+		} else if ( segment->p_type == PT_NOTE && query->info->buildIdLength == 0 )
+			readBuildId(phdr, segment, query->info);
+	}
+
+	query->found = baseFound;
+	return 1;
+}
+
+// nSharedObjectName(J)J
+JNIEXPORT jlong JNICALL Java_org_lwjgl_system_PersistentCache_nSharedObjectName(JNIEnv *env, jclass clazz,
+	jlong address
+) {
+	Dl_info info;
+	if ( dladdr((void *)(intptr_t)address, &info) == 0 || info.dli_fname == NULL || info.dli_fname[0] == '\0' )
+		return (jlong)(intptr_t)NULL;
+
+	return (jlong)(intptr_t)info.dli_fname;
+}
+
+// nSharedObjectInfo(JJ)Z
+JNIEXPORT jboolean JNICALL Java_org_lwjgl_system_PersistentCache_nSharedObjectInfo(JNIEnv *env, jclass clazz,
+	jlong nameAddress, jlong infoAddress
+) {
+	SharedObjectQuery query;
+	struct stat st;
+
+	query.name = (const char *)(intptr_t)nameAddress;
+	query.info = (SharedObjectInfo *)(intptr_t)infoAddress;
+	query.found = JNI_FALSE;
+
+	memset(query.info, 0, sizeof(SharedObjectInfo));
+
+	dl_iterate_phdr(&findSharedObject, &query);
+	if ( !query.found || stat(query.name, &st) != 0 )
+		return JNI_FALSE;
+
+	query.info->inode = (jlong)st.st_ino;
+	query.info->mtime = (jlong)st.st_mtime;
+	query.info->size = (jlong)st.st_size;
+
+	return JNI_TRUE;
+}
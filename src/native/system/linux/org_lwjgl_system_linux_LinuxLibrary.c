@@ -0,0 +1,29 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+#include "common_tools.h"
+#include <dlfcn.h>
+#include <string.h>
+
+typedef void *(*getProcAddressPROC) (const char *);
+
+// nGetFunctionAddresses(JJIJJ)V
+JNIEXPORT void JNICALL Java_org_lwjgl_system_linux_LinuxLibrary_nGetFunctionAddresses(JNIEnv *env, jclass clazz,
+	jlong handleAddress, jlong namesAddress, jint count, jlong addressesAddress, jlong getProcAddressAddress
+) {
+	void *handle = (void *)(intptr_t)handleAddress;
+	const char *name = (const char *)(intptr_t)namesAddress;
+	jlong *addresses = (jlong *)(intptr_t)addressesAddress;
+	getProcAddressPROC getProcAddress = (getProcAddressPROC)(intptr_t)getProcAddressAddress;
+	jint i;
+
+	for ( i = 0; i < count; i++ ) {
+		void *address = getProcAddress == NULL ? NULL : getProcAddress(name);
+		if ( address == NULL )
+			address = dlsym(handle, name);
+
+		addresses[i] = (jlong)(intptr_t)address;
+		name += strlen(name) + 1;
+	}
+}
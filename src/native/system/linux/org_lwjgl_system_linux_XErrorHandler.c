@@ -13,25 +13,18 @@ static int XErrorHandlerProc(
 	Display* display,
 	XErrorEvent* error_event
 ) {
-	JNIEnv *env = getThreadEnv();
-    jboolean async = env == NULL;
-    if ( async ) {
-        env = attachCurrentThread();
-        if ( env == NULL ) {
-            fprintf (stderr, "[LWJGL] Failed to attach to JVM in XErrorHandler callback.");
-            exit(-1);
-            return 0; // ignored
-		}
-    }
+	JNIEnv *env = attachCurrentThread();
+	if ( env == NULL ) {
+		fprintf (stderr, "[LWJGL] Failed to attach to JVM in XErrorHandler callback.");
+		exit(-1);
+		return 0; // ignored
+	}
 
 	int __result = (*env)->CallStaticIntMethod(
 		env, XErrorHandlerClass, XErrorHandlerInvoke,
 		(jlong)(intptr_t)display, (jlong)(intptr_t)error_event
 	);
 
-	if ( async )
-		detachCurrentThread();
-
 	return __result;
 }
 
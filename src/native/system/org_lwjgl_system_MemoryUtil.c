@@ -2,11 +2,45 @@
  * Copyright LWJGL. All rights reserved.
  * License terms: http://lwjgl.org/license.php
  */
+#ifdef LWJGL_LINUX
+	// Required for MAP_ANONYMOUS, MAP_HUGETLB, MADV_HUGEPAGE and syscall
+	#define _GNU_SOURCE
+#endif
 #include "common_tools.h"
-#ifndef LWJGL_WINDOWS
+#include <stdlib.h>
+#ifdef LWJGL_WINDOWS
+	#include <malloc.h>
+	#include "WindowsLWJGL.h"
+#else
 	#include <string.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
 	//#include <xmmintrin.h>
 #endif
+#ifdef LWJGL_LINUX
+	#include <stdio.h>
+	#include <sys/syscall.h>
+#endif
+#ifdef LWJGL_MACOSX
+	#include <sys/sysctl.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define LWJGL_SSE2
+	#include <emmintrin.h>
+#endif
+
+#define MEM_LARGE_PAGES_TRANSPARENT 1
+#define MEM_LARGE_PAGES_EXPLICIT    2
+
+#define MEM_MAP_READ_ONLY      0
+#define MEM_MAP_COPY_ON_WRITE  1
+
+#define MEM_ADVICE_NORMAL     0
+#define MEM_ADVICE_SEQUENTIAL 1
+#define MEM_ADVICE_RANDOM     2
+#define MEM_ADVICE_WILLNEED   3
+#define MEM_ADVICE_DONTNEED   4
 
 // memPointerSize()I
 JNIEXPORT jint JNICALL Java_org_lwjgl_system_MemoryUtil_memPointerSize(JNIEnv *env, jclass clazz)
@@ -48,6 +82,366 @@ JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_memGlobalRefDeleteWeak(J
 	(*env)->DeleteWeakGlobalRef(env, (jweak)(intptr_t)globalRef);
 }
 
+// nMemAlloc(J)J
+JNIEXPORT jlong JNICALL Java_org_lwjgl_system_MemoryUtil_nMemAlloc(JNIEnv *env, jclass clazz,
+	jlong size
+) {
+	return (jlong)(intptr_t)malloc((size_t)size);
+}
+
+// nMemCalloc(JJ)J
+JNIEXPORT jlong JNICALL Java_org_lwjgl_system_MemoryUtil_nMemCalloc(JNIEnv *env, jclass clazz,
+	jlong num, jlong size
+) {
+	return (jlong)(intptr_t)calloc((size_t)num, (size_t)size);
+}
+
+// nMemRealloc(JJ)J
+JNIEXPORT jlong JNICALL Java_org_lwjgl_system_MemoryUtil_nMemRealloc(JNIEnv *env, jclass clazz,
+	jlong ptr, jlong size
+) {
+	return (jlong)(intptr_t)realloc((void *)(intptr_t)ptr, (size_t)size);
+}
+
+// nMemAlignedAlloc(JJ)J
+JNIEXPORT jlong JNICALL Java_org_lwjgl_system_MemoryUtil_nMemAlignedAlloc(JNIEnv *env, jclass clazz,
+	jlong alignment, jlong size
+) {
+#ifdef LWJGL_WINDOWS
+	return (jlong)(intptr_t)_aligned_malloc((size_t)size, (size_t)alignment);
+#else
+	void *ptr;
+	if ( posix_memalign(&ptr, (size_t)alignment, (size_t)size) != 0 )
+		return (jlong)0;
+	return (jlong)(intptr_t)ptr;
+#endif
+}
+
+// nMemFree(J)V
+JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_nMemFree(JNIEnv *env, jclass clazz,
+	jlong ptr
+) {
+	free((void *)(intptr_t)ptr);
+}
+
+// nMemAlignedFree(J)V
+JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_nMemAlignedFree(JNIEnv *env, jclass clazz,
+	jlong ptr
+) {
+#ifdef LWJGL_WINDOWS
+	_aligned_free((void *)(intptr_t)ptr);
+#else
+	free((void *)(intptr_t)ptr);
+#endif
+}
+
+// nMemPageSize()I
+JNIEXPORT jint JNICALL Java_org_lwjgl_system_MemoryUtil_nMemPageSize(JNIEnv *env, jclass clazz) {
+#ifdef LWJGL_WINDOWS
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (jint)info.dwPageSize;
+#else
+	long pageSize = sysconf(_SC_PAGESIZE);
+	return pageSize <= 0 ? 0 : (jint)pageSize;
+#endif
+}
+
+// nMemCacheLineSize()I
+JNIEXPORT jint JNICALL Java_org_lwjgl_system_MemoryUtil_nMemCacheLineSize(JNIEnv *env, jclass clazz) {
+#if defined(LWJGL_LINUX)
+	long lineSize = 0;
+	#ifdef _SC_LEVEL1_DCACHE_LINESIZE
+		lineSize = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+	#endif
+	if ( lineSize <= 0 ) {
+		// sysconf is not supported or returns 0 on some systems (e.g. ARM), try sysfs instead.
+		FILE *f = fopen("/sys/devices/system/cpu/cpu0/cache/index0/coherency_line_size", "r");
+		if ( f != NULL ) {
+			if ( fscanf(f, "%ld", &lineSize) != 1 )
+				lineSize = 0;
+			fclose(f);
+		}
+	}
+	return lineSize <= 0 ? 0 : (jint)lineSize;
+#elif defined(LWJGL_MACOSX)
+	size_t lineSize = 0;
+	size_t sizeOfLineSize = sizeof(lineSize);
+	if ( sysctlbyname("hw.cachelinesize", &lineSize, &sizeOfLineSize, NULL, 0) != 0 )
+		return 0;
+	return (jint)lineSize;
+#else
+	return 0;
+#endif
+}
+
+// nMemLastLevelCacheSize()I
+JNIEXPORT jint JNICALL Java_org_lwjgl_system_MemoryUtil_nMemLastLevelCacheSize(JNIEnv *env, jclass clazz) {
+#if defined(LWJGL_LINUX)
+	long cacheSize = 0;
+	#ifdef _SC_LEVEL3_CACHE_SIZE
+		cacheSize = sysconf(_SC_LEVEL3_CACHE_SIZE);
+		if ( cacheSize <= 0 )
+			cacheSize = sysconf(_SC_LEVEL2_CACHE_SIZE);
+	#endif
+	return cacheSize <= 0 || 0x7FFFFFFF < cacheSize ? 0 : (jint)cacheSize;
+#elif defined(LWJGL_MACOSX)
+	int64_t cacheSize = 0;
+	size_t sizeOfCacheSize = sizeof(cacheSize);
+	if ( sysctlbyname("hw.l3cachesize", &cacheSize, &sizeOfCacheSize, NULL, 0) != 0 || cacheSize == 0 ) {
+		cacheSize = 0;
+		sizeOfCacheSize = sizeof(cacheSize);
+		if ( sysctlbyname("hw.l2cachesize", &cacheSize, &sizeOfCacheSize, NULL, 0) != 0 )
+			return 0;
+	}
+	return (jint)cacheSize;
+#else
+	return 0;
+#endif
+}
+
+#ifdef LWJGL_LINUX
+// Returns the default huge page size, as reported by /proc/meminfo.
+static size_t getHugePageSize(void) {
+	static size_t hugePageSize = 0;
+
+	if ( hugePageSize == 0 ) {
+		size_t size = 2 * 1024 * 1024;
+
+		FILE *f = fopen("/proc/meminfo", "r");
+		if ( f != NULL ) {
+			char line[128];
+			unsigned long kb;
+			while ( fgets(line, sizeof(line), f) != NULL ) {
+				if ( sscanf(line, "Hugepagesize: %lu kB", &kb) == 1 ) {
+					size = (size_t)kb * 1024;
+					break;
+				}
+			}
+			fclose(f);
+		}
+
+		hugePageSize = size;
+	}
+
+	return hugePageSize;
+}
+
+static size_t getLargeAllocationSize(size_t size, jint flags) {
+	size_t alignment = (flags & (MEM_LARGE_PAGES_TRANSPARENT | MEM_LARGE_PAGES_EXPLICIT)) != 0 ? getHugePageSize() : (size_t)sysconf(_SC_PAGESIZE);
+	return (size + alignment - 1) & ~(alignment - 1);
+}
+
+#ifndef MPOL_PREFERRED
+	#define MPOL_PREFERRED 1
+#endif
+#endif
+
+#ifdef LWJGL_WINDOWS
+typedef SIZE_T (WINAPI *GetLargePageMinimumPROC) (void);
+typedef LPVOID (WINAPI *VirtualAllocExNumaPROC) (HANDLE, LPVOID, SIZE_T, DWORD, DWORD, DWORD);
+
+#ifndef MEM_LARGE_PAGES
+	#define MEM_LARGE_PAGES 0x20000000
+#endif
+#endif
+
+// nMemAllocLarge(JII)J
+JNIEXPORT jlong JNICALL Java_org_lwjgl_system_MemoryUtil_nMemAllocLarge(JNIEnv *env, jclass clazz,
+	jlong size, jint flags, jint node
+) {
+#if defined(LWJGL_LINUX)
+	void *ptr = MAP_FAILED;
+	size_t length = getLargeAllocationSize((size_t)size, flags);
+
+	#ifdef MAP_HUGETLB
+	if ( flags & MEM_LARGE_PAGES_EXPLICIT ) {
+		// Fails if not enough huge pages have been reserved (vm.nr_hugepages)
+		ptr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	}
+	#endif
+
+	if ( ptr == MAP_FAILED ) {
+		#ifdef MADV_HUGEPAGE
+		if ( flags & (MEM_LARGE_PAGES_TRANSPARENT | MEM_LARGE_PAGES_EXPLICIT) ) {
+			// Transparent huge pages only back huge-page-aligned ranges. Over-allocate by one huge page, align the start and unmap the excess on
+			// both sides, so that nMemFreeLarge can unmap exactly length bytes.
+			size_t hugePageSize = getHugePageSize();
+			char *base = (char *)mmap(NULL, length + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if ( base == MAP_FAILED )
+				return (jlong)0;
+
+			ptr = (void *)(((uintptr_t)base + hugePageSize - 1) & ~(uintptr_t)(hugePageSize - 1));
+			if ( (char *)ptr != base )
+				munmap(base, (char *)ptr - base);
+			if ( (char *)ptr + length != base + length + hugePageSize )
+				munmap((char *)ptr + length, (base + length + hugePageSize) - ((char *)ptr + length));
+
+			madvise(ptr, length, MADV_HUGEPAGE);
+		} else
+		#endif
+		{
+			ptr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if ( ptr == MAP_FAILED )
+				return (jlong)0;
+		}
+	}
+
+	#ifdef SYS_mbind
+	if ( 0 <= node && node < 64 ) {
+		// Call mbind directly, so that we don't depend on libnuma. The binding is a hint, failures are ignored.
+		// The kernel reads maxnode - 1 bits from the mask, hence the + 1.
+		unsigned long nodemask = 1UL << node;
+		syscall(SYS_mbind, ptr, length, MPOL_PREFERRED, &nodemask, sizeof(nodemask) * 8 + 1, 0);
+	}
+	#endif
+
+	return (jlong)(intptr_t)ptr;
+#elif defined(LWJGL_WINDOWS)
+	HMODULE kernel32 = GetModuleHandleA("kernel32.dll");
+	VirtualAllocExNumaPROC VirtualAllocExNuma = (VirtualAllocExNumaPROC)GetProcAddress(kernel32, "VirtualAllocExNuma");
+	GetLargePageMinimumPROC GetLargePageMinimum = (GetLargePageMinimumPROC)GetProcAddress(kernel32, "GetLargePageMinimum");
+
+	void *ptr = NULL;
+	DWORD type = MEM_RESERVE | MEM_COMMIT;
+
+	if ( (flags & (MEM_LARGE_PAGES_TRANSPARENT | MEM_LARGE_PAGES_EXPLICIT)) != 0 && GetLargePageMinimum != NULL ) {
+		// Requires the SeLockMemoryPrivilege, falls back to normal pages otherwise
+		SIZE_T largePageSize = GetLargePageMinimum();
+		if ( largePageSize != 0 ) {
+			SIZE_T length = ((SIZE_T)size + largePageSize - 1) & ~(largePageSize - 1);
+			ptr = 0 <= node && VirtualAllocExNuma != NULL
+				? VirtualAllocExNuma(GetCurrentProcess(), NULL, length, type | MEM_LARGE_PAGES, PAGE_READWRITE, (DWORD)node)
+				: VirtualAlloc(NULL, length, type | MEM_LARGE_PAGES, PAGE_READWRITE);
+		}
+	}
+
+	if ( ptr == NULL )
+		ptr = 0 <= node && VirtualAllocExNuma != NULL
+			? VirtualAllocExNuma(GetCurrentProcess(), NULL, (SIZE_T)size, type, PAGE_READWRITE, (DWORD)node)
+			: VirtualAlloc(NULL, (SIZE_T)size, type, PAGE_READWRITE);
+
+	return (jlong)(intptr_t)ptr;
+#else
+	void *ptr = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+	return ptr == MAP_FAILED ? (jlong)0 : (jlong)(intptr_t)ptr;
+#endif
+}
+
+// nMemFreeLarge(JJI)V
+JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_nMemFreeLarge(JNIEnv *env, jclass clazz,
+	jlong address, jlong size, jint flags
+) {
+#if defined(LWJGL_LINUX)
+	munmap((void *)(intptr_t)address, getLargeAllocationSize((size_t)size, flags));
+#elif defined(LWJGL_WINDOWS)
+	VirtualFree((LPVOID)(intptr_t)address, 0, MEM_RELEASE);
+#else
+	munmap((void *)(intptr_t)address, (size_t)size);
+#endif
+}
+
+// nMemMapFile(JJI)J
+JNIEXPORT jlong JNICALL Java_org_lwjgl_system_MemoryUtil_nMemMapFile(JNIEnv *env, jclass clazz,
+	jlong path, jlong size, jint mode
+) {
+#ifdef LWJGL_WINDOWS
+	void *ptr;
+	HANDLE mapping;
+	HANDLE file = CreateFileW((LPCWSTR)(intptr_t)path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if ( file == INVALID_HANDLE_VALUE )
+		return (jlong)0;
+
+	mapping = CreateFileMappingW(file, NULL, mode == MEM_MAP_COPY_ON_WRITE ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if ( mapping == NULL )
+		return (jlong)0;
+
+	// The view keeps the mapping alive
+	ptr = MapViewOfFile(mapping, mode == MEM_MAP_COPY_ON_WRITE ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, (SIZE_T)size);
+	CloseHandle(mapping);
+
+	return (jlong)(intptr_t)ptr;
+#else
+	void *ptr;
+	int fd = open((const char *)(intptr_t)path, O_RDONLY);
+	if ( fd == -1 )
+		return (jlong)0;
+
+	ptr = mode == MEM_MAP_COPY_ON_WRITE
+		? mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0)
+		: mmap(NULL, (size_t)size, PROT_READ, MAP_SHARED, fd, 0);
+
+	// The mapping keeps the file open
+	close(fd);
+
+	return ptr == MAP_FAILED ? (jlong)0 : (jlong)(intptr_t)ptr;
+#endif
+}
+
+// nMemUnmapFile(JJ)V
+JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_nMemUnmapFile(JNIEnv *env, jclass clazz,
+	jlong address, jlong size
+) {
+#ifdef LWJGL_WINDOWS
+	UnmapViewOfFile((LPCVOID)(intptr_t)address);
+#else
+	munmap((void *)(intptr_t)address, (size_t)size);
+#endif
+}
+
+#ifdef LWJGL_WINDOWS
+typedef struct {
+	PVOID VirtualAddress;
+	SIZE_T NumberOfBytes;
+} LWJGL_MEMORY_RANGE_ENTRY;
+
+typedef BOOL (WINAPI *PrefetchVirtualMemoryPROC) (HANDLE, ULONG_PTR, LWJGL_MEMORY_RANGE_ENTRY *, ULONG);
+#endif
+
+// nMemAdvise(JJI)I
+JNIEXPORT jint JNICALL Java_org_lwjgl_system_MemoryUtil_nMemAdvise(JNIEnv *env, jclass clazz,
+	jlong address, jlong size, jint advice
+) {
+#ifdef LWJGL_WINDOWS
+	// Only MEM_ADVICE_WILLNEED is supported, on Windows 8 or newer.
+	static PrefetchVirtualMemoryPROC PrefetchVirtualMemory = NULL;
+	LWJGL_MEMORY_RANGE_ENTRY range;
+
+	if ( advice != MEM_ADVICE_WILLNEED )
+		return 0;
+
+	if ( PrefetchVirtualMemory == NULL ) {
+		PrefetchVirtualMemory = (PrefetchVirtualMemoryPROC)GetProcAddress(GetModuleHandleA("kernel32.dll"), "PrefetchVirtualMemory");
+		if ( PrefetchVirtualMemory == NULL )
+			return 0;
+	}
+
+	range.VirtualAddress = (PVOID)(intptr_t)address;
+	range.NumberOfBytes = (SIZE_T)size;
+	return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0) ? 0 : -1;
+#else
+	int nativeAdvice;
+	switch ( advice ) {
+		case MEM_ADVICE_SEQUENTIAL:
+			nativeAdvice = MADV_SEQUENTIAL;
+			break;
+		case MEM_ADVICE_RANDOM:
+			nativeAdvice = MADV_RANDOM;
+			break;
+		case MEM_ADVICE_WILLNEED:
+			nativeAdvice = MADV_WILLNEED;
+			break;
+		case MEM_ADVICE_DONTNEED:
+			nativeAdvice = MADV_DONTNEED;
+			break;
+		default:
+			nativeAdvice = MADV_NORMAL;
+	}
+	return (jint)madvise((void *)(intptr_t)address, (size_t)size, nativeAdvice);
+#endif
+}
+
 // nMemSet(JIJ)V
 JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_nMemSet(JNIEnv *env, jclass clazz,
 	jlong address, jint value, jlong bytes
@@ -55,13 +449,115 @@ JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_nMemSet(JNIEnv *env, jcl
 	memset((void *)(intptr_t)address, value, (size_t)bytes);
 }
 
-// nMemSet(JJJ)V
+// nMemCopy(JJJ)V
 JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_nMemCopy(JNIEnv *env, jclass clazz,
 	jlong dst, jlong src, jlong bytes
 ) {
 	memcpy((void *)(intptr_t)dst, (const void *)(intptr_t)src, (size_t)bytes);
 }
 
+// nMemCopyStreaming(JJJ)V
+JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_nMemCopyStreaming(JNIEnv *env, jclass clazz,
+	jlong dst, jlong src, jlong bytes
+) {
+#ifdef LWJGL_SSE2
+	char *d = (char *)(intptr_t)dst;
+	const char *s = (const char *)(intptr_t)src;
+	size_t n = (size_t)bytes;
+
+	// Align the destination, non-temporal stores require 16-byte alignment.
+	size_t head = (size_t)(-(intptr_t)d & 15);
+	if ( n < head + 64 ) {
+		memcpy(d, s, n);
+		return;
+	}
+
+	memcpy(d, s, head);
+	d += head;
+	s += head;
+	n -= head;
+
+	// Bypass the cache for the destination, so that a copy larger than the LLC does not evict the working set.
+	while ( 64 <= n ) {
+		__m128i a = _mm_loadu_si128((const __m128i *)(s +  0));
+		__m128i b = _mm_loadu_si128((const __m128i *)(s + 16));
+		__m128i c = _mm_loadu_si128((const __m128i *)(s + 32));
+		__m128i e = _mm_loadu_si128((const __m128i *)(s + 48));
+
+		_mm_stream_si128((__m128i *)(d +  0), a);
+		_mm_stream_si128((__m128i *)(d + 16), b);
+		_mm_stream_si128((__m128i *)(d + 32), c);
+		_mm_stream_si128((__m128i *)(d + 48), e);
+
+		d += 64;
+		s += 64;
+		n -= 64;
+	}
+	_mm_sfence();
+
+	memcpy(d, s, n);
+#else
+	memcpy((void *)(intptr_t)dst, (const void *)(intptr_t)src, (size_t)bytes);
+#endif
+}
+
+// nMemFill(JJIJ)V
+JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_nMemFill(JNIEnv *env, jclass clazz,
+	jlong address, jlong pattern, jint patternSize, jlong count
+) {
+	size_t n = (size_t)count;
+	size_t i;
+
+	// Simple loops, the compiler vectorizes these.
+	switch ( patternSize ) {
+		case 2: {
+			jshort value = (jshort)pattern;
+			jshort *p = (jshort *)(intptr_t)address;
+			for ( i = 0; i < n; i++ )
+				p[i] = value;
+			break;
+		}
+		case 4: {
+			jint value = (jint)pattern;
+			jint *p = (jint *)(intptr_t)address;
+			for ( i = 0; i < n; i++ )
+				p[i] = value;
+			break;
+		}
+		case 8: {
+			jlong *p = (jlong *)(intptr_t)address;
+			for ( i = 0; i < n; i++ )
+				p[i] = pattern;
+			break;
+		}
+		default:
+			memset((void *)(intptr_t)address, (int)pattern, n);
+	}
+}
+
+// nMemStrLen1(J)J
+JNIEXPORT jlong JNICALL Java_org_lwjgl_system_MemoryUtil_nMemStrLen1(JNIEnv *env, jclass clazz,
+	jlong address
+) {
+	return (jlong)strlen((const char *)(intptr_t)address);
+}
+
+// nMemStrLen2(J)J
+JNIEXPORT jlong JNICALL Java_org_lwjgl_system_MemoryUtil_nMemStrLen2(JNIEnv *env, jclass clazz,
+	jlong address
+) {
+#ifdef LWJGL_WINDOWS
+	return (jlong)wcslen((const wchar_t *)(intptr_t)address);
+#else
+	// wchar_t is 4 bytes on Linux and MacOSX
+	const jchar *start = (const jchar *)(intptr_t)address;
+	const jchar *p = start;
+	while ( *p != 0 )
+		p++;
+	return (jlong)(p - start);
+#endif
+}
+
 // nMemGetByte(J)B
 JNIEXPORT jbyte JNICALL Java_org_lwjgl_system_MemoryUtil_nMemGetByte(JNIEnv *env, jclass clazz, jlong ptr) { return *(jbyte *)(intptr_t)ptr; }
 
@@ -104,6 +600,23 @@ JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_nMemPutDouble(JNIEnv *en
 // nMemPutAddress(JJ)V
 JNIEXPORT void JNICALL Java_org_lwjgl_system_MemoryUtil_nMemPutAddress(JNIEnv *env, jclass clazz, jlong ptr, jlong value) { *(intptr_t *)(intptr_t)ptr = (intptr_t)value; }
 
+// Critical natives, used by HotSpot instead of the above when -XX:+CriticalJNINatives is enabled.
+
+JNIEXPORT jbyte JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemGetByte(jlong ptr) { return *(jbyte *)(intptr_t)ptr; }
+JNIEXPORT jshort JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemGetShort(jlong ptr) { return *(jshort *)(intptr_t)ptr; }
+JNIEXPORT jint JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemGetInt(jlong ptr) { return *(jint *)(intptr_t)ptr; }
+JNIEXPORT jlong JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemGetLong(jlong ptr) { return *(jlong *)(intptr_t)ptr; }
+JNIEXPORT jfloat JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemGetFloat(jlong ptr) { return *(jfloat *)(intptr_t)ptr; }
+JNIEXPORT jdouble JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemGetDouble(jlong ptr) { return *(jdouble *)(intptr_t)ptr; }
+JNIEXPORT jlong JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemGetAddress(jlong ptr) { return (jlong)*(intptr_t *)(intptr_t)ptr; }
+JNIEXPORT void JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemPutByte(jlong ptr, jbyte value) { *(jbyte *)(intptr_t)ptr = value; }
+JNIEXPORT void JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemPutShort(jlong ptr, jshort value) { *(jshort *)(intptr_t)ptr = value; }
+JNIEXPORT void JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemPutInt(jlong ptr, jint value) { *(jint *)(intptr_t)ptr = value; }
+JNIEXPORT void JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemPutLong(jlong ptr, jlong value) { *(jlong *)(intptr_t)ptr = value; }
+JNIEXPORT void JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemPutFloat(jlong ptr, jfloat value) { *(jfloat *)(intptr_t)ptr = value; }
+JNIEXPORT void JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemPutDouble(jlong ptr, jdouble value) { *(jdouble *)(intptr_t)ptr = value; }
+JNIEXPORT void JNICALL JavaCritical_org_lwjgl_system_MemoryUtil_nMemPutAddress(jlong ptr, jlong value) { *(intptr_t *)(intptr_t)ptr = (intptr_t)value; }
+
 // nGetAddress(Ljava/nio/Buffer;)J
 JNIEXPORT jlong JNICALL Java_org_lwjgl_system_MemoryUtil_nGetAddress(JNIEnv *env, jclass clazz,
 	jobject buffer
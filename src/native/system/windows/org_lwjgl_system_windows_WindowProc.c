@@ -70,6 +70,7 @@ static LRESULT CALLBACK wndProcAsync(
 	LPARAM lParam
 ) {
 	jobject callback;
+	LRESULT result;
 	JNIEnv *env = attachCurrentThread();
 	if ( env == NULL )
 		return DefWindowProc(hWnd, msg, wParam, lParam);
@@ -78,12 +79,12 @@ static LRESULT CALLBACK wndProcAsync(
    	if ( callback == NULL ) // This happens because WM_GETMINMAXINFO is fired before WM_NCCREATE
    		return DefWindowProc(hWnd, msg, wParam, lParam);
 
-	return (*env)->CallIntMethod(
+	result = (*env)->CallIntMethod(
 		env, callback, wndProcInvoke,
 		(jlong)(intptr_t)hWnd, (jint)msg, (jlong)wParam, (jlong)lParam
 	);
-
-	detachCurrentThread();
+	checkCallbackException(env);
+	return result;
 }
 
 // Static version, doesn't use extra window memory
@@ -108,16 +109,17 @@ static LRESULT CALLBACK wndProcStaticAsync(
 	WPARAM wParam,
 	LPARAM lParam
 ) {
+	LRESULT result;
 	JNIEnv *env = attachCurrentThread();
 	if ( env == NULL )
 		return DefWindowProc(hWnd, msg, wParam, lParam);
 
-	return (*env)->CallStaticIntMethod(
+	result = (*env)->CallStaticIntMethod(
 		env, wndProcInvokeStaticAsyncClass, wndProcInvokeStaticAsync,
 		(jlong)(intptr_t)hWnd, (jint)msg, (jlong)wParam, (jlong)lParam
 	);
-
-	detachCurrentThread();
+	checkCallbackException(env);
+	return result;
 }
 
 // setCallback(Ljava/lang/reflect/Method;)J
@@ -33,11 +33,16 @@ val RESULT = "__result"
 val POINTER_POSTFIX = "Address"
 val BUFFERS_POSTFIX = "Buffers"
 val LENGTHS_POSTFIX = "Lengths"
+val ENCODED_POSTFIX = "Encoded"
 val MAP_LENGTH = "length"
 val FUNCTION_ADDRESS = "__functionAddress"
 
 private val API_BUFFER = "__buffer"
 private val JNIENV = "__env"
+private val COMMAND_BUFFER = "__commands"
+private val PROFILE_TIME = "__time"
+val FUNCTION_ID = "__functionId"
+private val COMMAND_ARGS = "__args"
 
 private val GLCore_PATTERN = Pattern.compile("GL[1-9][0-9]")
 
@@ -543,7 +548,7 @@ public class NativeClassFunction(
 		// Step 4: Call the native method
 		generateCodeBeforeNative(code)
 
-		generateNativeMethodCall(code?.javaAfterNative != null) {
+		generateNativeMethodCall(getTraceCall(), getProfileBytes(), code?.javaAfterNative != null) {
 			printList(getNativeParams()) {
 				it.asNativeMethodCallParam(this@NativeClassFunction, GenerationMode.NORMAL)
 			}
@@ -635,15 +640,38 @@ public class NativeClassFunction(
 		}
 	}
 
-	private fun PrintWriter.generateNativeMethodCall(returnLater: Boolean = false, printParams: PrintWriter.() -> Unit) {
-		print("\t\t")
+	/*
+	 * In instrumented builds (see INSTRUMENT_BINDINGS), the native method call is written to the Trace and wrapped in a try/finally block that records
+	 * the call with the Profiler, guarded by the Trace.ENABLED and Profiler.ENABLED static final flags. The JIT folds the disabled branches, but the
+	 * bytecode of every method grows several times (the finally block is duplicated) and HotSpot's inlining limits (MaxInlineSize, FreqInlineSize) are
+	 * based on bytecode size, so hot methods may stop being inlined. Normal builds emit the plain call.
+	 */
+	private fun PrintWriter.generateNativeMethodCall(traceCall: String, profileBytes: String, returnLater: Boolean = false, printParams: PrintWriter.() -> Unit) {
+		val declaresResult = !(returns.isVoid || returnsStructValue) && (returns.isBufferPointer || returnLater)
+		val resultType = if ( returns.nativeType is ObjectType ) returns.nativeType.className else returnsNativeMethodType
+
+		if ( INSTRUMENT_BINDINGS ) {
+			println("\t\tif ( Trace.ENABLED )")
+			println("\t\t\t$traceCall")
+			println("\t\tlong $PROFILE_TIME = Profiler.ENABLED ? System.nanoTime() : 0L;")
+
+			if ( declaresResult )
+				println("\t\t$resultType $RESULT;")
+
+			println("\t\ttry {")
+			print("\t\t\t")
+		} else
+			print("\t\t")
+
 		if ( !(returns.isVoid || returnsStructValue) ) {
-			if ( returns.isBufferPointer || returnLater ) {
+			if ( declaresResult ) {
+				if ( !INSTRUMENT_BINDINGS )
+					print("$resultType ")
 				print(
 					if ( returns.nativeType is ObjectType )
-						"${returns.nativeType.className} $RESULT = ${returns.nativeType.className}.create("
+						"$RESULT = ${returns.nativeType.className}.create("
 					else
-						"${returnsNativeMethodType} $RESULT = "
+						"$RESULT = "
 				)
 			} else {
 				print("return ")
@@ -671,6 +699,75 @@ public class NativeClassFunction(
 			print(")")
 		}
 		println(";")
+
+		if ( INSTRUMENT_BINDINGS ) {
+			println("\t\t} finally {")
+			println("\t\t\tif ( Profiler.ENABLED )")
+			println("\t\t\t\tProfiler.record($FUNCTION_ID + ${nativeClass.functions.indexOf(this@NativeClassFunction)}, $PROFILE_TIME, $profileBytes);")
+			println("\t\t}")
+		}
+	}
+
+	/**
+	 * Returns the statement that writes the native method call to the Trace. Each argument is passed as the value used in the native method call, with
+	 * its size: -1 for values, the buffer size for pointers to untransformed buffer parameters and -2 for other pointers, whose size is unknown.
+	 */
+	private fun getTraceCall(transforms: Map<QualifiedType, FunctionTransform<out QualifiedType>>? = null): String {
+		val function = "$FUNCTION_ID + ${nativeClass.functions.indexOf(this)}"
+		if ( !hasNativeParams )
+			return "Trace.call($function);"
+
+		val values = StringBuilder()
+		val sizes = StringBuilder()
+		var hasPointers = false
+
+		getNativeParams().forEach {
+			val transform = transforms?.get(it)
+			val call = if ( transforms == null )
+				it.asNativeMethodCallParam(this, GenerationMode.NORMAL)
+			else
+				it.transformCallOrElse(transforms, it.asNativeMethodCallParam(this, GenerationMode.ALTERNATIVE))
+			val value = if ( call.contains(' ') ) "($call)" else call
+
+			if ( values.length() != 0 ) {
+				values append ", "
+				sizes append ", "
+			}
+
+			values append when ( it.nativeMethodType ) {
+				"boolean" -> "$value ? 1L : 0L"
+				"float" -> "Float.floatToRawIntBits($value)"
+				"double" -> "Double.doubleToRawLongBits($value)"
+				else -> value
+			}
+
+			sizes append if ( !it.isBufferPointer || transform == BufferOffsetTransform )
+				"-1L"
+			else {
+				hasPointers = true
+				// The autoSizeResult parameter points to the APIBuffer, transformed parameters are not buffers.
+				if ( transform != null || (it has autoSizeResult && (returns.nativeType !is StructType || returnsStructValue)) )
+					"-2L"
+				else
+					"Profiler.bytes(${it.name})"
+			}
+		}
+
+		return "Trace.call($function, new long[] { $values }, ${if ( hasPointers ) "new long[] { $sizes }" else "null"});"
+	}
+
+	/** Returns the expression that computes the number of bytes passed in buffer arguments, for the Profiler. */
+	private fun getProfileBytes(transforms: Map<QualifiedType, FunctionTransform<out QualifiedType>>? = null): String {
+		val builder = StringBuilder()
+		parameters.values().forEach {
+			// The autoSizeResult parameter is not a method parameter. Transformed parameters are skipped, they are not buffers or are small.
+			if ( it.isBufferPointer && !(it has autoSizeResult && returns.nativeType !is StructType) && (transforms == null || transforms[it] == null) ) {
+				if ( builder.length() != 0 )
+					builder append " + "
+				builder append "Profiler.bytes(${it.name})"
+			}
+		}
+		return if ( builder.length() == 0 ) "0L" else builder.toString()
 	}
 
 	/** Alternative methods are generated by applying one or more transformations. */
@@ -1027,7 +1124,7 @@ public class NativeClassFunction(
 		// Step 4: Call the native method
 		generateCodeBeforeNative(code)
 
-		generateNativeMethodCall(code?.javaAfterNative != null) {
+		generateNativeMethodCall(getTraceCall(transforms), getProfileBytes(transforms), code?.javaAfterNative != null) {
 			printList(getNativeParams()) {
 				it.transformCallOrElse(transforms, it.asNativeMethodCallParam(this@NativeClassFunction, GenerationMode.ALTERNATIVE))
 			}
@@ -1103,15 +1200,52 @@ public class NativeClassFunction(
 		println(");")
 	}
 
+	/** The name of the native method in the Java class. */
+	val nativeMethodName: String
+		get() = if ( isSimpleFunction ) name else "n$name"
+
+	/** The name of the C function that implements the native method. */
+	val jniFunctionName: String
+		get() = "Java_${nativeClass.nativeFileNameJNI}_${nativeMethodName.asJNIName}"
+
+	/** The JNI type signature of the native method, e.g. {@code (IIJ)V}. */
+	val jniSignature: String
+		get() {
+			val builder = StringBuilder()
+			builder append '('
+			getNativeParams() forEach {
+				builder append it.nativeType.jniFunctionType.jniTypeSignature
+			}
+			if ( returnsStructValue )
+				builder append 'J'
+			if ( nativeClass.functionProvider != null )
+				builder append 'J'
+			builder append ')'
+			builder append returnsJniFunctionType.jniTypeSignature
+
+			return builder.toString()
+		}
+
+	private val String.jniTypeSignature: String
+		get() = when ( this ) {
+			"void" -> "V"
+			"jboolean" -> "Z"
+			"jbyte" -> "B"
+			"jchar" -> "C"
+			"jshort" -> "S"
+			"jint" -> "I"
+			"jlong" -> "J"
+			"jfloat" -> "F"
+			"jdouble" -> "D"
+			else -> throw IllegalArgumentException("Unsupported JNI type: $this [${nativeClass.className}.$name]")
+		}
+
 	fun generateFunction(writer: PrintWriter): Unit = writer.generateFunctionImpl()
 	private fun PrintWriter.generateFunctionImpl() {
 		// Step 0: Function signature
 
-		print("JNIEXPORT ${returnsJniFunctionType} JNICALL Java_${nativeClass.nativeFileNameJNI}_")
-		if ( !isSimpleFunction )
-			print('n')
-		print(name.asJNIName)
-		print("(")
+		// Not exported, bound with RegisterNatives. See NativeClass.generateNativeMethodTable.
+		print("static ${returnsJniFunctionType} JNICALL $jniFunctionName(")
 		print("JNIEnv *$JNIENV, jclass clazz")
 		getNativeParams() forEach {
 			print(", ${it.asJNIFunctionParam}")
@@ -1161,6 +1295,117 @@ public class NativeClassFunction(
 		println(';')
 
 		print("}")
+
+		if ( has(criticalNative) )
+			generateCriticalFunction()
+	}
+
+	/*
+	 * Primitive-only native methods (all generated methods are, since pointers are passed as jlong) can be bound by HotSpot to a critical native: an
+	 * exported JavaCritical_ function without the JNIEnv and jclass arguments, used when -XX:+CriticalJNINatives is enabled. It avoids the argument
+	 * setup and pinning of a normal JNI call, but the thread still transitions to and from the native state. The JVM falls back to the normal JNI
+	 * function otherwise. A critical native must not call back into the JVM, which rules out most GL functions (a DEBUGPROC may run synchronously
+	 * with GL_DEBUG_OUTPUT_SYNCHRONOUS) and CL functions that may run pfn_notify or native kernel callbacks on the calling thread. It is therefore only
+	 * emitted for functions marked with the criticalNative modifier.
+	 */
+	private fun PrintWriter.generateCriticalFunction() {
+		print("\n\nJNIEXPORT ${returnsJniFunctionType} JNICALL JavaCritical_${jniFunctionName.substring(5)}(")
+		printList(getNativeParams()) {
+			it.asJNIFunctionParam
+		}
+		if ( hasNativeParams ) print(", ")
+		print("jlong $FUNCTION_ADDRESS")
+		if ( returnsStructValue )
+			print(", jlong $RESULT")
+		println(") {")
+
+		print('\t')
+		if ( returnsJniFunctionType != "void" )
+			print("return ")
+		print("$jniFunctionName(NULL, NULL")
+		getNativeParams() forEach { print(", ${it.asJNIFunctionParamName}") }
+		print(", $FUNCTION_ADDRESS")
+		if ( returnsStructValue )
+			print(", $RESULT")
+		println(");")
+		print("}")
+	}
+
+	// --[ COMMAND RECORDING ]--
+
+	/** Returns true if calls to this function can be recorded in a command buffer. Functions that return a value or store callbacks must be called directly. */
+	val isRecordable: Boolean
+		get() = !has(Reuse) && returns.isVoid && !returnsStructValue && !has(Capabilities) && !hasParam { it has Callback }
+
+	/** The GLCommandBuffer slot field for values of the specified JNI type. */
+	private val String.commandSlot: String
+		get() = when ( this ) {
+			"jboolean" -> "z"
+			"jbyte" -> "b"
+			"jshort" -> "s"
+			"jint" -> "i"
+			"jlong" -> "j"
+			"jfloat" -> "f"
+			"jdouble" -> "d"
+			else -> throw IllegalArgumentException("Unsupported JNI type: $this [${nativeClass.className}.$name]")
+		}
+
+	/** Generates the Recorder method that appends a call to this function to a command buffer, using the JNI method parameters. */
+	fun generateRecordMethod(writer: PrintWriter, index: Int): Unit = writer.generateRecordMethodImpl(index)
+	private fun PrintWriter.generateRecordMethodImpl(index: Int) {
+		println("\t\t/** Records a call to {@link ${nativeClass.className}#$nativeMethodName}. */")
+		print("\t\tpublic static void $name(GLCommandBuffer $COMMAND_BUFFER")
+		getNativeParams() forEach {
+			print(", ${it.asNativeMethodParam}")
+		}
+		println(") {")
+
+		println("\t\t\tlong $FUNCTION_ADDRESS = getInstance().$name;")
+		println("\t\t\tif ( LWJGLUtil.CHECKS )")
+		println("\t\t\t\tcheckFunctionAddress($FUNCTION_ADDRESS);")
+
+		val params = parameters.values().filter { !it.has(virtual) }
+		print("\t\t\t")
+		if ( !params.isEmpty() ) print("long $COMMAND_ARGS = ")
+		println("$COMMAND_BUFFER.record(COMMANDS[$index], $FUNCTION_ADDRESS, ${params.size});")
+		for ( i in params.indices ) {
+			val param = params[i]
+			val slot = if ( i == 0 ) COMMAND_ARGS else "$COMMAND_ARGS + ${i * 8}"
+			println(when ( param.nativeType.jniFunctionType ) {
+				"jboolean" -> "\t\t\tmemPutByte($slot, ${param.name} ? (byte)1 : (byte)0);"
+				"jbyte" -> "\t\t\tmemPutByte($slot, ${param.name});"
+				"jshort" -> "\t\t\tmemPutShort($slot, ${param.name});"
+				"jint" -> "\t\t\tmemPutInt($slot, ${param.name});"
+				"jlong" -> "\t\t\tmemPutLong($slot, ${param.name});"
+				"jfloat" -> "\t\t\tmemPutFloat($slot, ${param.name});"
+				"jdouble" -> "\t\t\tmemPutDouble($slot, ${param.name});"
+				else -> throw IllegalArgumentException("Unsupported JNI type: ${param.nativeType.jniFunctionType} [${nativeClass.className}.$name]")
+			})
+		}
+		println("\t\t}\n")
+	}
+
+	/** The name of the C function that decodes and executes a recorded call to this function. */
+	val commandFunctionName: String
+		get() = "${name}CMD"
+
+	/*
+	 * A recorded command is a sequence of 8-byte slots: the address of the command function, the function address and one slot per argument. The
+	 * command function calls the JNI function with the decoded arguments (the compiler inlines it) and returns the address of the next command.
+	 */
+	fun generateCommandFunction(writer: PrintWriter): Unit = writer.generateCommandFunctionImpl()
+	private fun PrintWriter.generateCommandFunctionImpl() {
+		val params = parameters.values().filter { !it.has(virtual) }
+
+		println("static const GLCommandSlot *$commandFunctionName(const GLCommandSlot *cmd) {")
+		print("\t$jniFunctionName(NULL, NULL")
+		for ( i in params.indices ) {
+			val param = params[i]
+			print(", cmd[${i + 2}].${param.nativeType.jniFunctionType.commandSlot}")
+		}
+		println(", cmd[1].j);")
+		println("\treturn cmd + ${params.size + 2};")
+		print("}")
 	}
 
 }
@@ -1233,6 +1478,21 @@ public class Code(
 	override val isSpecial: Boolean = true
 }
 
+/**
+ * Emits a JavaCritical_ entry point for a function that goes through a function provider. The function must never call back into the JVM, directly or
+ * through a callback that the user may have registered earlier.
+ */
+public val criticalNative: FunctionModifier = object : FunctionModifier() {
+	override val isSpecial: Boolean = false
+
+	protected override fun validate(func: NativeClassFunction) {
+		if ( func.nativeClass.functionProvider == null )
+			throw IllegalArgumentException("The criticalNative modifier can only be applied on functions of a function provider binding.")
+		if ( func.hasParam { it has Callback } )
+			throw IllegalArgumentException("The criticalNative modifier cannot be applied on functions with callback parameters.")
+	}
+}
+
 /** Marks a function without arguments as a macro. */
 public val macro: FunctionModifier = object : FunctionModifier() {
 	override val isSpecial: Boolean = false
@@ -1352,14 +1612,34 @@ private class ExpressionLocalTransform(
 	override fun preprocess(qtype: Parameter, writer: PrintWriter): Unit = writer.println("\t\t${qtype.asJavaMethodParam} = $expression;")
 }
 
-private val CharSequenceTransform = object : FunctionTransform<Parameter> {
+private val CharSequenceTransform = object : FunctionTransform<Parameter>, APIBufferFunctionTransform<Parameter> {
 	override fun transformDeclaration(param: Parameter, original: String): String? = "CharSequence ${param.name}"
-	override fun transformCall(param: Parameter, original: String): String = "memAddress${if ( param has nullable ) "Safe" else ""}(memEncode${(param.nativeType as CharSequenceType).charMapping.charset}(${param.name}))"
+	override fun transformCall(param: Parameter, original: String): String =
+		if ( param has nullable )
+			"${param.name} == null ? 0L : $API_BUFFER.address() + ${param.name}$ENCODED_POSTFIX"
+		else
+			"$API_BUFFER.address() + ${param.name}$ENCODED_POSTFIX" // Replace with APIBuffer address + offset
+	override fun setupAPIBuffer(qtype: Parameter, writer: PrintWriter) {
+		// Encode directly into the APIBuffer, to avoid allocating a new ByteBuffer on every call
+		val encode = "$API_BUFFER.stringParam${(qtype.nativeType as CharSequenceType).charMapping.charset}(${qtype.name}, true)"
+		writer.println(
+			if ( qtype has nullable )
+				"\t\tint ${qtype.name}$ENCODED_POSTFIX = ${qtype.name} == null ? 0 : $encode;"
+			else
+				"\t\tint ${qtype.name}$ENCODED_POSTFIX = $encode;"
+		)
+	}
 }
 
 private val StringReturnTransform = object : FunctionTransform<ReturnValue> {
 	override fun transformDeclaration(param: ReturnValue, original: String): String? = "String"
-	override fun transformCall(param: ReturnValue, original: String): String = "memDecode${(param.nativeType as CharSequenceType).charMapping.charset}($original)";
+	override fun transformCall(param: ReturnValue, original: String): String {
+		val charType = param.nativeType as CharSequenceType
+		return if ( charType.nullTerminated )
+			"memDecode${charType.charMapping.charset}($RESULT)" // Decode directly from the returned address
+		else
+			"memDecode${charType.charMapping.charset}($original)"
+	}
 }
 
 private class BufferValueReturnTransform(
@@ -409,6 +409,12 @@ private fun ensurePath(path: File) {
 
 // File management
 
+/**
+ * If true, the generated methods report their calls to the Trace and the Profiler. Set with the org.lwjgl.generator.instrument system property (the
+ * lwjgl.instrument Ant property). The generated sources must be cleaned when it changes, they are not regenerated otherwise.
+ */
+val INSTRUMENT_BINDINGS = java.lang.Boolean.getBoolean("org.lwjgl.generator.instrument")
+
 private val GENERATOR_LAST_MODIFIED = getDirectoryLastModified("src/templates/org/lwjgl/generator", true)
 private val packageLastModifiedMap = HashMap<String, Long>()
 
@@ -67,8 +67,14 @@ public abstract class FunctionProvider {
 			writer.println("\t\tlong $FUNCTION_ADDRESS = getInstance($instanceParameter).${function.name};")
 	}
 
+	/** If true, a Recorder class is generated for the specified class, that records its functions in a GLCommandBuffer. */
+	open fun hasCommandRecorder(nativeClass: NativeClass): Boolean = false
+
 	open fun printFunctionsParams(writer: PrintWriter, nativeClass: NativeClass) {}
-	open fun getFunctionAddressCall(function: NativeClassFunction): String = "provider.getFunctionAddress(\"${function.name}\")"
+	/** Returns the statement that resolves the addresses of all functions in {@code NAMES}, with a single bulk lookup if the provider supports it. */
+	open fun getFunctionAddressesCall(nativeClass: NativeClass): String = "APIUtil.apiGetFunctionAddresses(provider, NAMES, addresses);"
+	/** Returns the expression that initializes the function address field of {@code function}, at {@code index} in the addresses array. */
+	open fun getFunctionAddress(function: NativeClassFunction, index: Int): String = "addresses[$index]"
 
 	abstract fun generateFunctionGetters(writer: PrintWriter, nativeClass: NativeClass)
 	abstract fun generateCapabilities(writer: PrintWriter)
@@ -99,6 +105,18 @@ public class NativeClass(
 	val hasNativeFunctions: Boolean
 		get() = !functions.isEmpty()
 
+	/** Returns true if the class declares JNI methods. Functions with the {@link Reuse} modifier call the JNI method of another class. */
+	val hasNativeMethods: Boolean
+		get() = functions.any { !it.has(Reuse) }
+
+	/** Returns true if the Functions class stores per-instance callback state, in which case it must not be shared between contexts. */
+	val hasStoredCallbacks: Boolean
+		get() = functions.any { it.hasParam { it has Callback && it[Callback].storeInFunctions } }
+
+	/** The functions that can be recorded in a command buffer, in command table order. Empty if the class does not have a command recorder. */
+	val recordableFunctions: List<NativeClassFunction>
+		get() = if ( functionProvider != null && functionProvider.hasCommandRecorder(this) ) functions.filter { it.isRecordable } else Collections.emptyList<NativeClassFunction>()
+
 	private val javaDocs = HashMap<String, String>()
 
 	fun setJavaDoc(ref: String, javaDoc: String) {
@@ -128,7 +146,7 @@ public class NativeClass(
 					if ( it.hasParam { it.nativeType.mapping == PointerMapping.DATA_POINTER } )
 						needsPointer = true
 
-					if ( it.hasParam { it has returnValue || it has SingleValue || it has autoSizeResult || it has PointerArray } )
+					if ( it.hasParam { it has returnValue || it has SingleValue || it has autoSizeResult || it has PointerArray || (it.nativeType is CharSequenceType && !it.has(Return)) } )
 						needsAPIUtil = true
 				}
 
@@ -137,7 +155,8 @@ public class NativeClass(
 				println("import static org.lwjgl.system.MemoryUtil.*;")
 				if ( needsAPIUtil )
 					println("import static org.lwjgl.system.APIUtil.*;")
-			}
+			} else if ( !recordableFunctions.isEmpty() )
+				println("import static org.lwjgl.system.MemoryUtil.*;")
 			println()
 			preamble.printJava(this)
 		}
@@ -152,6 +171,31 @@ public class NativeClass(
 
 		println("\tprivate $className() {}\n")
 
+		if ( hasNativeMethods ) {
+			println("\tstatic {")
+			println("\t\tSys.touch();")
+			println("\t\tregisterNatives();")
+			println("\t}\n")
+
+			println("\t/** Binds the JNI methods of this class to their native implementations. */")
+			println("\tprivate static native void registerNatives();\n")
+		}
+
+		if ( INSTRUMENT_BINDINGS && functions.any { !it.isSimpleFunction } ) {
+			// Function ids for the Profiler and the Trace, see Function.generateNativeMethodCall.
+			print("\tprivate static final int $FUNCTION_ID = Profiler.ENABLED || Trace.ENABLED ? Profiler.register(\n\t\t$className.class")
+			functions.forEach {
+				print(",\n\t\t\"${it.name}\"")
+			}
+			println("\n\t) : 0;\n")
+		}
+
+		val recordableFunctions = this@NativeClass.recordableFunctions
+		if ( !recordableFunctions.isEmpty() ) {
+			println("\t/** Returns the address of the native command function table, used by {@link Recorder}. */")
+			println("\tprivate static native long getCommands();\n")
+		}
+
 		functions.forEach {
 			println("\t// --- [ ${it.name} ] ---\n")
 			try {
@@ -166,6 +210,9 @@ public class NativeClass(
 			generateFunctionsClass(functionProvider)
 		}
 
+		if ( !recordableFunctions.isEmpty() )
+			generateRecorderClass(recordableFunctions)
+
 		print("}")
 	}
 
@@ -192,21 +239,61 @@ public class NativeClass(
 			}
 		}
 
+		// The function names as consecutive null-terminated strings, for the bulk lookup.
+		print("\n\t\tprivate static final java.nio.ByteBuffer NAMES = MemoryUtil.memEncodeASCII(")
+		for ( i in functions.indices ) {
+			print("\n\t\t\t\"${functions[i].name}")
+			print(if ( i == functions.lastIndex ) "\"" else "\\0\" +")
+		}
+		println("\n\t\t);")
+
 		print("\n\t\tpublic Functions(FunctionProvider${if ( functionProvider.isLocal ) "Local" else ""} provider")
 		functionProvider.printFunctionsParams(this, this@NativeClass)
 		println(") {")
-		functions.forEach {
-			println("\t\t\t${it.name} = ${functionProvider.getFunctionAddressCall(it)};")
-		}
+		println("\t\t\tlong[] addresses = new long[${functions.size}];")
+		println("\t\t\t${functionProvider.getFunctionAddressesCall(this@NativeClass)}\n")
+		for ( i in functions.indices )
+			println("\t\t\t${functions[i].name} = ${functionProvider.getFunctionAddress(functions[i], i)};")
 		println("\t\t}")
+
+		if ( hasStoredCallbacks ) {
+			println("\n\t\t/** Creates a copy of the specified {@link Functions} instance, without the stored callbacks. */")
+			println("\t\tpublic Functions(Functions funcs) {")
+			functions.forEach {
+				println("\t\t\t${it.name} = funcs.${it.name};")
+			}
+			println("\t\t}")
+		}
 		println("\n\t}\n")
 	}
 
+	private fun PrintWriter.generateRecorderClass(recordableFunctions: List<NativeClassFunction>) {
+		println("\t/**")
+		println("\t * Records calls to the functions of {@code $className} in a {@link GLCommandBuffer}, to be executed later with a single native call. The")
+		println("\t * methods take the same arguments as the JNI methods: pointer arguments are raw addresses, that must remain valid until the buffer is")
+		println("\t * executed. The function addresses are resolved when recording, using the current context.")
+		println("\t */")
+		println("\tpublic static final class Recorder {\n")
+
+		println("\t\tprivate static final long[] COMMANDS = GLCommandBuffer.getCommands(getCommands(), ${recordableFunctions.size});\n")
+
+		println("\t\tprivate Recorder() {}\n")
+
+		for ( i in recordableFunctions.indices )
+			recordableFunctions[i].generateRecordMethod(this, i)
+
+		println("\t}\n")
+	}
+
 	override fun generateNative(writer: PrintWriter): Unit = writer.generateNativeImpl()
 	private fun PrintWriter.generateNativeImpl() {
 		print(HEADER)
 		println("#include \"common_tools.h\"")
 
+		val recordableFunctions = this@NativeClass.recordableFunctions
+		if ( !recordableFunctions.isEmpty() )
+			println("#include \"GLCommandBuffer.h\"")
+
 		preamble.printNative(this)
 
 		if ( functionProvider != null ) {
@@ -217,8 +304,10 @@ public class NativeClass(
 			}
 		}
 
+		val nativeFunctions = functions.filter { !it.has(Reuse) }
+
 		var first = true
-		functions.forEach {
+		nativeFunctions.forEach {
 			if ( first ) {
 				println()
 				first = false
@@ -226,6 +315,48 @@ public class NativeClass(
 				println("\n")
 			it.generateFunction(this)
 		}
+
+		if ( !recordableFunctions.isEmpty() )
+			generateCommandTable(recordableFunctions)
+
+		generateNativeMethodTable(nativeFunctions, !recordableFunctions.isEmpty())
+	}
+
+	private fun PrintWriter.generateCommandTable(recordableFunctions: List<NativeClassFunction>) {
+		recordableFunctions.forEach {
+			println("\n")
+			it.generateCommandFunction(this)
+		}
+
+		println("\n\nstatic const GLCommandPROC commands[] = {")
+		recordableFunctions.forEach {
+			println("\t&${it.commandFunctionName},")
+		}
+		println("};")
+
+		println("\n// getCommands()J")
+		println("static jlong JNICALL Java_${nativeFileNameJNI}_getCommands(JNIEnv *env, jclass clazz) {")
+		println("\treturn (jlong)(intptr_t)commands;")
+		print("}")
+	}
+
+	/*
+	 * The JNI functions are static and bound with a single RegisterNatives call, when the Java class is initialized. This keeps them out of the
+	 * exported symbol table and avoids the name-mangled symbol lookup on the first invocation of each method.
+	 */
+	private fun PrintWriter.generateNativeMethodTable(nativeFunctions: List<NativeClassFunction>, hasCommands: Boolean) {
+		println("\n\nstatic JNINativeMethod methods[] = {")
+		nativeFunctions.forEach {
+			println("\t{ \"${it.nativeMethodName}\", \"${it.jniSignature}\", (void *)&${it.jniFunctionName} },")
+		}
+		if ( hasCommands )
+			println("\t{ \"getCommands\", \"()J\", (void *)&Java_${nativeFileNameJNI}_getCommands },")
+		println("};")
+
+		println("\n// registerNatives()V")
+		println("JNIEXPORT void JNICALL Java_${nativeFileNameJNI}_registerNatives(JNIEnv *env, jclass clazz) {")
+		println("\t(*env)->RegisterNatives(env, clazz, methods, (jint)(sizeof(methods) / sizeof(JNINativeMethod)));")
+		print("}")
 	}
 
 	// DSL extensions
@@ -152,15 +152,14 @@ public class Parameter(
 		else -> name
 	}
 
-	val asJNIFunctionParam: String
-		get() {
-			val name = if ( nativeType.mapping is PointerMapping )
-				"$name$POINTER_POSTFIX"
-			else
-				name
+	val asJNIFunctionParamName: String
+		get() = if ( nativeType.mapping is PointerMapping )
+			"$name$POINTER_POSTFIX"
+		else
+			name
 
-			return "$jniFunctionType $name"
-		}
+	val asJNIFunctionParam: String
+		get() = "$jniFunctionType $asJNIFunctionParamName"
 
 }
 
@@ -143,6 +143,7 @@ public class Struct(
 		println("import java.nio.*;\n")
 
 		println("import org.lwjgl.*;")
+		println("import org.lwjgl.system.MemoryPool;\n")
 
 		println("import static org.lwjgl.system.Checks.*;")
 		println("import static org.lwjgl.system.MemoryUtil.*;\n")
@@ -185,6 +186,12 @@ public class Struct(
 
 	/** Returns a new {@link ByteBuffer} instance with a capacity equal to {@link #SIZEOF}. */
 	public static ByteBuffer malloc() { return BufferUtils.createByteBuffer(SIZEOF); }
+
+	/** Returns a {@link ByteBuffer} instance with a capacity equal to {@link #SIZEOF}, allocated from the {@link MemoryPool}. It must be released with {@link #release}. */
+	public static ByteBuffer allocate() { return MemoryPool.poolAlloc(SIZEOF); }
+
+	/** Releases a {@link ByteBuffer} instance returned by {@link #allocate}. */
+	public static void release(ByteBuffer $struct) { MemoryPool.poolFree($struct); }
 """)
 
 		// Step: 3: Constructors
@@ -640,7 +647,7 @@ public class Struct(
 						{
 							if ( it.nativeType.nullTerminated ) {
 								println("\tpublic static ByteBuffer ${method}Getb(ByteBuffer $struct) { long address = ${method}Get($struct); return address == 0 ? null : memByteBufferNT${it.nativeType.charMapping.bytes}(address); }")
-								println("\tpublic static String ${method}Gets(ByteBuffer $struct) { long address = ${method}Get($struct); return address == 0 ? null : memDecode${it.nativeType.charMapping.charset}(memByteBufferNT${it.nativeType.charMapping.bytes}(address)); }")
+								println("\tpublic static String ${method}Gets(ByteBuffer $struct) { return memDecode${it.nativeType.charMapping.charset}(${method}Get($struct)); }")
 							} else {
 								println("\tpublic static ByteBuffer ${method}Getb(ByteBuffer $struct, int size) { long address = ${method}Get($struct); return address == 0 ? null : memByteBuffer(address, size); }")
 								println("\tpublic static String ${method}Gets(ByteBuffer $struct, int size) { long address = ${method}Get($struct); return address == 0 ? null : memDecode${it.nativeType.charMapping.charset}(memByteBuffer(address, size)); }")
@@ -27,11 +27,11 @@ public val FunctionProviderALC: FunctionProvider = object : FunctionProvider() {
 			writer.print(", long device")
 	}
 
-	override fun getFunctionAddressCall(function: NativeClassFunction): String =
-		if ( function.nativeClass.templateName.startsWith("ALC") )
-			"provider.getFunctionAddress(\"${function.name}\")"
+	override fun getFunctionAddressesCall(nativeClass: NativeClass): String =
+		if ( nativeClass.templateName.startsWith("ALC") )
+			"APIUtil.apiGetFunctionAddresses(provider, NAMES, addresses);"
 		else
-			"provider.getFunctionAddress(device, \"${function.name}\")"
+			"APIUtil.apiGetFunctionAddresses(provider, device, NAMES, addresses);"
 
 	override fun generateFunctionGetters(writer: PrintWriter, nativeClass: NativeClass): Unit = writer.generateFunctionGettersImpl(nativeClass)
 	private fun PrintWriter.generateFunctionGettersImpl(nativeClass: NativeClass) {
@@ -128,8 +128,7 @@ public val FunctionProviderALC: FunctionProvider = object : FunctionProvider() {
 			println(if ( i == classes.lastIndex ) ";" else ",")
 		}
 
-		println("\n\tALCCapabilities(long device, Set<String> ext) {")
-		println("\t\tFunctionProviderLocal provider = ALC.getFunctionProvider();\n")
+		println("\n\tALCCapabilities(FunctionProviderLocal provider, long device, Set<String> ext) {")
 		for ( extension in classes ) {
 			val capName = extension.capName("ALC")
 			if ( extension.hasNativeFunctions && extension.prefix == "ALC" ) {
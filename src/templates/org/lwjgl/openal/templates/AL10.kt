@@ -149,7 +149,7 @@ fun AL10() = "AL10".nativeClassAL("AL10") {
 		"PROCESSED" _ 0x2012
 	)
 
-	ALenum.func(
+	criticalNative _ ALenum.func(
 		"GetError",
 		"""
 		Obtains error information.
@@ -420,7 +420,7 @@ f' = f * (SS * DV - DF*vls) / (SS * DV - DF*vss)
 		SingleValue("source") _ ALuint_p.IN("sources", "the sources to delete")
 	)
 
-	ALboolean.func(
+	criticalNative _ ALboolean.func(
 		"IsSource",
 		"Verifies whether the given object name is a source name.",
 
@@ -436,7 +436,7 @@ f' = f * (SS * DV - DF*vls) / (SS * DV - DF*vss)
 		ALfloat.IN("value", "the parameter value")
 	).javaDocLink
 
-	ALvoid.func(
+	criticalNative _ ALvoid.func(
 		"Source3f",
 		"Sets the 3 dimensional values of a source parameter.",
 
@@ -29,11 +29,11 @@ public val FunctionProviderCL: FunctionProvider = object : FunctionProvider() {
 			writer.print(", long platform")
 	}
 
-	override fun getFunctionAddressCall(function: NativeClassFunction): String =
-		if ( function.nativeClass.templateName.startsWith("CL") )
-			"provider.getFunctionAddress(\"${function.name}\")"
+	override fun getFunctionAddressesCall(nativeClass: NativeClass): String =
+		if ( nativeClass.templateName.startsWith("CL") )
+			"APIUtil.apiGetFunctionAddresses(provider, NAMES, addresses);"
 		else
-			"provider.getFunctionAddress(platform, \"${function.name}\")"
+			"APIUtil.apiGetFunctionAddresses(provider, platform, NAMES, addresses);"
 
 	override fun generateFunctionGetters(writer: PrintWriter, nativeClass: NativeClass): Unit = writer.generateFunctionGettersImpl(nativeClass)
 	private fun PrintWriter.generateFunctionGettersImpl(nativeClass: NativeClass) {
@@ -137,11 +137,9 @@ public val FunctionProviderCL: FunctionProvider = object : FunctionProvider() {
 		}
 
 		println("""
-	CLCapabilities(long platform, int majorVersion, int minorVersion, Set<String> ext) {
+	CLCapabilities(FunctionProviderLocal provider, long platform, int majorVersion, int minorVersion, Set<String> ext) {
 		this.majorVersion = majorVersion;
 		this.minorVersion = minorVersion;
-
-		FunctionProviderLocal provider = CL.getFunctionProvider();
 """)
 		for ( extension in classes ) {
 			val capName = extension.capName
@@ -26,28 +26,36 @@ private val List<NativeClassFunction>.hasDeprecated: Boolean
 
 public val FunctionProviderGL: FunctionProvider = object : FunctionProvider() {
 
+	// WGL/GLX functions are not recorded, they are not called on the context thread in a render loop.
+	override fun hasCommandRecorder(nativeClass: NativeClass): Boolean = nativeClass.prefix == "GL"
+
 	override fun printFunctionsParams(writer: PrintWriter, nativeClass: NativeClass) {
 		if ( nativeClass.functions.hasDeprecated )
 			writer.print(", boolean fc")
 	}
 
-	override fun getFunctionAddressCall(function: NativeClassFunction): String =
-		// Do the fc check here, because getFunctionAddress will return an address
+	override fun getFunctionAddress(function: NativeClassFunction, index: Int): String =
+		// Do the fc check here, because the bulk lookup will return an address
 		// even if the current context is forward compatible. We don't want that because
 		// we prefer to throw an exception instead of letting GL raise an error and it's
 		// also the only way to support the pseudo-fc mode.
 		if ( function has deprecatedGL )
-			"GL.getFunctionAddress(provider, \"${function.name}\", fc)"
+			"fc ? 0L : addresses[$index]"
 		else
-			"provider.getFunctionAddress(\"${function.name}\")"
+			"addresses[$index]"
 
 	override fun generateFunctionGetters(writer: PrintWriter, nativeClass: NativeClass): Unit = writer.generateFunctionGettersImpl(nativeClass)
 	private fun PrintWriter.generateFunctionGettersImpl(nativeClass: NativeClass) {
 		println("\t// --- [ Function Addresses ] ---\n")
 
-		println("\t/** Returns the {@link Functions} instance for the current context. */")
+		println("\t/**")
+		println("\t * Returns the {@link Functions} instance for the current context. The function addresses it contains may be passed directly to the JNI methods,")
+		println("\t * to move the lookup out of tight loops.")
+		println("\t */")
 		println("\tpublic static Functions getInstance() {")
-		println("\t\treturn GL.getCapabilities().__${nativeClass.className};")
+		println("\t\tContextCapabilities caps = GL.getCapabilities();")
+		println("\t\tFunctions funcs = caps.__${nativeClass.className};")
+		println("\t\treturn funcs != null ? funcs : resolve(caps);")
 		println("\t}")
 
 		val functions = nativeClass.functions
@@ -55,6 +63,14 @@ public val FunctionProviderGL: FunctionProvider = object : FunctionProvider() {
 		val hasDependencies = functions.hasDependencies
 		val hasDeprecated = functions.hasDeprecated
 
+		// Lazy mode: the capability flag has been set from the extension strings, the function addresses are resolved on first use.
+		println("\n\tprivate static Functions resolve(ContextCapabilities caps) {")
+		println("\t\tif ( !caps.lazyFunctions || !caps.${nativeClass.capName} ) return null;")
+		print("\n\t\treturn caps.__${nativeClass.className} = new Functions(GL.getFunctionProvider()")
+		if ( hasDeprecated ) print(", caps.forwardCompatible")
+		println(");")
+		println("\t}")
+
 		print("\n\tstatic Functions create(java.util.Set<String> ext, FunctionProvider provider")
 		if ( hasDeprecated ) print(", boolean fc")
 		println(") {")
@@ -123,12 +139,15 @@ public val FunctionProviderGL: FunctionProvider = object : FunctionProvider() {
 		val classesWithFunctions = classes.filter { it.hasNativeFunctions }
 		val alignment = classesWithFunctions.map { it.className.size }.fold(0) { (left, right) -> Math.max(left, right) }
 		for ( extension in classesWithFunctions ) {
-			print("\tfinal ${extension.className}.Functions")
+			print("\t${extension.className}.Functions")
 			for ( i in 0..(alignment - extension.className.size - 1) )
 				print(' ')
 			println(" __${extension.className};")
 		}
 
+		println("\n\tfinal boolean forwardCompatible;")
+		println("\tfinal boolean lazyFunctions;")
+
 		println("\n\t/** Indicates whether an OpenGL functionality is available or not. */")
 		println("\tpublic final boolean")
 		for ( i in classes.indices ) {
@@ -136,8 +155,14 @@ public val FunctionProviderGL: FunctionProvider = object : FunctionProvider() {
 			println(if ( i == classes.lastIndex ) ";" else ",")
 		}
 
-		println("\n\tContextCapabilities(Set<String> ext, boolean fc) {")
-		println("\t\tFunctionProvider provider = GL.getFunctionProvider();\n")
+		println("\n\tContextCapabilities(FunctionProvider provider, Set<String> ext, boolean fc, boolean lazy) {")
+		println("\t\tforwardCompatible = fc;")
+		println("\t\tlazyFunctions = lazy;\n")
+		println("\t\tif ( lazy ) {")
+		for ( extension in classes )
+			println("\t\t\t${extension.capName} = ext.contains(\"${extension.capName}\");")
+		println("\t\t\treturn;")
+		println("\t\t}\n")
 		for ( extension in classes ) {
 			if ( extension.hasNativeFunctions ) {
 				print("\t\t${extension.capName} = (__${extension.className} = ${extension.className}.create(ext, provider")
@@ -147,6 +172,22 @@ public val FunctionProviderGL: FunctionProvider = object : FunctionProvider() {
 				println("\t\t${extension.capName} = ext.contains(\"${extension.capName}\");")
 		}
 		println("\t}")
+
+		println("\n\t/** Creates a copy of the specified {@link ContextCapabilities}, for a context with the same driver signature. */")
+		println("\tContextCapabilities(ContextCapabilities caps) {")
+		println("\t\tforwardCompatible = caps.forwardCompatible;")
+		println("\t\tlazyFunctions = caps.lazyFunctions;\n")
+		for ( extension in classes )
+			println("\t\t${extension.capName} = caps.${extension.capName};")
+		println()
+		// Functions instances are immutable and can be shared, except those that store callback references.
+		for ( extension in classesWithFunctions ) {
+			if ( extension.hasStoredCallbacks )
+				println("\t\t__${extension.className} = caps.__${extension.className} == null ? null : new ${extension.className}.Functions(caps.__${extension.className});")
+			else
+				println("\t\t__${extension.className} = caps.__${extension.className};")
+		}
+		println("\t}")
 		print("}")
 	}
 
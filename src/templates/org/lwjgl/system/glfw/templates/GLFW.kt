@@ -911,7 +911,9 @@ fun GLFW() = "GLFW".nativeClass(packageName = GLFW_PACKAGE, prefix = "GLFW") {
 	)
 
 	Code(
-		javaInit = "\t\tif ( LWJGLUtil.getPlatform() == LWJGLUtil.Platform.MACOSX ) { WindowCallbackMacOSX.pollEvents(); return; }"
+		javaInit = "\t\tif ( LWJGLUtil.getPlatform() == LWJGLUtil.Platform.MACOSX ) { WindowCallbackMacOSX.pollEvents(); return; }",
+		// Dispatch the events queued by batched WindowCallbacks
+		javaAfterNative = "\t\tWindowCallback.drainEvents();"
 	) _ void.func(
 		"PollEvents",
 		"""
@@ -921,7 +923,9 @@ fun GLFW() = "GLFW".nativeClass(packageName = GLFW_PACKAGE, prefix = "GLFW") {
 	)
 
 	Code(
-		javaInit = "\t\tif ( LWJGLUtil.getPlatform() == LWJGLUtil.Platform.MACOSX ) { WindowCallbackMacOSX.waitEvents(); return; }"
+		javaInit = "\t\tif ( LWJGLUtil.getPlatform() == LWJGLUtil.Platform.MACOSX ) { WindowCallbackMacOSX.waitEvents(); return; }",
+		// Dispatch the events queued by batched WindowCallbacks
+		javaAfterNative = "\t\tWindowCallback.drainEvents();"
 	) _ void.func(
 		"WaitEvents",
 		"""
@@ -0,0 +1,103 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.opencl;
+
+import org.lwjgl.BufferUtils;
+import org.lwjgl.PointerBuffer;
+
+import java.nio.IntBuffer;
+import java.util.*;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+import static org.lwjgl.opencl.CL10.*;
+import static org.lwjgl.opencl.CL11.*;
+import static org.lwjgl.opencl.CLUtil.*;
+
+/**
+ * Measures the throughput of {@link CLEventCallback} invocations. Each round enqueues marker commands with a completion callback; the callbacks are
+ * invoked from the threads of the OpenCL implementation, which are attached to the JVM on their first callback.
+ * <p/>
+ * Also reports the number of distinct {@link Thread} objects the callbacks were invoked in. It is bounded by the size of the driver's thread pool when
+ * foreign threads stay attached, it grows with the number of callbacks when they are attached and detached per callback. Run with pocl to measure
+ * without a GPU.
+ */
+public final class CLEventCallbackBenchmark {
+
+	private static final int CALLBACKS = 10000;
+	private static final int ROUNDS    = 5;
+
+	private CLEventCallbackBenchmark() {
+	}
+
+	public static void main(String[] args) throws InterruptedException {
+		CL.create();
+		try {
+			List<CLPlatform> platforms = CLPlatform.getPlatforms();
+			if ( platforms.isEmpty() )
+				throw new IllegalStateException("No OpenCL platforms found.");
+
+			CLPlatform platform = platforms.get(0);
+			CLDevice device = platform.getDevices(CL_DEVICE_TYPE_ALL).get(0);
+			System.out.println("CL_DEVICE_NAME: " + device.getInfoStringASCII(CL_DEVICE_NAME));
+
+			PointerBuffer ctxProps = BufferUtils.createPointerBuffer(3);
+			ctxProps.put(CL_CONTEXT_PLATFORM).put(platform.getPointer()).put(0).flip();
+
+			IntBuffer errcode_ret = BufferUtils.createIntBuffer(1);
+
+			CLContext context = clCreateContext(ctxProps, device, new CLContextCallback(), errcode_ret);
+			checkCLError(errcode_ret);
+
+			CLCommandQueue queue = clCreateCommandQueue(context, device, 0L, errcode_ret);
+			checkCLError(errcode_ret);
+
+			try {
+				for ( int round = 0; round < ROUNDS; round++ )
+					benchmark(context, queue);
+			} finally {
+				clReleaseCommandQueue(queue);
+				clReleaseContext(context);
+			}
+		} finally {
+			CL.destroy();
+		}
+	}
+
+	private static void benchmark(CLContext context, CLCommandQueue queue) throws InterruptedException {
+		final CountDownLatch latch = new CountDownLatch(CALLBACKS);
+		final Set<Thread> threads = Collections.synchronizedSet(Collections.newSetFromMap(new IdentityHashMap<Thread, Boolean>()));
+
+		CLEventCallback callback = new CLEventCallback() {
+			@Override
+			public void invoke(long cl_event, int command_exec_status) {
+				threads.add(Thread.currentThread());
+				latch.countDown();
+			}
+		};
+
+		PointerBuffer event = BufferUtils.createPointerBuffer(1);
+
+		long t = System.nanoTime();
+		for ( int i = 0; i < CALLBACKS; i++ ) {
+			checkCLError(clEnqueueMarker(queue, event));
+
+			CLEvent e = CLEvent.create(event.get(0), context);
+			checkCLError(clSetEventCallback(e, CL_COMPLETE, callback));
+			checkCLError(clReleaseEvent(e));
+		}
+		checkCLError(clFlush(queue));
+
+		if ( !latch.await(60, TimeUnit.SECONDS) )
+			throw new IllegalStateException("Timed out waiting for the event callbacks.");
+		t = System.nanoTime() - t;
+
+		System.out.format(
+			"%d callbacks: %8.2fus/callback, %10.0f callbacks/s, %d distinct threads%n",
+			CALLBACKS, t / 1000.0 / CALLBACKS, CALLBACKS * 1e9 / t, threads.size()
+		);
+	}
+
+}
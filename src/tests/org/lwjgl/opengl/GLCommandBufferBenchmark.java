@@ -0,0 +1,109 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.opengl;
+
+import org.lwjgl.Sys;
+import org.lwjgl.system.glfw.ErrorCallback;
+
+import static org.lwjgl.opengl.GL11.*;
+import static org.lwjgl.system.MemoryUtil.*;
+import static org.lwjgl.system.glfw.GLFW.*;
+
+/**
+ * Measures the per-call throughput of small OpenGL state calls:
+ * <ul>
+ * <li>direct: the calls are made through the normal GL methods, one JNI call each.</li>
+ * <li>record + execute: the calls are recorded in a {@link GLCommandBuffer} and executed with a single native call, every frame.</li>
+ * <li>replay: the calls are recorded once and the buffer is executed every frame.</li>
+ * </ul>
+ * A hidden GLFW window is used for the context. Run with {@code LIBGL_ALWAYS_SOFTWARE=1} to measure with Mesa llvmpipe, so that the driver cost is
+ * small compared to the call overhead.
+ */
+public final class GLCommandBufferBenchmark {
+
+	private static final int CALLS_PER_FRAME = 10000;
+	private static final int FRAMES          = 1000;
+
+	private GLCommandBufferBenchmark() {
+	}
+
+	public static void main(String[] args) {
+		Sys.touch();
+
+		glfwSetErrorCallback(new ErrorCallback());
+		if ( glfwInit() != GL_TRUE )
+			throw new IllegalStateException("Unable to initialize GLFW");
+
+		glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+		long window = glfwCreateWindow(64, 64, "GLCommandBufferBenchmark", NULL, NULL);
+		if ( window == NULL )
+			throw new IllegalStateException("Unable to create the GLFW window");
+
+		glfwMakeContextCurrent(window);
+		GLContext.createFromCurrent();
+
+		System.out.println("GL_RENDERER: " + glGetString(GL_RENDERER));
+
+		GLCommandBuffer commands = new GLCommandBuffer();
+		GLCommandBuffer replay = new GLCommandBuffer();
+		try {
+			record(replay);
+
+			for ( int warmup = 0; warmup < 3; warmup++ ) {
+				long t = System.nanoTime();
+				for ( int frame = 0; frame < FRAMES; frame++ )
+					direct();
+				glFinish();
+				long direct = System.nanoTime() - t;
+
+				t = System.nanoTime();
+				for ( int frame = 0; frame < FRAMES; frame++ ) {
+					commands.clear();
+					record(commands);
+					commands.execute();
+				}
+				glFinish();
+				long recordExecute = System.nanoTime() - t;
+
+				t = System.nanoTime();
+				for ( int frame = 0; frame < FRAMES; frame++ )
+					replay.execute();
+				glFinish();
+				long replayTime = System.nanoTime() - t;
+
+				if ( warmup == 2 ) {
+					print("direct", direct);
+					print("record + execute", recordExecute);
+					print("replay", replayTime);
+				}
+			}
+		} finally {
+			replay.destroy();
+			commands.destroy();
+
+			glfwDestroyWindow(window);
+			glfwTerminate();
+		}
+	}
+
+	private static void direct() {
+		for ( int i = 0; i < CALLS_PER_FRAME; i += 2 ) {
+			glColor4f(1.0f, 0.5f, 0.25f, 1.0f);
+			glNormal3f(0.0f, 0.0f, 1.0f);
+		}
+	}
+
+	private static void record(GLCommandBuffer commands) {
+		for ( int i = 0; i < CALLS_PER_FRAME; i += 2 ) {
+			GL11.Recorder.glColor4f(commands, 1.0f, 0.5f, 0.25f, 1.0f);
+			GL11.Recorder.glNormal3f(commands, 0.0f, 0.0f, 1.0f);
+		}
+	}
+
+	private static void print(String name, long time) {
+		System.out.format("%-32s: %6.2fns/call%n", name, (double)time / FRAMES / CALLS_PER_FRAME);
+	}
+
+}
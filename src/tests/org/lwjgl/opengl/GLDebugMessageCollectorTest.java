@@ -0,0 +1,112 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.opengl;
+
+import org.testng.annotations.Test;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+
+import static org.lwjgl.opengl.GL43.*;
+import static org.lwjgl.opengl.GLDebugMessageCollector.*;
+import static org.lwjgl.system.MemoryUtil.*;
+import static org.testng.Assert.*;
+
+@Test
+public class GLDebugMessageCollectorTest {
+
+	/** Publishes a message the way the native callback does, in the current thread. Returns false if the ring is full. */
+	private static boolean publish(GLDebugMessageCollector collector, int source, int type, int id, String text) {
+		long ring = collector.address();
+
+		int position = memGetInt(ring + RING_HEAD);
+		int mask = memGetInt(ring + RING_MASK);
+		int messageSize = memGetInt(ring + RING_MESSAGE_SIZE);
+
+		long slot = ring + RING_HEADER_SIZE + (position & mask) * (SLOT_HEADER_SIZE + messageSize);
+		if ( memGetInt(slot + SLOT_SEQUENCE) != position )
+			return false;
+
+		ByteBuffer message = memEncodeUTF8(text, false);
+		memPutInt(slot + SLOT_SOURCE, source);
+		memPutInt(slot + SLOT_TYPE, type);
+		memPutInt(slot + SLOT_ID, id);
+		memPutInt(slot + SLOT_SEVERITY, GL_DEBUG_SEVERITY_LOW);
+		memPutInt(slot + SLOT_LENGTH, message.remaining());
+		memCopy(memAddress(message), slot + SLOT_HEADER_SIZE, Math.min(message.remaining(), messageSize));
+
+		memPutInt(ring + RING_HEAD, position + 1);
+		memPutInt(slot + SLOT_SEQUENCE, position + 1);
+		return true;
+	}
+
+	public void testRateLimit() {
+		final List<String> received = new ArrayList<String>();
+		final int[] suppressed = new int[1];
+
+		GLDebugMessageCollector collector = new GLDebugMessageCollector(new Handler() {
+			@Override
+			public void invoke(int source, int type, int id, int severity, String message, int suppressedCount) {
+				received.add(id + ":" + message);
+				suppressed[0] += suppressedCount;
+			}
+		}, 16, 8, 2, 1L, TimeUnit.HOURS);
+
+		try {
+			for ( int i = 0; i < 5; i++ )
+				assertTrue(publish(collector, GL_DEBUG_SOURCE_API, GL_DEBUG_TYPE_PERFORMANCE, 1, "slow path " + i));
+			assertTrue(publish(collector, GL_DEBUG_SOURCE_API, GL_DEBUG_TYPE_ERROR, 2, "error"));
+
+			assertEquals(collector.flush(), 6);
+			assertEquals(collector.flush(), 0);
+
+			// At most 2 messages per id and period, truncated to the message size
+			assertEquals(received.size(), 3);
+			assertEquals(received.get(0), "1:slow pat");
+			assertEquals(received.get(2), "2:error");
+			assertEquals(suppressed[0], 0);
+
+			assertEquals(collector.getMessageCount(), 2);
+			assertEquals(collector.getCount(GL_DEBUG_SOURCE_API, GL_DEBUG_TYPE_PERFORMANCE, 1), 5L);
+			assertEquals(collector.getCount(GL_DEBUG_SOURCE_API, GL_DEBUG_TYPE_ERROR, 2), 1L);
+			assertEquals(collector.getDroppedCount(), 0);
+		} finally {
+			collector.destroy();
+		}
+	}
+
+	public void testWrap() {
+		final int[] received = new int[1];
+
+		GLDebugMessageCollector collector = new GLDebugMessageCollector(new Handler() {
+			@Override
+			public void invoke(int source, int type, int id, int severity, String message, int suppressed) {
+				assertEquals(id, received[0]++);
+			}
+		}, 4, 16, 1, 1L, TimeUnit.HOURS);
+
+		try {
+			int id = 0;
+			for ( int round = 0; round < 10; round++ ) {
+				for ( int i = 0; i < 3; i++ )
+					assertTrue(publish(collector, GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_OTHER, id++, "message"));
+				assertEquals(collector.flush(), 3);
+			}
+
+			// Full ring
+			for ( int i = 0; i < 4; i++ )
+				assertTrue(publish(collector, GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_OTHER, id++, "message"));
+			assertFalse(publish(collector, GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_OTHER, id, "message"));
+			assertEquals(collector.flush(), 4);
+
+			assertEquals(received[0], id);
+		} finally {
+			collector.destroy();
+		}
+	}
+
+}
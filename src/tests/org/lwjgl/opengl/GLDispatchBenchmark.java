@@ -0,0 +1,116 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.opengl;
+
+/**
+ * Measures the per-call overhead of getting the {@link ContextCapabilities} of the current context, which every generated GL method does to get its
+ * function address:
+ * <ul>
+ * <li>ThreadLocal: the previous implementation, a ThreadLocal lookup on every call.</li>
+ * <li>GL.getCapabilities: the current implementation, which checks the thread the last context was made current in first.</li>
+ * <li>GL.getCapabilities (2 threads): same as above, while another thread also has a context current, so that the ThreadLocal fallback is used.</li>
+ * <li>hoisted: the capabilities instance is retrieved once, outside the loop.</li>
+ * </ul>
+ * A dummy {@link GLContext} is used, but the GL class still loads the OpenGL library on initialization.
+ */
+public final class GLDispatchBenchmark {
+
+	private static final int ITERATIONS = 100 * 1000 * 1000;
+
+	private static final ThreadLocal<GLContext> LEGACY_TL = new ThreadLocal<GLContext>();
+
+	private GLDispatchBenchmark() {
+	}
+
+	public static void main(String[] args) throws InterruptedException {
+		GLContext context = new DummyContext();
+		LEGACY_TL.set(context);
+
+		long sink = 0;
+		for ( int warmup = 0; warmup < 3; warmup++ ) {
+			GL.setCurrent(context);
+
+			long t = System.nanoTime();
+			for ( int i = 0; i < ITERATIONS; i++ )
+				sink += getCapabilitiesLegacy() == null ? 1 : 0;
+			long threadLocal = System.nanoTime() - t;
+
+			t = System.nanoTime();
+			for ( int i = 0; i < ITERATIONS; i++ )
+				sink += GL.getCapabilities() == null ? 1 : 0;
+			long fastPath = System.nanoTime() - t;
+
+			// Make another context current in a different thread
+			Thread other = new Thread() {
+				@Override
+				public void run() {
+					GL.setCurrent(new DummyContext());
+				}
+			};
+			other.start();
+			other.join();
+
+			t = System.nanoTime();
+			for ( int i = 0; i < ITERATIONS; i++ )
+				sink += GL.getCapabilities() == null ? 1 : 0;
+			long slowPath = System.nanoTime() - t;
+
+			ContextCapabilities hoisted = GL.getCapabilities();
+			t = System.nanoTime();
+			for ( int i = 0; i < ITERATIONS; i++ )
+				sink += hoisted == null ? 1 : 0;
+			long hoistedTime = System.nanoTime() - t;
+
+			if ( warmup == 2 ) {
+				print("ThreadLocal", threadLocal);
+				print("GL.getCapabilities", fastPath);
+				print("GL.getCapabilities (2 threads)", slowPath);
+				print("hoisted", hoistedTime);
+			}
+		}
+
+		if ( sink == 42 )
+			System.out.println();
+	}
+
+	private static ContextCapabilities getCapabilitiesLegacy() {
+		GLContext currentContext = LEGACY_TL.get();
+		if ( currentContext == null )
+			throw new IllegalStateException("There is no OpenGL context current in the current thread.");
+
+		return currentContext.capabilities;
+	}
+
+	private static void print(String name, long time) {
+		System.out.format("%-32s: %6.2fns/call%n", name, (double)time / ITERATIONS);
+	}
+
+	private static final class DummyContext extends GLContext {
+
+		DummyContext() {
+			super(null);
+		}
+
+		@Override
+		public long getHandle() { return 0L; }
+
+		@Override
+		protected void makeCurrentImpl(long target) {
+		}
+
+		@Override
+		protected void makeCurrentImpl(long targetDraw, long targetRead) {
+		}
+
+		@Override
+		public boolean isCurrent() { return true; }
+
+		@Override
+		protected void destroyImpl() {
+		}
+
+	}
+
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.BufferUtils;
+import org.lwjgl.PointerBuffer;
+
+import java.nio.ByteBuffer;
+import java.nio.IntBuffer;
+
+import static org.lwjgl.Pointer.*;
+import static org.lwjgl.system.APIUtil.*;
+import static org.lwjgl.system.MemoryStack.*;
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * Measures the overhead of the single-value return variants of generated methods (e.g. {@code int glGenBuffers()}), i.e. the work done around the
+ * native call: getting the thread-local APIBuffer, reserving the out-parameter, passing its address and reading the returned value.
+ * <p/>
+ * The native function is simulated with a JNI call that writes the output value ({@code nMemPutInt}/{@code nMemPutAddress}). The following
+ * implementations are compared:
+ * <ul>
+ * <li>APIBuffer: the current, address-based implementation.</li>
+ * <li>APIBuffer (ByteBuffer): the previous implementation, that reads values through ByteBuffer absolute gets.</li>
+ * <li>MemoryStack: the out-parameter is allocated on the thread-local stack.</li>
+ * </ul>
+ */
+public final class APIBufferBenchmark {
+
+	private static final int ITERATIONS = 20 * 1000 * 1000;
+
+	private static final ThreadLocal<LegacyAPIBuffer> LEGACY_BUFFERS = new ThreadLocal<LegacyAPIBuffer>() {
+		@Override
+		protected LegacyAPIBuffer initialValue() {
+			return new LegacyAPIBuffer();
+		}
+	};
+
+	private APIBufferBenchmark() {
+	}
+
+	public static void main(String[] args) {
+		long sink = 0;
+		for ( int warmup = 0; warmup < 3; warmup++ ) {
+			long t = System.nanoTime();
+			for ( int i = 0; i < ITERATIONS; i++ )
+				sink += genInt(i);
+			long apiBufferInt = System.nanoTime() - t;
+
+			t = System.nanoTime();
+			for ( int i = 0; i < ITERATIONS; i++ )
+				sink += genIntLegacy(i);
+			long legacyInt = System.nanoTime() - t;
+
+			t = System.nanoTime();
+			for ( int i = 0; i < ITERATIONS; i++ )
+				sink += genIntStack(i);
+			long stackInt = System.nanoTime() - t;
+
+			t = System.nanoTime();
+			for ( int i = 0; i < ITERATIONS; i++ )
+				sink += getPointer(i);
+			long apiBufferPointer = System.nanoTime() - t;
+
+			t = System.nanoTime();
+			for ( int i = 0; i < ITERATIONS; i++ )
+				sink += getPointerLegacy(i);
+			long legacyPointer = System.nanoTime() - t;
+
+			// Baseline: the JNI call alone, writing to a fixed address
+			long address = apiBuffer().address();
+			t = System.nanoTime();
+			for ( int i = 0; i < ITERATIONS; i++ )
+				nMemPutInt(address, i);
+			long jni = System.nanoTime() - t;
+
+			if ( warmup == 2 ) {
+				print("JNI call only", jni);
+				print("int: APIBuffer", apiBufferInt);
+				print("int: APIBuffer (ByteBuffer)", legacyInt);
+				print("int: MemoryStack", stackInt);
+				print("pointer: APIBuffer", apiBufferPointer);
+				print("pointer: APIBuffer (ByteBuffer)", legacyPointer);
+			}
+		}
+
+		if ( sink == 42 )
+			System.out.println();
+	}
+
+	private static int genInt(int value) {
+		APIBuffer __buffer = apiBuffer();
+		int buffers = __buffer.intParam();
+		nMemPutInt(__buffer.address() + buffers, value);
+		return __buffer.intValue(buffers);
+	}
+
+	private static int genIntLegacy(int value) {
+		LegacyAPIBuffer __buffer = LEGACY_BUFFERS.get().reset();
+		int buffers = __buffer.intParam();
+		nMemPutInt(__buffer.address() + buffers, value);
+		return __buffer.intValue(buffers);
+	}
+
+	private static int genIntStack(int value) {
+		MemoryStack stack = stackPush();
+		try {
+			IntBuffer buffers = stack.mallocInt(1);
+			nMemPutInt(memAddress(buffers), value);
+			return buffers.get(0);
+		} finally {
+			stack.pop();
+		}
+	}
+
+	private static long getPointer(int value) {
+		APIBuffer __buffer = apiBuffer();
+		int param = __buffer.pointerParam();
+		nMemPutAddress(__buffer.address() + param, value);
+		return __buffer.pointerValue(param);
+	}
+
+	private static long getPointerLegacy(int value) {
+		LegacyAPIBuffer __buffer = LEGACY_BUFFERS.get().reset();
+		int param = __buffer.pointerParam();
+		nMemPutAddress(__buffer.address() + param, value);
+		return __buffer.pointerValue(param);
+	}
+
+	private static void print(String name, long time) {
+		System.out.format("%-32s: %6.2fns/call%n", name, (double)time / ITERATIONS);
+	}
+
+	/** The relevant subset of the previous APIBuffer implementation. */
+	private static final class LegacyAPIBuffer {
+
+		private final ByteBuffer buffer = BufferUtils.createAlignedByteBufferPage(1024);
+		private final long       address = memAddress(buffer);
+
+		private int offset;
+
+		LegacyAPIBuffer reset() {
+			offset = 0;
+			return this;
+		}
+
+		long address() { return address; }
+
+		private int param(int bytes) {
+			int param = (offset + (bytes - 1)) & -bytes;
+			offset = param + bytes;
+			if ( buffer.capacity() < offset )
+				throw new IllegalStateException();
+			return param;
+		}
+
+		int intParam() { return param(4); }
+
+		int pointerParam() { return param(POINTER_SIZE); }
+
+		int intValue(int offset) { return buffer.getInt(offset); }
+
+		long pointerValue(int offset) { return PointerBuffer.get(buffer, offset); }
+
+	}
+
+}
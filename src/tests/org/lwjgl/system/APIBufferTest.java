@@ -8,6 +8,7 @@ import org.testng.annotations.Test;
 
 import static org.lwjgl.Pointer.*;
 import static org.lwjgl.system.APIUtil.*;
+import static org.lwjgl.system.MemoryUtil.*;
 import static org.testng.Assert.*;
 
 @Test
@@ -119,4 +120,60 @@ public class APIBufferTest {
 		assertEquals(w, 8);
 	}
 
+	public void testValues() {
+		APIBuffer buffer = new APIBuffer();
+
+		int i = buffer.intParam();
+		int l = buffer.longParam();
+		int p = buffer.pointerParam();
+		int s = buffer.stringParamUTF8("LWJGL", true);
+
+		buffer.intValue(i, 1).longValue(l, 2L).pointerValue(p, 3L);
+
+		assertEquals(buffer.intValue(i), 1);
+		assertEquals(buffer.longValue(l), 2L);
+		assertEquals(buffer.pointerValue(p), 3L);
+		assertEquals(buffer.stringValueUTF8(s, s + 5), "LWJGL");
+		assertEquals(memDecodeASCII(buffer.address() + s), "LWJGL");
+	}
+
+	public void testGrowth() {
+		APIBuffer buffer = new APIBuffer();
+
+		int first = buffer.intParam();
+		buffer.intValue(first, 42);
+
+		long address = buffer.address();
+
+		int large = buffer.bufferParam(64 * 1024);
+		buffer.intValue(large, 7);
+
+		assertTrue(address != buffer.address());
+
+		// The contents are preserved and the previous address is still valid
+		assertEquals(buffer.intValue(first), 42);
+		assertEquals(memGetInt(address + first), 42);
+		assertEquals(buffer.intValue(large), 7);
+
+		buffer.reset();
+		assertEquals(buffer.getOffset(), 0);
+	}
+
+	public void testPushGrowth() {
+		APIBuffer buffer = new APIBuffer();
+
+		// Push deeper than the initial stack capacity
+		int[] offsets = new int[10];
+		for ( int i = 0; i < offsets.length; i++ ) {
+			buffer.intParam();
+			offsets[i] = buffer.getOffset();
+			buffer.push();
+		}
+
+		for ( int i = offsets.length - 1; 0 <= i; i-- ) {
+			buffer.pop();
+			assertEquals(buffer.getOffset(), offsets[i]);
+		}
+	}
+
 }
\ No newline at end of file
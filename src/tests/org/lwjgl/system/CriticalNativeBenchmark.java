@@ -0,0 +1,127 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.openal.AL;
+import org.lwjgl.openal.ALContext;
+
+import java.lang.management.ManagementFactory;
+import java.nio.ByteBuffer;
+
+import static org.lwjgl.openal.AL10.*;
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * Measures the per-call overhead of primitive-only JNI methods that have JavaCritical_ variants: the nMemGet/nMemPut methods of {@link MemoryUtil}
+ * and the generated OpenAL functions marked with the criticalNative template modifier (alGetError, alIsSource, alSource3f). The OpenAL part is skipped
+ * if no OpenAL device is available.
+ * <p/>
+ * Run twice to compare the two paths:
+ * <ul>
+ * <li>{@code -XX:+UnlockExperimentalVMOptions -XX:+CriticalJNINatives}: critical natives, no JNIEnv/jclass arguments. The native-call thread state
+ * transition is still performed, so the difference only measures the JNI argument setup.</li>
+ * <li>{@code -XX:-CriticalJNINatives}: the normal JNI functions.</li>
+ * </ul>
+ * The default depends on the JVM version. The JVM arguments are printed before the results.
+ */
+public final class CriticalNativeBenchmark {
+
+	private static final int ITERATIONS = 50 * 1000 * 1000;
+
+	private CriticalNativeBenchmark() {
+	}
+
+	public static void main(String[] args) {
+		System.out.println("JVM arguments: " + ManagementFactory.getRuntimeMXBean().getInputArguments());
+
+		ByteBuffer buffer = memAlloc(8);
+		try {
+			long address = memAddress(buffer);
+
+			long sink = 0;
+			for ( int warmup = 0; warmup < 3; warmup++ ) {
+				long t = System.nanoTime();
+				for ( int i = 0; i < ITERATIONS; i++ )
+					nMemPutInt(address, i);
+				long put = System.nanoTime() - t;
+
+				t = System.nanoTime();
+				for ( int i = 0; i < ITERATIONS; i++ )
+					sink += nMemGetInt(address);
+				long get = System.nanoTime() - t;
+
+				t = System.nanoTime();
+				for ( int i = 0; i < ITERATIONS; i++ )
+					nMemPutAddress(address, nMemGetAddress(address) + 1);
+				long getPut = System.nanoTime() - t;
+
+				if ( warmup == 2 ) {
+					print("nMemPutInt", put, 1);
+					print("nMemGetInt", get, 1);
+					print("nMemGetAddress+nMemPutAddress", getPut, 2);
+				}
+			}
+
+			if ( sink == 42 )
+				System.out.println();
+		} finally {
+			memFree(buffer);
+		}
+
+		benchmarkAL();
+	}
+
+	private static void benchmarkAL() {
+		ALContext context;
+		try {
+			context = AL.create(null, 44100, 60, false);
+		} catch (Exception e) {
+			System.out.println("OpenAL is not available, skipping the generated bindings: " + e.getMessage());
+			return;
+		}
+
+		try {
+			int source = alGenSources();
+
+			long sink = 0;
+			for ( int warmup = 0; warmup < 3; warmup++ ) {
+				long t = System.nanoTime();
+				for ( int i = 0; i < ITERATIONS; i++ )
+					sink += alGetError();
+				long getError = System.nanoTime() - t;
+
+				t = System.nanoTime();
+				for ( int i = 0; i < ITERATIONS; i++ ) {
+					if ( alIsSource(source) )
+						sink++;
+				}
+				long isSource = System.nanoTime() - t;
+
+				t = System.nanoTime();
+				for ( int i = 0; i < ITERATIONS; i++ )
+					alSource3f(source, AL_POSITION, i, 0.0f, 0.0f);
+				long source3f = System.nanoTime() - t;
+
+				if ( warmup == 2 ) {
+					print("alGetError", getError, 1);
+					print("alIsSource", isSource, 1);
+					print("alSource3f", source3f, 1);
+				}
+			}
+
+			if ( sink == 42 )
+				System.out.println();
+
+			alDeleteSources(source);
+		} finally {
+			AL.destroy(context);
+		}
+	}
+
+	private static void print(String name, long time, int calls) {
+		System.out.format("%-32s: %6.2fns/call%n", name, (double)time / ITERATIONS / calls);
+	}
+
+}
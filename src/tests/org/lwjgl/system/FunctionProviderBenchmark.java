@@ -0,0 +1,107 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.openal.AL;
+import org.lwjgl.openal.ALC;
+import org.lwjgl.opencl.CL;
+import org.lwjgl.opengl.GL;
+
+import java.lang.reflect.Field;
+import java.lang.reflect.Modifier;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * Measures the time it takes to resolve the core functions of the OpenGL, OpenAL and OpenCL providers, with one
+ * {@link FunctionProvider#getFunctionAddress} call per function and with a single {@link APIUtil#apiGetFunctionAddresses} call. The function
+ * names are read from the {@code Functions} classes. Providers that fail to load are skipped.
+ * <p/>
+ * No context is required. The first round includes the one-time symbol lookup cost of the dynamic linker, which is closest to the startup cost.
+ */
+public final class FunctionProviderBenchmark {
+
+	private static final int ROUNDS = 100;
+
+	private FunctionProviderBenchmark() {
+	}
+
+	public static void main(String[] args) {
+		benchmark("GL", new ProviderFactory() {
+			public FunctionProvider get() { return GL.getFunctionProvider(); }
+		}, "org.lwjgl.opengl.GL", 11, 12, 13, 14, 15, 20, 21, 30, 31, 32, 33, 40, 41, 42, 43);
+		benchmark("ALC", new ProviderFactory() {
+			public FunctionProvider get() { return ALC.getFunctionProvider(); }
+		}, "org.lwjgl.openal.ALC", 10, 11);
+		benchmark("AL", new ProviderFactory() {
+			public FunctionProvider get() { return AL.getFunctionProvider(); }
+		}, "org.lwjgl.openal.AL", 10, 11);
+		benchmark("CL", new ProviderFactory() {
+			public FunctionProvider get() { return CL.getFunctionProvider(); }
+		}, "org.lwjgl.opencl.CL", 10, 11, 12);
+	}
+
+	private interface ProviderFactory {
+		FunctionProvider get();
+	}
+
+	private static void benchmark(String api, ProviderFactory factory, String classPrefix, int... versions) {
+		FunctionProvider provider;
+		try {
+			provider = factory.get();
+		} catch (Throwable t) {
+			System.out.println(api + ": unavailable (" + t + ")");
+			return;
+		}
+
+		List<String> names = new ArrayList<String>();
+		for ( int version : versions )
+			addFunctionNames(classPrefix + version, names);
+
+		StringBuilder packed = new StringBuilder();
+		for ( String name : names )
+			packed.append(name).append('\0');
+		ByteBuffer namesBuffer = memEncodeASCII(packed, false);
+
+		long[] addresses = new long[names.size()];
+
+		long sink = 0;
+		for ( int round = 0; round < ROUNDS; round++ ) {
+			long t = System.nanoTime();
+			for ( String name : names )
+				sink += provider.getFunctionAddress(name);
+			long single = System.nanoTime() - t;
+
+			t = System.nanoTime();
+			APIUtil.apiGetFunctionAddresses(provider, namesBuffer, addresses);
+			long bulk = System.nanoTime() - t;
+			sink += addresses[addresses.length - 1];
+
+			if ( round == 0 || round == ROUNDS - 1 ) {
+				String label = api + " (" + names.size() + " functions, " + (round == 0 ? "first" : "last") + " round)";
+				System.out.format("%-40s: single %8.2fus, bulk %8.2fus%n", label, single / 1000.0, bulk / 1000.0);
+			}
+		}
+
+		if ( sink == 42 )
+			System.out.println();
+	}
+
+	private static void addFunctionNames(String className, List<String> names) {
+		try {
+			for ( Field field : Class.forName(className + "$Functions").getDeclaredFields() ) {
+				int modifiers = field.getModifiers();
+				if ( field.getType() == long.class && Modifier.isPublic(modifiers) && !Modifier.isStatic(modifiers) )
+					names.add(field.getName());
+			}
+		} catch (ClassNotFoundException e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+}
@@ -0,0 +1,263 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import java.util.HashMap;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicBoolean;
+
+/**
+ * Compares {@link LongMap} and {@link ConcurrentLongMap} with {@link FastLongMap}, {@link HashMap} and {@link ConcurrentHashMap}. The keys are
+ * aligned addresses, like the native handles that are used as keys in the callback registries.
+ * <p/>
+ * The single-threaded rounds measure lookups of present and missing keys, put/remove churn and iteration. The concurrent rounds measure lookups from
+ * reader threads while another thread modifies the map; {@link FastLongMap} is synchronized in that case.
+ */
+@SuppressWarnings("deprecation")
+public final class LongMapBenchmark {
+
+	private static final int[] SIZES = { 8, 64, 1024, 16384 };
+
+	private static final int OPERATIONS = 1 << 22;
+	private static final int ROUNDS     = 5;
+
+	private static final long BASE = 0x7F0000001000L;
+
+	private static final int READERS = Math.max(1, Runtime.getRuntime().availableProcessors() - 1);
+
+	private LongMapBenchmark() {
+	}
+
+	private interface Map64 {
+		Object get(long key);
+
+		void put(long key, Object value);
+
+		void remove(long key);
+
+		int iterate();
+	}
+
+	public static void main(String[] args) throws InterruptedException {
+		for ( int size : SIZES ) {
+			System.out.println(size + " entries:");
+			benchmark("LongMap", createLongMap(), size);
+			benchmark("FastLongMap", createFastLongMap(), size);
+			benchmark("HashMap<Long>", createHashMap(new HashMap<Long, Object>()), size);
+		}
+
+		System.out.println(READERS + " readers, 1 writer:");
+		for ( int size : SIZES ) {
+			System.out.println(size + " entries:");
+			benchmarkConcurrent("ConcurrentLongMap", createConcurrentLongMap(), size);
+			benchmarkConcurrent("synchronized FastLongMap", createSynchronizedFastLongMap(), size);
+			benchmarkConcurrent("ConcurrentHashMap<Long>", createHashMap(new ConcurrentHashMap<Long, Object>()), size);
+		}
+	}
+
+	private static long key(int i) {
+		return BASE + ((long)i << 6);
+	}
+
+	private static void benchmark(String name, Map64 map, int size) {
+		for ( int i = 0; i < size; i++ )
+			map.put(key(i), Boolean.TRUE);
+
+		int mask = Integer.highestOneBit(size) - 1;
+
+		long sink = 0;
+		for ( int round = 0; round < ROUNDS; round++ ) {
+			long t = System.nanoTime();
+			for ( int i = 0; i < OPERATIONS; i++ ) {
+				if ( map.get(key(i & mask)) != null )
+					sink++;
+			}
+			long hit = System.nanoTime() - t;
+
+			t = System.nanoTime();
+			for ( int i = 0; i < OPERATIONS; i++ ) {
+				if ( map.get(key(size + (i & mask))) != null )
+					sink++;
+			}
+			long miss = System.nanoTime() - t;
+
+			t = System.nanoTime();
+			for ( int i = 0; i < OPERATIONS; i++ ) {
+				long key = key(size + (i & mask));
+				map.put(key, Boolean.TRUE);
+				map.remove(key);
+			}
+			long churn = System.nanoTime() - t;
+
+			int iterations = Math.max(1, OPERATIONS / size);
+			t = System.nanoTime();
+			for ( int i = 0; i < iterations; i++ )
+				sink += map.iterate();
+			long iterate = System.nanoTime() - t;
+
+			if ( round == ROUNDS - 1 ) {
+				System.out.format(
+					"\t%-28s: get hit %6.2fns, get miss %6.2fns, put+remove %6.2fns, iterate %6.2fns/entry%n",
+					name, (double)hit / OPERATIONS, (double)miss / OPERATIONS, (double)churn / OPERATIONS, (double)iterate / (iterations * size)
+				);
+			}
+		}
+
+		if ( sink == 42 )
+			System.out.println();
+	}
+
+	private static void benchmarkConcurrent(String name, final Map64 map, final int size) throws InterruptedException {
+		for ( int i = 0; i < size; i++ )
+			map.put(key(i), Boolean.TRUE);
+
+		final int mask = Integer.highestOneBit(size) - 1;
+
+		for ( int round = 0; round < ROUNDS; round++ ) {
+			final AtomicBoolean running = new AtomicBoolean(true);
+
+			// The writer registers and unregisters a key, like a callback registry does when objects are created and destroyed.
+			Thread writer = new Thread() {
+				@Override
+				public void run() {
+					long key = key(size);
+					while ( running.get() ) {
+						map.put(key, Boolean.TRUE);
+						map.remove(key);
+						Thread.yield();
+					}
+				}
+			};
+
+			final long[] times = new long[READERS];
+			Thread[] readers = new Thread[READERS];
+			for ( int r = 0; r < READERS; r++ ) {
+				final int reader = r;
+				readers[r] = new Thread() {
+					@Override
+					public void run() {
+						long sink = 0;
+						long t = System.nanoTime();
+						for ( int i = 0; i < OPERATIONS; i++ ) {
+							if ( map.get(key(i & mask)) != null )
+								sink++;
+						}
+						times[reader] = System.nanoTime() - t;
+
+						if ( sink != OPERATIONS )
+							throw new IllegalStateException();
+					}
+				};
+			}
+
+			writer.start();
+			for ( Thread reader : readers )
+				reader.start();
+			for ( Thread reader : readers )
+				reader.join();
+			running.set(false);
+			writer.join();
+
+			if ( round == ROUNDS - 1 ) {
+				long total = 0;
+				for ( long time : times )
+					total += time;
+
+				System.out.format("\t%-28s: get %6.2fns%n", name, (double)total / (READERS * (long)OPERATIONS));
+			}
+		}
+	}
+
+	private static Map64 createLongMap() {
+		final LongMap<Object> map = new LongMap<Object>();
+		return new Map64() {
+			public Object get(long key) { return map.get(key); }
+
+			public void put(long key, Object value) { map.put(key, value); }
+
+			public void remove(long key) { map.remove(key); }
+
+			public int iterate() {
+				int count = 0;
+				for ( LongMap.Cursor<Object> cursor = map.cursor(); cursor.next(); )
+					count += (int)cursor.key();
+				return count;
+			}
+		};
+	}
+
+	private static Map64 createConcurrentLongMap() {
+		final ConcurrentLongMap<Object> map = new ConcurrentLongMap<Object>();
+		return new Map64() {
+			public Object get(long key) { return map.get(key); }
+
+			public void put(long key, Object value) { map.put(key, value); }
+
+			public void remove(long key) { map.remove(key); }
+
+			public int iterate() {
+				int count = 0;
+				for ( LongMap.Cursor<Object> cursor = map.cursor(); cursor.next(); )
+					count += (int)cursor.key();
+				return count;
+			}
+		};
+	}
+
+	private static Map64 createFastLongMap() {
+		final FastLongMap<Object> map = new FastLongMap<Object>();
+		return new Map64() {
+			public Object get(long key) { return map.get(key); }
+
+			public void put(long key, Object value) { map.put(key, value); }
+
+			public void remove(long key) { map.remove(key); }
+
+			public int iterate() {
+				int count = 0;
+				for ( FastLongMap.Entry<Object> entry : map )
+					count += (int)entry.getKey();
+				return count;
+			}
+		};
+	}
+
+	private static Map64 createSynchronizedFastLongMap() {
+		final FastLongMap<Object> map = new FastLongMap<Object>();
+		return new Map64() {
+			public synchronized Object get(long key) { return map.get(key); }
+
+			public synchronized void put(long key, Object value) { map.put(key, value); }
+
+			public synchronized void remove(long key) { map.remove(key); }
+
+			public synchronized int iterate() {
+				int count = 0;
+				for ( FastLongMap.Entry<Object> entry : map )
+					count += (int)entry.getKey();
+				return count;
+			}
+		};
+	}
+
+	private static Map64 createHashMap(final Map<Long, Object> map) {
+		return new Map64() {
+			public Object get(long key) { return map.get(key); }
+
+			public void put(long key, Object value) { map.put(key, value); }
+
+			public void remove(long key) { map.remove(key); }
+
+			public int iterate() {
+				int count = 0;
+				for ( Long key : map.keySet() )
+					count += key.intValue();
+				return count;
+			}
+		};
+	}
+
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.testng.annotations.Test;
+
+import java.util.HashMap;
+import java.util.Map;
+import java.util.Random;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicReference;
+
+import static org.testng.Assert.*;
+
+@Test
+public class LongMapTest {
+
+	public void testBasic() {
+		LongMap<String> map = new LongMap<String>();
+		assertTrue(map.isEmpty());
+		assertNull(map.get(0L));
+
+		assertNull(map.put(0L, "zero"));
+		assertNull(map.put(-1L, "minus one"));
+		assertEquals(map.put(0L, "0"), "zero");
+
+		assertEquals(map.size(), 2);
+		assertEquals(map.get(0L), "0");
+		assertEquals(map.get(-1L), "minus one");
+		assertTrue(map.containsKey(-1L));
+		assertFalse(map.containsKey(1L));
+
+		assertEquals(map.remove(0L), "0");
+		assertNull(map.remove(0L));
+		assertEquals(map.size(), 1);
+
+		map.clear();
+		assertTrue(map.isEmpty());
+		assertNull(map.get(-1L));
+	}
+
+	public void testAgainstHashMap() {
+		Random random = new Random(42L);
+
+		LongMap<Long> map = new LongMap<Long>(0);
+		Map<Long, Long> reference = new HashMap<Long, Long>();
+
+		// Few distinct keys with colliding low bits, so that probe sequences are long and removals shift entries
+		for ( int i = 0; i < 200000; i++ ) {
+			long key = (long)random.nextInt(512) << 12;
+			switch ( random.nextInt(3) ) {
+				case 0:
+					assertEquals(map.put(key, (long)i), reference.put(key, (long)i));
+					break;
+				case 1:
+					assertEquals(map.remove(key), reference.remove(key));
+					break;
+				default:
+					assertEquals(map.get(key), reference.get(key));
+			}
+			assertEquals(map.size(), reference.size());
+		}
+
+		int count = 0;
+		for ( LongMap.Cursor<Long> cursor = map.cursor(); cursor.next(); ) {
+			assertEquals(cursor.value(), reference.get(cursor.key()));
+			count++;
+		}
+		assertEquals(count, reference.size());
+	}
+
+	public void testConcurrentReads() throws InterruptedException {
+		final ConcurrentLongMap<Long> map = new ConcurrentLongMap<Long>();
+		for ( long i = 0; i < 64; i++ )
+			map.put(i << 6, i);
+
+		final AtomicBoolean running = new AtomicBoolean(true);
+		final AtomicReference<String> error = new AtomicReference<String>();
+
+		Thread reader = new Thread() {
+			@Override
+			public void run() {
+				while ( running.get() ) {
+					for ( long i = 0; i < 64; i++ ) {
+						Long value = map.get(i << 6);
+						if ( value == null || value != i )
+							error.set("Missing key: " + (i << 6));
+					}
+				}
+			}
+		};
+		reader.start();
+
+		// Churn other keys, the stable keys must always be visible to the reader
+		for ( int i = 0; i < 10000; i++ ) {
+			long key = (64L + (i & 255)) << 6;
+			map.put(key, -1L);
+			map.remove(key);
+		}
+
+		running.set(false);
+		reader.join();
+
+		assertNull(error.get());
+		assertEquals(map.size(), 64);
+		assertNull(map.putIfAbsent(1L, 1L));
+		assertEquals(map.putIfAbsent(1L, 2L), Long.valueOf(1L));
+	}
+
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import java.nio.ByteBuffer;
+import java.nio.FloatBuffer;
+
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * Measures the throughput of memCopy, memSet and memFillFloat for block sizes from 8 bytes to 256MB (or the specified maximum), against:
+ * <ul>
+ * <li>nMemCopy/nMemSet: a plain JNI call to memcpy/memset, for every size.</li>
+ * <li>ByteBuffer.put(ByteBuffer) and FloatBuffer.put(int, float) loops.</li>
+ * </ul>
+ * Each measurement moves about 1GB in total, so small sizes are dominated by the per-call overhead.
+ * <p/>
+ * Usage: MemoryCopyBenchmark [max size in MB, default: 256]
+ */
+public final class MemoryCopyBenchmark {
+
+	private static final long TOTAL_BYTES = 1L << 30;
+
+	private static final int MAX_ITERATIONS = 10 * 1000 * 1000;
+
+	private MemoryCopyBenchmark() {
+	}
+
+	public static void main(String[] args) {
+		int maxSize = (args.length == 0 ? 256 : Integer.parseInt(args[0])) * 1024 * 1024;
+
+		ByteBuffer src = memAlignedAlloc(PAGE_SIZE, maxSize);
+		ByteBuffer dst = memAlignedAlloc(PAGE_SIZE, maxSize);
+		try {
+			// Fault-in all pages
+			memSet(memAddress(src), 1, maxSize);
+			memSet(memAddress(dst), 2, maxSize);
+
+			System.out.println("Streaming copy threshold: " + (MEM_COPY_STREAMING_THRESHOLD >> 10) + "KB");
+			System.out.format("%10s | %10s %10s %10s | %10s %10s | %10s %10s  (GB/s)%n",
+			                  "size", "memCopy", "nMemCopy", "put", "memSet", "nMemSet", "memFill", "put(float)");
+
+			for ( int warmup = 0; warmup < 2; warmup++ ) {
+				for ( int size = 8; 0 < size && size <= maxSize; size <<= 2 ) {
+					run(src, dst, size, warmup == 1);
+					if ( size < maxSize && maxSize < size << 2 )
+						run(src, dst, maxSize, warmup == 1);
+				}
+			}
+		} finally {
+			memAlignedFree(dst);
+			memAlignedFree(src);
+		}
+	}
+
+	private static void run(ByteBuffer src, ByteBuffer dst, int size, boolean print) {
+		int iterations = (int)Math.max(2, Math.min(MAX_ITERATIONS, TOTAL_BYTES / size));
+
+		long s = memAddress(src);
+		long d = memAddress(dst);
+
+		ByteBuffer srcView = memByteBuffer(s, size);
+		ByteBuffer dstView = memByteBuffer(d, size);
+		FloatBuffer floatView = memFloatBuffer(d, size >> 2);
+
+		long t = System.nanoTime();
+		for ( int i = 0; i < iterations; i++ )
+			memCopy(s, d, size);
+		long memCopy = System.nanoTime() - t;
+
+		t = System.nanoTime();
+		for ( int i = 0; i < iterations; i++ )
+			nMemCopy(d, s, size);
+		long nMemCopy = System.nanoTime() - t;
+
+		t = System.nanoTime();
+		for ( int i = 0; i < iterations; i++ ) {
+			dstView.clear();
+			srcView.clear();
+			dstView.put(srcView);
+		}
+		long put = System.nanoTime() - t;
+
+		t = System.nanoTime();
+		for ( int i = 0; i < iterations; i++ )
+			memSet(d, i, size);
+		long memSet = System.nanoTime() - t;
+
+		t = System.nanoTime();
+		for ( int i = 0; i < iterations; i++ )
+			nMemSet(d, i, size);
+		long nMemSet = System.nanoTime() - t;
+
+		int floats = size >> 2;
+
+		t = System.nanoTime();
+		for ( int i = 0; i < iterations; i++ )
+			memFillFloat(d, i, floats);
+		long memFill = System.nanoTime() - t;
+
+		t = System.nanoTime();
+		for ( int i = 0; i < iterations; i++ ) {
+			for ( int j = 0; j < floats; j++ )
+				floatView.put(j, i);
+		}
+		long putFloat = System.nanoTime() - t;
+
+		if ( !print )
+			return;
+
+		double bytes = (double)size * iterations;
+		System.out.format("%10s | %10.2f %10.2f %10.2f | %10.2f %10.2f | %10.2f %10.2f%n",
+		                  formatSize(size),
+		                  bytes / memCopy, bytes / nMemCopy, bytes / put,
+		                  bytes / memSet, bytes / nMemSet,
+		                  bytes / memFill, bytes / putFloat
+		);
+	}
+
+	private static String formatSize(int size) {
+		if ( size < 1024 )
+			return size + "B";
+		if ( size < 1024 * 1024 )
+			return (size >> 10) + "KB";
+		return (size >> 20) + "MB";
+	}
+
+}
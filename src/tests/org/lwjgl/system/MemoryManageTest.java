@@ -0,0 +1,86 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.system.MemoryManage.DebugAllocator;
+import org.testng.annotations.Test;
+
+import java.util.List;
+
+import static org.lwjgl.system.MemoryUtil.*;
+import static org.testng.Assert.*;
+
+@Test
+public class MemoryManageTest {
+
+	public void testDebugAllocator() {
+		DebugAllocator allocator = new DebugAllocator(new MemoryManage.StdlibAllocator());
+
+		long a = allocator.malloc(16);
+		long b = allocator.calloc(4, 8);
+		long c = allocator.aligned_alloc(64, 128);
+
+		assertEquals(allocator.getLiveCount(), 3);
+		assertEquals(allocator.getLiveBytes(), 16 + 32 + 128);
+
+		b = allocator.realloc(b, 64);
+		assertEquals(allocator.getLiveBytes(), 16 + 64 + 128);
+
+		allocator.free(a);
+		allocator.aligned_free(c);
+
+		assertEquals(allocator.getLiveCount(), 1);
+		assertEquals(allocator.getLiveBytes(), 64);
+
+		List<DebugAllocator.CallSite> sites = allocator.getCallSites();
+		assertFalse(sites.isEmpty());
+		assertEquals(sites.get(0).getLocation().getClassName(), MemoryManageTest.class.getName());
+
+		allocator.free(b);
+		assertEquals(allocator.getLiveCount(), 0);
+		assertEquals(allocator.getLiveBytes(), 0);
+	}
+
+	public void testDebugAllocatorErrors() {
+		DebugAllocator allocator = new DebugAllocator(new MemoryManage.StdlibAllocator());
+
+		long a = allocator.malloc(16);
+		allocator.free(a);
+		allocator.free(a); // double free, must not reach the system allocator
+
+		long b = allocator.aligned_alloc(64, 16);
+		allocator.free(b); // mismatched free, must not reach the system allocator
+		assertEquals(allocator.getLiveCount(), 1);
+		allocator.aligned_free(b);
+
+		assertEquals(allocator.getLiveCount(), 0);
+	}
+
+	public void testBumpAllocator() {
+		BumpAllocator allocator = new BumpAllocator(1024);
+		try {
+			long a = allocator.malloc(3);
+			long b = allocator.aligned_alloc(64, 8);
+			assertEquals(a & 15, 0L);
+			assertEquals(b & 63, 0L);
+			assertTrue(a < b);
+
+			// In-place growth of the last allocation
+			assertEquals(allocator.realloc(b, 64), b);
+
+			allocator.free(b);
+			assertEquals(allocator.malloc(8), b);
+
+			assertEquals(allocator.malloc(2048), NULL);
+
+			allocator.reset();
+			assertEquals(allocator.getOffset(), 0L);
+			assertEquals(allocator.malloc(3), a);
+		} finally {
+			allocator.destroy();
+		}
+	}
+
+}
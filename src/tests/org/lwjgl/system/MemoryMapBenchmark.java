@@ -0,0 +1,131 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.BufferUtils;
+
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.ByteBuffer;
+import java.util.Random;
+
+import static org.lwjgl.system.MemoryUtil.*;
+
+/**
+ * Compares the time it takes to get the contents of a file into a direct ByteBuffer, ready to be passed to glBufferData, alBufferData, etc:
+ * <ul>
+ * <li>read-and-copy: the file is read into a heap array, which is then copied to a new direct ByteBuffer.</li>
+ * <li>memMapFile: the file is memory-mapped and every page is touched once.</li>
+ * <li>memMapFile + SEQUENTIAL: same as above, with a {@link MemoryUtil#MEM_ADVICE_SEQUENTIAL} hint.</li>
+ * </ul>
+ * The file is read once before each measurement, so all methods are measured with a warm page cache.
+ * <p/>
+ * Usage: MemoryMapBenchmark [file size in MB, default: 128]
+ */
+public final class MemoryMapBenchmark {
+
+	private static final int ITERATIONS = 10;
+
+	private MemoryMapBenchmark() {
+	}
+
+	public static void main(String[] args) throws IOException {
+		int size = (args.length == 0 ? 128 : Integer.parseInt(args[0])) * 1024 * 1024;
+
+		File file = File.createTempFile("lwjgl", ".bin");
+		file.deleteOnExit();
+		createFile(file, size);
+
+		String path = file.getPath();
+
+		System.out.println("File size: " + (size >> 20) + "MB");
+
+		long sink = 0;
+		for ( int warmup = 0; warmup < 2; warmup++ ) {
+			long readCopy = 0, mmap = 0, mmapSeq = 0;
+
+			for ( int i = 0; i < ITERATIONS; i++ ) {
+				long t = System.nanoTime();
+				ByteBuffer buffer = readAndCopy(file, size);
+				sink += touch(buffer);
+				readCopy += System.nanoTime() - t;
+
+				t = System.nanoTime();
+				buffer = memMapFile(path, MEM_MAP_READ_ONLY);
+				sink += touch(buffer);
+				memUnmapFile(buffer);
+				mmap += System.nanoTime() - t;
+
+				t = System.nanoTime();
+				buffer = memMapFile(path, MEM_MAP_READ_ONLY);
+				memAdvise(buffer, MEM_ADVICE_SEQUENTIAL);
+				sink += touch(buffer);
+				memUnmapFile(buffer);
+				mmapSeq += System.nanoTime() - t;
+			}
+
+			if ( warmup == 1 ) {
+				print("read-and-copy", readCopy, size);
+				print("memMapFile", mmap, size);
+				print("memMapFile + SEQUENTIAL", mmapSeq, size);
+			}
+		}
+
+		if ( sink == 42 )
+			System.out.println();
+	}
+
+	private static void createFile(File file, int size) throws IOException {
+		byte[] data = new byte[1024 * 1024];
+		new Random(0).nextBytes(data);
+
+		FileOutputStream out = new FileOutputStream(file);
+		try {
+			for ( int i = 0; i < size; i += data.length )
+				out.write(data, 0, Math.min(data.length, size - i));
+		} finally {
+			out.close();
+		}
+	}
+
+	private static ByteBuffer readAndCopy(File file, int size) throws IOException {
+		byte[] data = new byte[size];
+
+		InputStream in = new FileInputStream(file);
+		try {
+			int offset = 0;
+			while ( offset < size ) {
+				int bytes = in.read(data, offset, size - offset);
+				if ( bytes == -1 )
+					break;
+				offset += bytes;
+			}
+		} finally {
+			in.close();
+		}
+
+		ByteBuffer buffer = BufferUtils.createByteBuffer(size);
+		buffer.put(data);
+		buffer.flip();
+		return buffer;
+	}
+
+	// Reads one byte per page, which is what an upload to the driver would fault in.
+	private static long touch(ByteBuffer buffer) {
+		long sum = 0;
+		for ( int i = 0; i < buffer.capacity(); i += PAGE_SIZE )
+			sum += buffer.get(i);
+		return sum;
+	}
+
+	private static void print(String name, long time, int size) {
+		double ms = time / 1e6 / ITERATIONS;
+		System.out.format("%-24s: %8.2fms (%.1f MB/s)%n", name, ms, (size >> 20) / (ms / 1000.0));
+	}
+
+}
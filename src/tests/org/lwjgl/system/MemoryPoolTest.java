@@ -0,0 +1,106 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.testng.annotations.Test;
+
+import java.nio.ByteBuffer;
+import java.util.HashSet;
+import java.util.Set;
+
+import static org.lwjgl.system.MemoryPool.*;
+import static org.lwjgl.system.MemoryUtil.*;
+import static org.testng.Assert.*;
+
+@Test
+public class MemoryPoolTest {
+
+	public void testSizeClasses() {
+		for ( int size = 1; size <= MAX_BLOCK_SIZE; size = size * 3 / 2 + 1 ) {
+			ByteBuffer buffer = poolAlloc(size);
+			assertEquals(buffer.capacity(), size);
+
+			int blockSize = Math.max(MIN_BLOCK_SIZE, Integer.highestOneBit(size - 1) << 1);
+			assertEquals(memAddress(buffer) & (Math.min(blockSize, PAGE_SIZE) - 1), 0L);
+
+			poolFree(buffer);
+		}
+	}
+
+	public void testReuse() {
+		long a = npoolAlloc(24);
+		npoolFree(a, 24);
+		assertEquals(npoolAlloc(32), a);
+		npoolFree(a, 32);
+	}
+
+	public void testBatches() {
+		// Allocate more blocks than a thread cache can hold, forcing refills and drains
+		long[] blocks = new long[1000];
+		Set<Long> unique = new HashSet<Long>();
+
+		for ( int i = 0; i < blocks.length; i++ ) {
+			blocks[i] = npoolAlloc(48);
+			memPutLong(blocks[i], i);
+			assertTrue(unique.add(blocks[i]));
+		}
+
+		for ( int i = 0; i < blocks.length; i++ )
+			assertEquals(memGetLong(blocks[i]), i);
+
+		for ( long block : blocks )
+			npoolFree(block, 48);
+	}
+
+	public void testCrossThreadRelease() throws InterruptedException {
+		final long block = npoolAlloc(100);
+
+		Thread t = new Thread() {
+			@Override
+			public void run() {
+				npoolFree(block, 100);
+			}
+		};
+		t.start();
+		t.join();
+	}
+
+	public void testThreadCacheReclaim() throws InterruptedException {
+		final long block = npoolAlloc(2000);
+
+		// The block is cached by a thread that terminates
+		Thread t = new Thread() {
+			@Override
+			public void run() {
+				npoolFree(block, 2000);
+			}
+		};
+		t.start();
+		t.join();
+
+		flushThreadCache();
+
+		long[] blocks = new long[64];
+		boolean reused = false;
+		for ( int i = 0; i < blocks.length; i++ ) {
+			blocks[i] = npoolAlloc(2000);
+			if ( blocks[i] == block )
+				reused = true;
+		}
+
+		for ( long b : blocks )
+			npoolFree(b, 2000);
+
+		assertTrue(reused);
+	}
+
+	public void testLarge() {
+		ByteBuffer buffer = poolCalloc(MAX_BLOCK_SIZE + 1);
+		for ( int i = 0; i < buffer.capacity(); i++ )
+			assertEquals(buffer.get(i), 0);
+		poolFree(buffer);
+	}
+
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.PointerBuffer;
+import org.testng.annotations.Test;
+
+import java.nio.ByteBuffer;
+import java.nio.IntBuffer;
+import java.nio.LongBuffer;
+
+import static org.lwjgl.Pointer.*;
+import static org.lwjgl.system.MemoryStack.*;
+import static org.lwjgl.system.MemoryUtil.*;
+import static org.testng.Assert.*;
+
+@Test
+public class MemoryStackTest {
+
+	public void testFrames() {
+		MemoryStack stack = stackGet();
+
+		int pointer = stack.getPointer();
+		int depth = stack.getFrameIndex();
+
+		stack.push();
+		stack.mallocInt(1);
+		stack.push();
+		stack.mallocLong(4);
+		assertEquals(stack.getFrameIndex(), depth + 2);
+		stack.pop();
+		stack.pop();
+
+		assertEquals(stack.getPointer(), pointer);
+		assertEquals(stack.getFrameIndex(), depth);
+	}
+
+	public void testDeepFrames() {
+		MemoryStack stack = stackGet();
+
+		int pointer = stack.getPointer();
+		for ( int i = 0; i < 100; i++ ) {
+			stack.push();
+			stack.mallocInt(1);
+		}
+		for ( int i = 0; i < 100; i++ )
+			stack.pop();
+
+		assertEquals(stack.getPointer(), pointer);
+	}
+
+	public void testAlignment() {
+		MemoryStack stack = stackPush();
+		try {
+			stack.malloc(1, 1);
+			IntBuffer i = stack.mallocInt(1);
+			stack.malloc(1, 1);
+			LongBuffer l = stack.mallocLong(1);
+			stack.malloc(1, 1);
+			PointerBuffer p = stack.mallocPointer(1);
+			stack.malloc(1, 1);
+			ByteBuffer a = stack.malloc(64, 8);
+
+			assertEquals(memAddress(i) & 3, 0);
+			assertEquals(memAddress(l) & 7, 0);
+			assertEquals(memAddress(p) & (POINTER_SIZE - 1), 0);
+			assertEquals(memAddress(a) & 63, 0);
+		} finally {
+			stack.pop();
+		}
+	}
+
+	public void testCalloc() {
+		MemoryStack stack = stackPush();
+		try {
+			IntBuffer dirty = stack.mallocInt(16);
+			for ( int i = 0; i < 16; i++ )
+				dirty.put(i, -1);
+		} finally {
+			stack.pop();
+		}
+
+		stack = stackPush();
+		try {
+			IntBuffer clean = stack.callocInt(16);
+			for ( int i = 0; i < 16; i++ )
+				assertEquals(clean.get(i), 0);
+		} finally {
+			stack.pop();
+		}
+	}
+
+	public void testASCII() {
+		MemoryStack stack = stackPush();
+		try {
+			ByteBuffer text = stack.ASCII("LWJGL");
+			assertEquals(text.capacity(), 6);
+			assertEquals(text.get(5), 0);
+			assertEquals(memDecodeASCII(text, 5), "LWJGL");
+		} finally {
+			stack.pop();
+		}
+	}
+
+	public void testUTF8() {
+		MemoryStack stack = stackPush();
+		try {
+			ByteBuffer text = stack.UTF8("\u00e9t\u00e9");
+			assertEquals(text.capacity(), 6);
+			assertEquals(memDecodeUTF8(text, 5), "\u00e9t\u00e9");
+
+			text = stack.UTF16("LWJGL", false);
+			assertEquals(text.capacity(), 10);
+			assertEquals(memDecodeUTF16(text), "LWJGL");
+		} finally {
+			stack.pop();
+		}
+	}
+
+	@Test(expectedExceptions = OutOfMemoryError.class)
+	public void testOverflow() {
+		MemoryStack stack = new MemoryStack(64);
+		stack.push();
+		stack.malloc(65);
+	}
+
+	@Test(expectedExceptions = IllegalStateException.class)
+	public void testUnderflow() {
+		new MemoryStack(64).pop();
+	}
+
+}
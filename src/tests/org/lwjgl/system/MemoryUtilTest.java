@@ -7,8 +7,14 @@ package org.lwjgl.system;
 import org.lwjgl.BufferUtils;
 import org.testng.annotations.Test;
 
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.UnsupportedEncodingException;
 import java.nio.*;
+import java.nio.charset.Charset;
 
+import static org.lwjgl.system.MathUtil.*;
 import static org.lwjgl.system.MemoryUtil.*;
 import static org.testng.Assert.*;
 
@@ -39,6 +45,147 @@ public class MemoryUtilTest {
 			assertEquals(src.get(i), dst.get(i));
 	}
 
+	public void testMemCopySizes() {
+		// Covers the small, Unsafe/JNI and streaming paths, with aligned and unaligned addresses
+		int[] sizes = { 0, 1, 7, 8, 13, 64, 65, 1000, (int)Math.min(MEM_COPY_STREAMING_THRESHOLD + 77, 64 * 1024 * 1024) };
+
+		for ( int size : sizes ) {
+			ByteBuffer src = BufferUtils.createByteBuffer(size + 3);
+			ByteBuffer dst = BufferUtils.createByteBuffer(size + 3);
+
+			for ( int i = 0; i < src.capacity(); i++ )
+				src.put(i, (byte)(i * 31));
+
+			for ( int offset = 0; offset < 2; offset++ ) {
+				memSet(memAddress(dst), 0, dst.capacity());
+				memCopy(memAddress(src) + offset, memAddress(dst) + offset, size);
+
+				for ( int i = 0; i < dst.capacity(); i++ )
+					assertEquals(dst.get(i), offset <= i && i < offset + size ? src.get(i) : 0);
+
+				memSet(memAddress(dst) + offset, 0x55, size);
+				for ( int i = 0; i < dst.capacity(); i++ )
+					assertEquals(dst.get(i), offset <= i && i < offset + size ? 0x55 : 0);
+			}
+		}
+	}
+
+	public void testMemFill() {
+		ByteBuffer buffer = BufferUtils.createByteBuffer(1024 * 8 + 8);
+		long address = memAddress(buffer);
+
+		for ( int count : new int[] { 1, 5, 1024 } ) {
+			memSet(address, 0, buffer.capacity());
+
+			memFillFloat(address, 1.5f, count);
+			for ( int i = 0; i < count; i++ )
+				assertEquals(buffer.getFloat(i << 2), 1.5f);
+			assertEquals(buffer.getInt(count << 2), 0);
+
+			memFillShort(address, (short)0x1234, count);
+			for ( int i = 0; i < count; i++ )
+				assertEquals(buffer.getShort(i << 1), 0x1234);
+
+			memFillLong(address, 0x0102030405060708L, count);
+			for ( int i = 0; i < count; i++ )
+				assertEquals(buffer.getLong(i << 3), 0x0102030405060708L);
+			assertEquals(buffer.getLong(count << 3), 0L);
+		}
+	}
+
+	@Test(expectedExceptions = IllegalArgumentException.class)
+	public void testMemFillUnaligned() {
+		ByteBuffer buffer = BufferUtils.createByteBuffer(16);
+		memFillInt(memAddress(buffer) + 1, 0, 2);
+	}
+
+	public void testEncodeUTF8() throws UnsupportedEncodingException {
+		String[] strings = {
+			"",
+			"glGetUniformLocation",
+			"caf\u00e9",
+			"\u20ac 100",
+			"\ud83d\ude00 surrogate pair",
+			"ASCII prefix, then \u00fc\u00f1\u00ee\u00e7\u00f8\u00f0\u00e9"
+		};
+
+		ByteBuffer target = BufferUtils.createByteBuffer(256);
+		for ( String s : strings ) {
+			byte[] expected = s.getBytes("UTF-8");
+
+			assertEquals(memLengthUTF8(s, false), expected.length);
+			assertEquals(memLengthUTF8(s, true), expected.length + 1);
+
+			target.position(3);
+			assertEquals(memEncodeUTF8(s, true, target), expected.length + 1);
+			assertEquals(target.position(), 3);
+
+			for ( int i = 0; i < expected.length; i++ )
+				assertEquals(target.get(3 + i), expected[i]);
+			assertEquals(target.get(3 + expected.length), 0);
+
+			assertEquals(memDecodeUTF8(memEncodeUTF8(s, false)), s);
+			assertEquals(memDecode(memEncode(s, Charset.forName("UTF-8"), false), Charset.forName("UTF-8")), s);
+		}
+	}
+
+	public void testEncodeASCII() {
+		ByteBuffer target = BufferUtils.createByteBuffer(16);
+		target.position(1);
+
+		assertEquals(memEncodeASCII("LWJGL", true, target), 6);
+		assertEquals(memDecodeASCII(target, 5, 1), "LWJGL");
+		assertEquals(target.get(6), 0);
+
+		target.clear();
+		assertEquals(memEncodeUTF16("LWJGL", false, target), 10);
+		assertEquals(memDecodeUTF16(target, 10), "LWJGL");
+	}
+
+	public void testStrLen() {
+		ByteBuffer buffer = BufferUtils.createByteBuffer(2048);
+		long address = memAddress(buffer);
+
+		for ( int length : new int[] { 0, 1, 7, 8, 9, 255, 256, 1000 } ) {
+			for ( int offset = 0; offset < 8; offset++ ) {
+				memSet(address, 'a', buffer.capacity());
+				buffer.put(offset + length, (byte)0);
+
+				assertEquals(memStrLen1(address + offset), length);
+				assertEquals(memByteBufferNT1(address + offset).capacity(), length);
+
+				if ( (offset & 1) == 0 ) {
+					memFillShort(address, (short)'b', buffer.capacity() >> 1);
+					buffer.putShort(offset + (length << 1), (short)0);
+
+					assertEquals(memStrLen2(address + offset), length << 1);
+				}
+			}
+		}
+	}
+
+	public void testDecodeAddress() {
+		String[] strings = { "", "GL_ARB_vertex_buffer_object", "caf\u00e9", "\u20ac\ud83d\ude00\u00fc" };
+
+		for ( String s : strings ) {
+			ByteBuffer utf8 = memEncodeUTF8(s);
+			assertEquals(memDecodeUTF8(memAddress(utf8)), s);
+
+			ByteBuffer utf16 = memEncodeUTF16(s);
+			assertEquals(memDecodeUTF16(memAddress(utf16)), s);
+		}
+
+		ByteBuffer ascii = memEncodeASCII("LWJGL");
+		assertEquals(memDecodeASCII(memAddress(ascii)), "LWJGL");
+		assertNull(memDecodeASCII(NULL));
+
+		// Malformed input: truncated 2-byte sequence, lone continuation byte
+		ByteBuffer malformed = BufferUtils.createByteBuffer(4);
+		malformed.put(0, (byte)'a').put(1, (byte)0xC3).put(2, (byte)0x80).put(3, (byte)0xA9);
+		assertEquals(memDecodeUTF8(memAddress(malformed), 2), "a\uFFFD");
+		assertEquals(memDecodeUTF8(memAddress(malformed), 4), "a\u00C0\uFFFD");
+	}
+
 	public void testJNINewBuffer() {
 		ByteBuffer buffer = BufferUtils.createByteBuffer(32);
 		for ( int i = 0; i < buffer.capacity(); i++ )
@@ -141,4 +288,84 @@ public class MemoryUtilTest {
 			assertEquals(buffer.getDouble(i << 3), db.get(i));
 	}
 
-}
\ No newline at end of file
+	public void testNativeHeap() {
+		ByteBuffer buffer = memAlloc(32);
+		assertEquals(buffer.capacity(), 32);
+		for ( int i = 0; i < buffer.capacity(); i++ )
+			buffer.put(i, (byte)i);
+
+		buffer = memRealloc(buffer, 64);
+		assertEquals(buffer.capacity(), 64);
+		for ( int i = 0; i < 32; i++ )
+			assertEquals(buffer.get(i), (byte)i);
+		memFree(buffer);
+
+		buffer = memCalloc(16, 4);
+		assertEquals(buffer.capacity(), 64);
+		for ( int i = 0; i < buffer.capacity(); i++ )
+			assertEquals(buffer.get(i), 0);
+		assertNull(memRealloc(buffer, 0));
+
+		buffer = memAlignedAlloc(256, 100);
+		assertEquals(buffer.capacity(), 100);
+		assertEquals(memAddress(buffer) & 255, 0L);
+		memAlignedFree(buffer);
+	}
+
+	@Test(expectedExceptions = IllegalArgumentException.class)
+	public void testCallocOverflow() {
+		memCalloc(1 << 16, 1 << 16);
+	}
+
+	public void testSystemInfo() {
+		assertTrue(mathIsPoT(PAGE_SIZE));
+		assertTrue(mathIsPoT(CACHE_LINE_SIZE));
+	}
+
+	public void testLargeAlloc() {
+		int size = 4 * 1024 * 1024 + 1;
+
+		for ( int flags : new int[] { 0, MEM_LARGE_PAGES_TRANSPARENT, MEM_LARGE_PAGES_EXPLICIT } ) {
+			ByteBuffer buffer = memAllocLarge(size, flags, MEM_NUMA_NODE_ANY);
+			assertEquals(buffer.capacity(), size);
+			assertEquals(memAddress(buffer) & (PAGE_SIZE - 1), 0L);
+
+			buffer.put(0, (byte)1);
+			buffer.put(size - 1, (byte)2);
+			assertEquals(buffer.get(size / 2), 0);
+
+			memFreeLarge(buffer, flags);
+		}
+	}
+
+	public void testMapFile() throws IOException {
+		File file = File.createTempFile("lwjgl", ".bin");
+		file.deleteOnExit();
+
+		FileOutputStream out = new FileOutputStream(file);
+		try {
+			for ( int i = 0; i < 10000; i++ )
+				out.write(i);
+		} finally {
+			out.close();
+		}
+
+		ByteBuffer buffer = memMapFile(file.getPath(), MEM_MAP_READ_ONLY);
+		assertTrue(buffer.isReadOnly());
+		assertEquals(buffer.capacity(), 10000);
+		assertEquals(memAdvise(buffer, MEM_ADVICE_SEQUENTIAL), 0);
+		for ( int i = 0; i < buffer.capacity(); i++ )
+			assertEquals(buffer.get(i), (byte)i);
+		memUnmapFile(buffer);
+
+		buffer = memMapFile(file.getPath(), MEM_MAP_COPY_ON_WRITE);
+		buffer.put(0, (byte)42);
+		assertEquals(buffer.get(0), 42);
+		memUnmapFile(buffer);
+
+		buffer = memMapFile(file.getPath(), MEM_MAP_READ_ONLY);
+		assertEquals(buffer.get(0), 0);
+		memUnmapFile(buffer);
+	}
+
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.LWJGLUtil;
+import org.lwjgl.system.linux.LinuxLibrary;
+import org.testng.SkipException;
+import org.testng.annotations.Test;
+
+import java.io.File;
+import java.io.IOException;
+import java.util.Arrays;
+import java.util.HashSet;
+import java.util.Set;
+
+import static org.lwjgl.system.MemoryUtil.*;
+import static org.testng.Assert.*;
+
+@Test
+public class PersistentCacheTest {
+
+	public void testRoundTrip() throws IOException {
+		if ( LWJGLUtil.getPlatform() != LWJGLUtil.Platform.LINUX )
+			throw new SkipException("The persistent cache is only available on Linux.");
+
+		File dir = File.createTempFile("lwjgl", "cache");
+		assertTrue(dir.delete());
+		dir.deleteOnExit();
+
+		final LinuxLibrary libc = new LinuxLibrary("libc.so.6");
+		try {
+			final int[] lookups = new int[1];
+			FunctionProvider provider = new FunctionProvider() {
+				@Override
+				public long getFunctionAddress(String functionName) {
+					lookups[0]++;
+					return libc.getFunctionAddress(functionName);
+				}
+
+				@Override
+				public void destroy() {
+				}
+			};
+
+			String signature = "test\n" + System.nanoTime();
+			Set<String> extensions = new HashSet<String>(Arrays.asList("EXT_a", "EXT_b"));
+
+			PersistentCache cache = PersistentCache.open(dir, "test", signature);
+			assertNotNull(cache);
+			assertNull(cache.getExtensions());
+
+			cache.setExtensions(extensions);
+			FunctionProvider cached = cache.wrap(provider);
+			long malloc = cached.getFunctionAddress("malloc");
+			long missing = cached.getFunctionAddress("lwjgl_missing_function");
+			cache.store();
+
+			assertTrue(malloc != NULL);
+			assertEquals(missing, NULL);
+			assertEquals(lookups[0], 2);
+
+			// A new entry for the same signature is filled from disk
+			cache = PersistentCache.open(dir, "test", signature);
+			assertEquals(cache.getExtensions(), extensions);
+
+			cached = cache.wrap(provider);
+			assertEquals(cached.getFunctionAddress("malloc"), malloc);
+			assertEquals(cached.getFunctionAddress("lwjgl_missing_function"), NULL);
+			assertEquals(lookups[0], 2);
+
+			// A different signature misses
+			assertNull(PersistentCache.open(dir, "test", signature + "2").getExtensions());
+		} finally {
+			libc.destroy();
+
+			File[] files = dir.listFiles();
+			if ( files != null ) {
+				for ( File file : files )
+					file.delete();
+			}
+			dir.delete();
+		}
+	}
+
+	public void testRuntimeAddresses() throws IOException {
+		if ( LWJGLUtil.getPlatform() != LWJGLUtil.Platform.LINUX )
+			throw new SkipException("The persistent cache is only available on Linux.");
+
+		File dir = File.createTempFile("lwjgl", "cache");
+		assertTrue(dir.delete());
+		dir.deleteOnExit();
+
+		// A heap address does not belong to a shared object, like a dispatch stub generated at runtime
+		final long stub = nMemAlloc(16);
+		try {
+			final int[] lookups = new int[1];
+			FunctionProvider provider = new FunctionProvider() {
+				@Override
+				public long getFunctionAddress(String functionName) {
+					lookups[0]++;
+					return stub;
+				}
+
+				@Override
+				public void destroy() {
+				}
+			};
+
+			String signature = "test\n" + System.nanoTime();
+
+			PersistentCache cache = PersistentCache.open(dir, "test", signature);
+			cache.setExtensions(new HashSet<String>(Arrays.asList("EXT_a")));
+			assertEquals(cache.wrap(provider).getFunctionAddress("stub"), stub);
+			cache.store();
+
+			File[] files = dir.listFiles();
+			assertNotNull(files);
+			assertEquals(files.length, 1);
+
+			// The address is resolved again, without invalidating the entry
+			cache = PersistentCache.open(dir, "test", signature);
+			assertNotNull(cache.getExtensions());
+			assertTrue(files[0].delete());
+
+			assertEquals(cache.wrap(provider).getFunctionAddress("stub"), stub);
+			assertEquals(lookups[0], 2);
+
+			cache.store();
+			assertFalse(files[0].exists());
+		} finally {
+			nMemFree(stub);
+
+			File[] files = dir.listFiles();
+			if ( files != null ) {
+				for ( File file : files )
+					file.delete();
+			}
+			dir.delete();
+		}
+	}
+
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.BufferUtils;
+import org.testng.annotations.Test;
+
+import java.util.List;
+
+import static org.testng.Assert.*;
+
+@Test
+public class ProfilerTest {
+
+	private static Profiler.FunctionStats find(List<Profiler.FunctionStats> snapshot, String name) {
+		for ( Profiler.FunctionStats stats : snapshot ) {
+			if ( stats.name.equals(name) )
+				return stats;
+		}
+		return null;
+	}
+
+	public void testRecord() throws InterruptedException {
+		final int base = Profiler.register(ProfilerTest.class, "a", "b", "c");
+
+		Profiler.record(base, System.nanoTime(), 16L);
+		Profiler.record(base, System.nanoTime(), 16L);
+		Profiler.record(base + 2, System.nanoTime(), 0L);
+
+		// Counters of other threads are included in snapshots
+		Thread thread = new Thread() {
+			@Override
+			public void run() {
+				Profiler.record(base, System.nanoTime(), 8L);
+			}
+		};
+		thread.start();
+		thread.join();
+
+		List<Profiler.FunctionStats> snapshot = Profiler.getSnapshot();
+
+		Profiler.FunctionStats a = find(snapshot, "ProfilerTest.a");
+		assertNotNull(a);
+		assertEquals(a.calls, 3L);
+		assertEquals(a.bytes, 40L);
+		assertTrue(0L <= a.nanos);
+
+		assertNull(find(snapshot, "ProfilerTest.b"));
+		assertEquals(find(snapshot, "ProfilerTest.c").calls, 1L);
+
+		assertEquals(Profiler.getFunctionName(base + 1), "ProfilerTest.b");
+		assertEquals(Profiler.getFunctionClass(base + 1), ProfilerTest.class);
+
+		Profiler.reset();
+		assertNull(find(Profiler.getSnapshot(), "ProfilerTest.a"));
+	}
+
+	public void testBytes() {
+		assertEquals(Profiler.bytes(BufferUtils.createByteBuffer(10)), 10L);
+		assertEquals(Profiler.bytes(BufferUtils.createIntBuffer(10)), 40L);
+		assertEquals(Profiler.bytes(BufferUtils.createDoubleBuffer(10)), 80L);
+		assertEquals(Profiler.bytes(BufferUtils.createShortBuffer(10)), 20L);
+		assertEquals(Profiler.bytes((java.nio.Buffer)null), 0L);
+	}
+
+}
@@ -0,0 +1,303 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.Sys;
+import org.lwjgl.openal.ALC;
+import org.lwjgl.openal.ALCContext;
+import org.lwjgl.openal.ALContext;
+import org.lwjgl.opengl.GLContext;
+import org.lwjgl.system.glfw.ErrorCallback;
+
+import java.io.File;
+import java.io.IOException;
+import java.lang.reflect.Field;
+import java.lang.reflect.Method;
+import java.lang.reflect.Modifier;
+import java.nio.ByteBuffer;
+import java.nio.IntBuffer;
+import java.util.*;
+
+import static org.lwjgl.openal.ALC10.*;
+import static org.lwjgl.opengl.GL11.*;
+import static org.lwjgl.system.MemoryUtil.*;
+import static org.lwjgl.system.glfw.GLFW.*;
+
+/**
+ * Replays a trace captured with {@link Trace} and reports the time of each frame. Usage: {@code TraceReplay <trace file>}.
+ * <p/>
+ * An OpenGL context is created with a hidden GLFW window and an OpenAL context on the default device, if one is available. Run under Xvfb with
+ * {@code LIBGL_ALWAYS_SOFTWARE=1} and the OpenAL Soft null backend ({@code ALSOFT_DRIVERS=null}) to replay headless. Each frame ends with
+ * {@code glFinish}, so that the frame time includes the GPU work.
+ * <p/>
+ * The OpenGL and OpenAL functions are replayed through their JNI methods, with the function addresses of the replay contexts. Buffer arguments are
+ * replayed with the captured contents, pointers of unknown size with a zeroed scratch buffer. ALC, GLX, WGL, CGL and OpenCL calls are skipped, they
+ * reference objects of the captured process. Object names and handles returned by the driver are replayed as captured; this works with drivers that
+ * generate names deterministically, like Mesa.
+ * <p/>
+ * The JNI methods are called with {@link Method#invoke}, which boxes every argument and is much slower than a direct call. This overhead is included in
+ * the frame times, so they are only comparable with other replays, not with the captured frame times. Frames with many cheap calls are affected the
+ * most.
+ */
+public final class TraceReplay {
+
+	private static final int SCRATCH_SIZE = 64 * 1024;
+
+	private static final String[] SKIPPED_PREFIXES = { "ALC", "GLX", "WGL", "CGL" };
+
+	private final TraceReader reader;
+
+	private final Map<Integer, Function> functions = new HashMap<Integer, Function>();
+
+	private final ByteBuffer scratch = memAlloc(SCRATCH_SIZE);
+
+	private final List<ByteBuffer> frameData = new ArrayList<ByteBuffer>();
+
+	private long calls;
+	private long skipped;
+	private long failed;
+
+	private TraceReplay(TraceReader reader) {
+		this.reader = reader;
+	}
+
+	public static void main(String[] args) throws IOException {
+		if ( args.length != 1 ) {
+			System.err.println("Usage: TraceReplay <trace file>");
+			System.exit(1);
+		}
+
+		Sys.touch();
+
+		glfwSetErrorCallback(new ErrorCallback());
+		if ( glfwInit() != GL_TRUE )
+			throw new IllegalStateException("Unable to initialize GLFW");
+
+		glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+		long window = glfwCreateWindow(640, 480, "TraceReplay", NULL, NULL);
+		if ( window == NULL )
+			throw new IllegalStateException("Unable to create the GLFW window");
+
+		glfwMakeContextCurrent(window);
+		GLContext.createFromCurrent();
+		System.out.println("GL_RENDERER: " + glGetString(GL_RENDERER));
+
+		ALCContext deviceContext = null;
+		ALContext context = null;
+		try {
+			deviceContext = ALC.createALCContextFromDevice(null);
+			context = new ALContext(deviceContext, alcCreateContext(deviceContext.getDevice(), (IntBuffer)null));
+		} catch (Throwable t) {
+			System.out.println("OpenAL is not available, AL calls will fail: " + t);
+		}
+
+		TraceReader reader = new TraceReader(new File(args[0]));
+		TraceReplay replay = new TraceReplay(reader);
+		try {
+			replay.run();
+		} finally {
+			replay.destroy();
+			reader.close();
+
+			if ( context != null )
+				context.destroy();
+			if ( deviceContext != null )
+				deviceContext.destroy();
+
+			glfwDestroyWindow(window);
+			glfwTerminate();
+		}
+	}
+
+	private void run() {
+		List<Long> frames = new ArrayList<Long>();
+
+		long frameCalls = 0;
+		long frameStart = -1L; // the capture time of the first record of the frame
+		long t = System.nanoTime();
+		while ( reader.next() ) {
+			if ( frameStart == -1L )
+				frameStart = reader.getTime();
+
+			if ( reader.isFrame() ) {
+				glFinish();
+				long time = System.nanoTime() - t;
+
+				System.out.format(
+					"frame %6d: %9.3fms, %6d calls (captured: %9.3fms)%n",
+					frames.size(), time / 1000000.0, frameCalls, (reader.getTime() - frameStart) / 1000000.0
+				);
+				frames.add(time);
+				frameStart = reader.getTime();
+
+				freeFrameData();
+				frameCalls = 0;
+				t = System.nanoTime();
+			} else if ( replay() )
+				frameCalls++;
+		}
+		glFinish();
+		freeFrameData();
+
+		System.out.format("%d records, %d calls replayed, %d skipped, %d failed%n", reader.getRecordCount(), calls, skipped, failed);
+		System.out.println("Note: the calls are replayed with reflection, the frame times include the Method.invoke and argument boxing overhead.");
+		if ( frames.isEmpty() ) {
+			System.out.println("No frame markers in the trace, see Trace.frame().");
+			return;
+		}
+
+		Collections.sort(frames);
+		long total = 0;
+		for ( long time : frames )
+			total += time;
+
+		System.out.format(
+			"%d frames: min %.3fms, median %.3fms, avg %.3fms, 99th %.3fms, max %.3fms%n",
+			frames.size(),
+			frames.get(0) / 1000000.0,
+			frames.get(frames.size() / 2) / 1000000.0,
+			(double)total / frames.size() / 1000000.0,
+			frames.get(Math.min(frames.size() - 1, frames.size() * 99 / 100)) / 1000000.0,
+			frames.get(frames.size() - 1) / 1000000.0
+		);
+	}
+
+	private boolean replay() {
+		Function function = getFunction(reader.getFunction());
+		if ( function == null || function.method.getParameterTypes().length != reader.getArgumentCount() + 1 ) {
+			skipped++;
+			return false;
+		}
+
+		Class<?>[] types = function.method.getParameterTypes();
+		Object[] args = new Object[types.length];
+		for ( int i = 0; i < reader.getArgumentCount(); i++ )
+			args[i] = getArgument(types[i], i);
+		args[types.length - 1] = function.address;
+
+		try {
+			function.method.invoke(null, args);
+			calls++;
+			return true;
+		} catch (Exception e) {
+			if ( failed++ == 0 )
+				System.err.println("Failed to replay " + function.method.getName() + ": " + e);
+			return false;
+		}
+	}
+
+	private Object getArgument(Class<?> type, int index) {
+		long value = reader.getArgumentValue(index);
+
+		switch ( reader.getArgumentTag(index) ) {
+			case TraceWriter.ARG_DATA:
+				if ( value != NULL ) {
+					ByteBuffer data = memAlloc(Math.max(reader.getArgumentSize(index), 1));
+					memSet(memAddress(data), 0, data.capacity());
+					data.put(reader.getArgumentData(index));
+					frameData.add(data);
+					value = memAddress(data);
+				}
+				break;
+			case TraceWriter.ARG_POINTER:
+				if ( value != NULL ) {
+					memSet(memAddress(scratch), 0, SCRATCH_SIZE);
+					value = memAddress(scratch);
+				}
+				break;
+		}
+
+		if ( type == long.class )
+			return value;
+		if ( type == int.class )
+			return (int)value;
+		if ( type == float.class )
+			return Float.intBitsToFloat((int)value);
+		if ( type == double.class )
+			return Double.longBitsToDouble(value);
+		if ( type == boolean.class )
+			return value != 0L;
+		if ( type == short.class )
+			return (short)value;
+		if ( type == byte.class )
+			return (byte)value;
+		if ( type == char.class )
+			return (char)value;
+
+		throw new IllegalStateException("Unsupported argument type: " + type);
+	}
+
+	private void freeFrameData() {
+		for ( ByteBuffer data : frameData )
+			memFree(data);
+		frameData.clear();
+	}
+
+	private void destroy() {
+		freeFrameData();
+		memFree(scratch);
+	}
+
+	/** Resolves the JNI method and the function address of a function id. Returns null if the function cannot be replayed. */
+	private Function getFunction(int id) {
+		if ( functions.containsKey(id) )
+			return functions.get(id);
+
+		Function function = null;
+
+		String className = reader.getFunctionClass(id);
+		String name = reader.getFunctionName(id);
+		if ( className != null && isReplayable(className) ) {
+			try {
+				Class<?> type = Class.forName(className);
+
+				Object instance = type.getMethod("getInstance").invoke(null);
+				Field field = instance.getClass().getField(name);
+				field.setAccessible(true);
+				long address = field.getLong(instance);
+
+				for ( Method method : type.getDeclaredMethods() ) {
+					if ( method.getName().equals("n" + name) && Modifier.isNative(method.getModifiers()) ) {
+						function = new Function(method, address);
+						break;
+					}
+				}
+			} catch (Exception e) {
+				// Not a provider-based class, or the function is not available in the replay context.
+			}
+
+			if ( function == null )
+				System.err.println("Unable to replay: " + className + "." + name);
+		}
+
+		functions.put(id, function);
+		return function;
+	}
+
+	private static boolean isReplayable(String className) {
+		if ( !className.startsWith("org.lwjgl.opengl.") && !className.startsWith("org.lwjgl.openal.") )
+			return false;
+
+		String simpleName = className.substring(className.lastIndexOf('.') + 1);
+		for ( String prefix : SKIPPED_PREFIXES ) {
+			if ( simpleName.startsWith(prefix) )
+				return false;
+		}
+		return true;
+	}
+
+	private static final class Function {
+
+		final Method method;
+		final long   address;
+
+		Function(Method method, long address) {
+			this.method = method;
+			this.address = address;
+		}
+
+	}
+
+}
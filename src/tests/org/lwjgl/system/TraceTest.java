@@ -0,0 +1,116 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system;
+
+import org.lwjgl.BufferUtils;
+import org.testng.annotations.Test;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.IntBuffer;
+
+import static org.lwjgl.system.MemoryUtil.*;
+import static org.testng.Assert.*;
+
+@Test
+public class TraceTest {
+
+	private static final int BASE = Profiler.register(TraceTest.class, "a", "b");
+
+	public void testRoundTrip() throws IOException {
+		File file = File.createTempFile("lwjgl", ".trace");
+		try {
+			IntBuffer data = BufferUtils.createIntBuffer(4);
+			data.put(0, 1).put(1, 2).put(2, 3).put(3, 4);
+
+			TraceWriter writer = new TraceWriter(file, 4096, 8);
+			writer.call(BASE, new long[] { 42L, Float.floatToRawIntBits(1.5f) }, null);
+			writer.call(BASE + 1, new long[] { memAddress(data), NULL, 0x1000L }, new long[] { 16L, 16L, -2L });
+			writer.frame();
+			writer.close();
+
+			TraceReader reader = new TraceReader(file);
+			try {
+				assertEquals(reader.getRecordCount(), 3L);
+				assertEquals(reader.getFunctionClass(BASE), TraceTest.class.getName());
+				assertEquals(reader.getFunctionName(BASE + 1), "b");
+
+				assertTrue(reader.next());
+				assertEquals(reader.getFunction(), BASE);
+				assertEquals(reader.getArgumentCount(), 2);
+				assertEquals(reader.getArgumentTag(0), TraceWriter.ARG_VALUE);
+				assertEquals(reader.getArgumentValue(0), 42L);
+				assertEquals(Float.intBitsToFloat((int)reader.getArgumentValue(1)), 1.5f);
+
+				assertTrue(reader.next());
+				assertEquals(reader.getFunction(), BASE + 1);
+				assertEquals(reader.getArgumentTag(0), TraceWriter.ARG_DATA);
+				assertEquals(reader.getArgumentSize(0), 16);
+				ByteBuffer captured = reader.getArgumentData(0);
+				assertEquals(captured.remaining(), 8); // data limit
+				assertEquals(captured.getInt(0), 1);
+				assertEquals(captured.getInt(4), 2);
+
+				assertEquals(reader.getArgumentTag(1), TraceWriter.ARG_DATA);
+				assertEquals(reader.getArgumentData(1).remaining(), 0); // NULL
+
+				assertEquals(reader.getArgumentTag(2), TraceWriter.ARG_POINTER);
+				assertEquals(reader.getArgumentValue(2), 0x1000L);
+
+				assertTrue(reader.next());
+				assertTrue(reader.isFrame());
+
+				assertFalse(reader.next());
+			} finally {
+				reader.close();
+			}
+		} finally {
+			file.delete();
+			TraceWriter.getFunctionsFile(file).delete();
+		}
+	}
+
+	public void testWrap() throws IOException {
+		File file = File.createTempFile("lwjgl", ".trace");
+		try {
+			ByteBuffer data = BufferUtils.createByteBuffer(100);
+
+			// Records of varying size, so that the ring wraps at different offsets
+			TraceWriter writer = new TraceWriter(file, 4096, 1024);
+			int calls = 1000;
+			for ( int i = 0; i < calls; i++ ) {
+				data.put(0, (byte)i);
+				writer.call(BASE, new long[] { i, memAddress(data) }, new long[] { -1L, i % 100 + 1 });
+			}
+			writer.close();
+
+			TraceReader reader = new TraceReader(file);
+			try {
+				assertEquals(reader.getRecordCount(), (long)calls);
+
+				// The newest records must be read in order, up to the last call
+				long last = -1L;
+				int count = 0;
+				while ( reader.next() ) {
+					long i = reader.getArgumentValue(0);
+					if ( last != -1L )
+						assertEquals(i, last + 1);
+					assertEquals(reader.getArgumentData(1).get(0), (byte)i);
+					last = i;
+					count++;
+				}
+				assertEquals(last, calls - 1L);
+				assertTrue(10 < count && count < calls);
+			} finally {
+				reader.close();
+			}
+		} finally {
+			file.delete();
+			TraceWriter.getFunctionsFile(file).delete();
+		}
+	}
+
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright LWJGL. All rights reserved.
+ * License terms: http://lwjgl.org/license.php
+ */
+package org.lwjgl.system.glfw;
+
+import org.testng.annotations.Test;
+
+import com.lmax.disruptor.BlockingWaitStrategy;
+import com.lmax.disruptor.YieldingWaitStrategy;
+
+import static org.testng.Assert.*;
+
+@Test
+public class EventPipelineTest {
+
+	public void testOrder() throws InterruptedException {
+		final EventPipeline pipeline = new EventPipeline(16, new YieldingWaitStrategy());
+
+		final int events = 10000;
+
+		final long[] received = new long[1];
+		final WindowCallback producer = pipeline.wrap(new WindowCallbackAdapter() {
+			@Override
+			public void cursorPos(long window, double xpos, double ypos) {
+				assertEquals(window, 42L);
+				assertEquals(xpos, (double)received[0] + 0.5);
+				assertEquals(ypos, -0.25);
+				received[0]++;
+			}
+
+			@Override
+			public void key(long window, int key, int action) {
+				assertEquals(received[0], (long)events);
+				assertEquals(key, GLFW.GLFW_KEY_ESCAPE);
+				assertEquals(action, GLFW.GLFW_PRESS);
+				received[0]++;
+			}
+		});
+
+		// Become the consumer before the producer starts publishing.
+		assertEquals(pipeline.poll(), 0);
+
+		// The ring-buffer is much smaller than the event count, the producer must wait for the consumer.
+		Thread thread = new Thread() {
+			@Override
+			public void run() {
+				for ( int i = 0; i < events; i++ )
+					producer.cursorPos(42L, i + 0.5, -0.25);
+				producer.key(42L, GLFW.GLFW_KEY_ESCAPE, GLFW.GLFW_PRESS);
+			}
+		};
+		thread.start();
+
+		while ( received[0] < events + 1 )
+			pipeline.waitEvents();
+		thread.join();
+
+		assertEquals(pipeline.poll(), 0);
+		assertEquals(pipeline.getLatencyHistogram().getCount(), events + 1L);
+	}
+
+	public void testPollDoesNotBlock() {
+		EventPipeline pipeline = new EventPipeline(4, new BlockingWaitStrategy());
+		assertEquals(pipeline.poll(), 0);
+
+		WindowCallback producer = pipeline.wrap(new WindowCallbackAdapter());
+		producer.windowClose(1L);
+		producer.scroll(1L, 0.0, 1.0);
+
+		assertEquals(pipeline.poll(), 2);
+		assertEquals(pipeline.poll(), 0);
+	}
+
+	public void testSameThreadOverflow() {
+		EventPipeline pipeline = new EventPipeline(8, new BlockingWaitStrategy());
+
+		final int events = 100;
+
+		final int[] received = new int[1];
+		WindowCallback producer = pipeline.wrap(new WindowCallbackAdapter() {
+			@Override
+			public void cursorPos(long window, double xpos, double ypos) {
+				assertEquals(xpos, (double)received[0]);
+				received[0]++;
+			}
+		});
+
+		// Become the consumer, then publish more events than the ring-buffer can hold, like glfwPollEvents followed by poll in the same thread.
+		assertEquals(pipeline.poll(), 0);
+		for ( int i = 0; i < events; i++ )
+			producer.cursorPos(1L, i, 0.0);
+
+		pipeline.poll();
+		assertEquals(received[0], events);
+	}
+
+	public void testLatencyHistogram() {
+		EventPipeline.LatencyHistogram histogram = new EventPipeline.LatencyHistogram();
+		assertEquals(histogram.getPercentile(50.0), 0L);
+
+		for ( int i = 0; i < 99; i++ )
+			histogram.record(1000L);
+		histogram.record(1000000L);
+
+		assertEquals(histogram.getCount(), 100L);
+		assertEquals(histogram.getMax(), 1000000L);
+		assertEquals(histogram.getMean(), (99 * 1000.0 + 1000000.0) / 100);
+
+		// Upper bounds within a factor of two
+		assertTrue(1000L <= histogram.getPercentile(50.0) && histogram.getPercentile(50.0) < 2000L);
+		assertTrue(1000L <= histogram.getPercentile(99.0) && histogram.getPercentile(99.0) < 2000L);
+		assertEquals(histogram.getPercentile(100.0), 1000000L);
+
+		histogram.reset();
+		assertEquals(histogram.getCount(), 0L);
+		assertEquals(histogram.getMax(), 0L);
+	}
+
+}